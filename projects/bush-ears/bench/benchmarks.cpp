@@ -0,0 +1,407 @@
+/*
+ * Bush Ears - Native benchmark suite
+ * Google Benchmark cases for every hot path of the extension, built with the same
+ * flags as the wheel. Frame-based cases report per-frame time and frames/s, and
+ * every case reports heap allocations per iteration.
+ *
+ *   cmake -S . -B build/bench -DBUSH_EARS_BENCHMARKS=ON && cmake --build build/bench
+ *   build/bench/bush_ears_bench --benchmark_filter=Spectrogram
+ */
+
+#include "../src/main.cpp"
+
+#include <benchmark/benchmark.h>
+#include <pybind11/embed.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Count every heap allocation so regressions on allocation-free paths show up
+static std::atomic<size_t> allocation_count{0};
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Birdsong-like test signal: two swept tones over low-level noise, fixed seed
+template <typename Real>
+std::vector<Real> test_audio(size_t num_samples, double sample_rate = 44100.0) {
+    std::mt19937 gen(42);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    std::vector<Real> audio(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        double t = i / sample_rate;
+        audio[i] = static_cast<Real>(0.4 * std::sin(2.0 * M_PI * (1500.0 + 400.0 * std::sin(2.0 * M_PI * 3.0 * t)) * t) +
+                                     0.2 * std::sin(2.0 * M_PI * 4200.0 * t) + noise(gen));
+    }
+    return audio;
+}
+
+// Tracks allocations across the timed loop and publishes the usual counters
+class Counters {
+private:
+    benchmark::State& state_;
+    size_t allocations_at_start_;
+
+public:
+    explicit Counters(benchmark::State& state)
+        : state_(state), allocations_at_start_(allocation_count.load(std::memory_order_relaxed)) {}
+
+    ~Counters() {
+        state_.counters["allocs/iter"] = benchmark::Counter(
+            static_cast<double>(allocation_count.load(std::memory_order_relaxed) - allocations_at_start_),
+            benchmark::Counter::kAvgIterations);
+    }
+
+    void frames(size_t frames_per_iteration) {
+        auto frames = static_cast<double>(frames_per_iteration);
+        state_.counters["frames/s"] = benchmark::Counter(frames, benchmark::Counter::kIsIterationInvariantRate);
+        state_.counters["time/frame"] = benchmark::Counter(
+            frames, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+};
+
+// FFT ----------------------------------------------------------------------------
+
+template <size_t N, typename Real>
+void BM_RealFFT(benchmark::State& state) {
+    RealFFT<N, Real> fft;
+    auto input = test_audio<Real>(N);
+    std::vector<std::complex<Real>> output(RealFFT<N, Real>::BINS);
+    std::vector<std::complex<Real>> work(RealFFT<N, Real>::WORK_SIZE);
+    Counters counters(state);
+    for (auto _ : state) {
+        fft.forward(input.data(), output.data(), work.data());
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    counters.frames(1);
+}
+BENCHMARK(BM_RealFFT<256, double>);
+BENCHMARK(BM_RealFFT<512, double>);
+BENCHMARK(BM_RealFFT<1024, double>);
+BENCHMARK(BM_RealFFT<2048, double>);
+BENCHMARK(BM_RealFFT<4096, double>);
+BENCHMARK(BM_RealFFT<1024, float>);
+BENCHMARK(BM_RealFFT<4096, float>);
+
+// Feature kernels ----------------------------------------------------------------
+
+// kernel is the scalar reference or the SIMD variant selected for this CPU
+template <typename Real>
+void run_spectral_moments(benchmark::State& state,
+                          void (*kernel)(const Real*, const Real*, size_t, size_t, SpectralMoments&)) {
+    auto bins = static_cast<size_t>(state.range(0));
+    auto magnitude = test_audio<Real>(bins);
+    std::vector<Real> freq(bins);
+    for (size_t i = 0; i < bins; ++i) {
+        magnitude[i] = std::abs(magnitude[i]);
+        freq[i] = static_cast<Real>(i * 43.07);
+    }
+    Counters counters(state);
+    for (auto _ : state) {
+        SpectralMoments moments;
+        kernel(magnitude.data(), freq.data(), 0, bins, moments);
+        benchmark::DoNotOptimize(moments);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bins));
+}
+void BM_SpectralMomentsF64(benchmark::State& state, SpectralMomentsKernel kernel) {
+    run_spectral_moments<double>(state, kernel);
+}
+void BM_SpectralMomentsF32(benchmark::State& state, SpectralMomentsKernelF32 kernel) {
+    run_spectral_moments<float>(state, kernel);
+}
+BENCHMARK_CAPTURE(BM_SpectralMomentsF64, scalar, &accumulate_spectral_moments_scalar)
+    ->RangeMultiplier(4)->Range(129, 2049);
+BENCHMARK_CAPTURE(BM_SpectralMomentsF64, dispatch, accumulate_spectral_moments_f64)
+    ->RangeMultiplier(4)->Range(129, 2049);
+BENCHMARK_CAPTURE(BM_SpectralMomentsF32, scalar, &accumulate_spectral_moments_scalar_f32)
+    ->RangeMultiplier(4)->Range(129, 2049);
+BENCHMARK_CAPTURE(BM_SpectralMomentsF32, dispatch, accumulate_spectral_moments_f32)
+    ->RangeMultiplier(4)->Range(129, 2049);
+
+void BM_ZeroCrossingRate(benchmark::State& state) {
+    auto frame = test_audio<double>(static_cast<size_t>(state.range(0)));
+    Counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AudioProcessor::compute_zero_crossing_rate(std::span<const double>(frame)));
+    }
+    counters.frames(1);
+}
+BENCHMARK(BM_ZeroCrossingRate)->RangeMultiplier(4)->Range(256, 4096);
+
+void BM_MelFilterbank(benchmark::State& state) {
+    auto num_mels = static_cast<size_t>(state.range(0));
+    MelFeatureEngine engine(44100.0, 1024, MelConfig{num_mels, 13, 0.0, 0.0});
+    auto magnitude = test_audio<double>(AudioProcessor::FREQ_BINS);
+    std::vector<double> power(AudioProcessor::FREQ_BINS);
+    std::vector<double> log_mel(num_mels);
+    std::vector<float> mfcc(13);
+    Counters counters(state);
+    for (auto _ : state) {
+        engine.log_mel(magnitude.data(), magnitude.size(), power.data(), log_mel.data());
+        engine.mfcc(log_mel.data(), mfcc.data());
+        benchmark::DoNotOptimize(mfcc.data());
+        benchmark::ClobberMemory();
+    }
+    counters.frames(1);
+}
+BENCHMARK(BM_MelFilterbank)->Arg(26)->Arg(40)->Arg(80)->Arg(128);
+
+// Per-frame front end ------------------------------------------------------------
+
+template <typename Processor>
+void BM_ExtractFeatures(benchmark::State& state) {
+    using Real = typename Processor::Real;
+    Processor processor;
+    auto audio = test_audio<Real>(Processor::FFT_SIZE * 64, Processor::SAMPLE_RATE);
+    std::array<Real, Processor::NUM_FEATURES> features;
+    size_t offset = 0;
+    Counters counters(state);
+    for (auto _ : state) {
+        processor.extract_features(std::span<const Real>(audio.data() + offset, Processor::FFT_SIZE),
+                                   features.data());
+        benchmark::DoNotOptimize(features.data());
+        offset = (offset + Processor::HOP_SIZE) % (audio.size() - Processor::FFT_SIZE);
+    }
+    counters.frames(1);
+}
+BENCHMARK(BM_ExtractFeatures<AudioProcessor22k>);
+BENCHMARK(BM_ExtractFeatures<AudioProcessor>);
+BENCHMARK(BM_ExtractFeatures<AudioProcessorF32>);
+BENCHMARK(BM_ExtractFeatures<AudioProcessor96k>);
+BENCHMARK(BM_ExtractFeatures<AudioProcessorBat>);
+
+template <typename Processor>
+void BM_Spectrogram(benchmark::State& state) {
+    using Real = typename Processor::Real;
+    Processor processor;
+    auto seconds = static_cast<size_t>(state.range(0));
+    auto audio = test_audio<Real>(seconds * Processor::SAMPLE_RATE, Processor::SAMPLE_RATE);
+    std::span<const Real> view(audio);
+    Counters counters(state);
+    for (auto _ : state) {
+        auto spectrogram = processor.compute_spectrogram(view, 1);
+        benchmark::DoNotOptimize(spectrogram.data());
+    }
+    counters.frames(Processor::frame_count(audio.size()));
+}
+BENCHMARK(BM_Spectrogram<AudioProcessor>)->Arg(1)->Arg(10)->Arg(60)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Spectrogram<AudioProcessorF32>)->Arg(1)->Arg(10)->Arg(60)->Unit(benchmark::kMillisecond);
+
+// Dashboard image path: uint8 dBFS, 0-11 kHz, pooled 4 frames x 2 bins
+template <typename Processor>
+void BM_SpectrogramImage(benchmark::State& state) {
+    using Real = typename Processor::Real;
+    Processor processor;
+    auto seconds = static_cast<size_t>(state.range(0));
+    auto audio = test_audio<Real>(seconds * Processor::SAMPLE_RATE, Processor::SAMPLE_RATE);
+    std::span<const Real> view(audio);
+    SpectrogramConfig config;
+    config.scale = SpectrogramScale::Decibels;
+    config.max_hz = 11025.0;
+    config.time_decimation = 4;
+    config.freq_decimation = 2;
+    Counters counters(state);
+    for (auto _ : state) {
+        auto image = processor.template compute_spectrogram<uint8_t>(view, config, 1);
+        benchmark::DoNotOptimize(image.data());
+    }
+    counters.frames(Processor::frame_count(audio.size()));
+}
+BENCHMARK(BM_SpectrogramImage<AudioProcessor>)->Arg(10)->Arg(60)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SpectrogramImage<AudioProcessorF32>)->Arg(10)->Arg(60)->Unit(benchmark::kMillisecond);
+
+template <typename Processor>
+void BM_StreamingPush(benchmark::State& state) {
+    using Real = typename Processor::Real;
+    StreamingFeatureExtractorT<Processor> extractor;
+    auto chunk_size = static_cast<size_t>(state.range(0));
+    auto audio = test_audio<Real>(chunk_size);
+    double sink = 0.0;
+    size_t frames = 0;
+    Counters counters(state);
+    for (auto _ : state) {
+        frames += extractor.push(std::span<const Real>(audio), [&](std::span<const Real> features) {
+            sink += features[0];
+        });
+    }
+    benchmark::DoNotOptimize(sink);
+    state.counters["frames/s"] = benchmark::Counter(static_cast<double>(frames), benchmark::Counter::kIsRate);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chunk_size));
+}
+BENCHMARK(BM_StreamingPush<AudioProcessor>)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK(BM_StreamingPush<AudioProcessorF32>)->RangeMultiplier(4)->Range(256, 16384);
+
+// Inference ----------------------------------------------------------------------
+
+template <typename Real>
+std::vector<Real> feature_matrix(size_t rows) {
+    AudioProcessorT<44100, 1024, 512, Real> processor;
+    auto audio = test_audio<Real>(1024 + 512 * 63);
+    std::vector<Real> matrix(rows * WildlifeClassifierT<Real>::INPUT_DIM);
+    for (size_t r = 0; r < rows; ++r) {
+        processor.extract_features(std::span<const Real>(audio.data() + (r % 64) * 512, 1024),
+                                   matrix.data() + r * WildlifeClassifierT<Real>::INPUT_DIM);
+    }
+    return matrix;
+}
+
+template <typename Real>
+void BM_ClassifySingle(benchmark::State& state) {
+    WildlifeClassifierT<Real> classifier;
+    auto features = feature_matrix<Real>(1);
+    typename WildlifeClassifierT<Real>::FeatureVector view(features.data(), features.size());
+    Counters counters(state);
+    for (auto _ : state) {
+        double confidence = 0.0;
+        benchmark::DoNotOptimize(classifier.classify_audio_features(view, confidence));
+        benchmark::DoNotOptimize(confidence);
+    }
+    counters.frames(1);
+}
+BENCHMARK(BM_ClassifySingle<double>);
+BENCHMARK(BM_ClassifySingle<float>);
+
+template <typename Real>
+void BM_ClassifyBatch(benchmark::State& state) {
+    WildlifeClassifierT<Real> classifier;
+    auto rows = static_cast<size_t>(state.range(0));
+    auto features = feature_matrix<Real>(rows);
+    std::vector<int> species(rows);
+    Counters counters(state);
+    for (auto _ : state) {
+        classifier.classify_batch(features.data(), rows, species.data());
+        benchmark::DoNotOptimize(species.data());
+        benchmark::ClobberMemory();
+    }
+    counters.frames(rows);
+}
+BENCHMARK(BM_ClassifyBatch<double>)->RangeMultiplier(8)->Range(1, 32768);
+BENCHMARK(BM_ClassifyBatch<float>)->RangeMultiplier(8)->Range(1, 32768);
+
+// Same rows read in place from the columnar FeatureMatrix the batch paths fill
+template <typename Real>
+void BM_ClassifyColumnar(benchmark::State& state) {
+    using Classifier = WildlifeClassifierT<Real>;
+    Classifier classifier;
+    auto rows = static_cast<size_t>(state.range(0));
+    auto features = feature_matrix<Real>(rows);
+    typename Classifier::FeatureMatrix matrix(rows);
+    for (size_t r = 0; r < rows; ++r) {
+        matrix.set_row(r, features.data() + r * Classifier::INPUT_DIM);
+    }
+    std::vector<int> species(rows);
+    typename Classifier::BatchOutputs outputs;
+    outputs.species_ids = species.data();
+    Counters counters(state);
+    for (auto _ : state) {
+        classifier.classify_batch(matrix.view(), outputs);
+        benchmark::DoNotOptimize(species.data());
+        benchmark::ClobberMemory();
+    }
+    counters.frames(rows);
+}
+BENCHMARK(BM_ClassifyColumnar<double>)->Arg(512)->Arg(32768);
+BENCHMARK(BM_ClassifyColumnar<float>)->Arg(512)->Arg(32768);
+
+// Ids, confidences, the probability matrix and top-3 from the same pass
+template <typename Real>
+void BM_ClassifyScored(benchmark::State& state) {
+    using Classifier = WildlifeClassifierT<Real>;
+    Classifier classifier;
+    auto rows = static_cast<size_t>(state.range(0));
+    auto features = feature_matrix<Real>(rows);
+    std::vector<int> species(rows), top_species(rows * 3);
+    std::vector<Real> confidences(rows), probabilities(rows * Classifier::OUTPUT_DIM), top_scores(rows * 3);
+    typename Classifier::BatchOutputs outputs;
+    outputs.species_ids = species.data();
+    outputs.confidences = confidences.data();
+    outputs.probabilities = probabilities.data();
+    outputs.top_k = 3;
+    outputs.top_species = top_species.data();
+    outputs.top_scores = top_scores.data();
+    Counters counters(state);
+    for (auto _ : state) {
+        classifier.classify_batch(features.data(), rows, outputs);
+        benchmark::DoNotOptimize(top_scores.data());
+        benchmark::ClobberMemory();
+    }
+    counters.frames(rows);
+}
+BENCHMARK(BM_ClassifyScored<double>)->Arg(4096);
+BENCHMARK(BM_ClassifyScored<float>)->Arg(4096);
+
+// classify_audio_batch end to end on the shared pool: extraction into the arena
+// matrix plus batched inference. allocs/iter should stay flat as the batch grows.
+template <typename Monitor>
+void BM_ClassifyAudioBatch(benchmark::State& state) {
+    using Real = typename Monitor::Real;
+    Monitor monitor;
+    auto num_segments = static_cast<size_t>(state.range(0));
+    auto audio = test_audio<Real>(1024 + 512 * 63);
+    std::vector<std::span<const Real>> segments(num_segments);
+    for (size_t i = 0; i < num_segments; ++i) {
+        segments[i] = std::span<const Real>(audio.data() + (i % 64) * 512, 1024);
+    }
+    Counters counters(state);
+    for (auto _ : state) {
+        auto species = monitor.classify_audio_batch(std::span<const std::span<const Real>>(segments));
+        benchmark::DoNotOptimize(species.data());
+    }
+    counters.frames(num_segments);
+}
+BENCHMARK(BM_ClassifyAudioBatch<EcosystemMonitor>)->Arg(64)->Arg(10000)->UseRealTime();
+BENCHMARK(BM_ClassifyAudioBatch<EcosystemMonitorF32>)->Arg(10000)->UseRealTime();
+
+// Simulator ----------------------------------------------------------------------
+
+void BM_SimulatorBirdCall(benchmark::State& state) {
+    AudioSimulator simulator;
+    auto duration = static_cast<double>(state.range(0));
+    Counters counters(state);
+    for (auto _ : state) {
+        auto audio = simulator.generate_bird_call(AustralianSpecies::Kookaburra, duration);
+        benchmark::DoNotOptimize(audio.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(duration * AudioProcessor::SAMPLE_RATE));
+}
+BENCHMARK(BM_SimulatorBirdCall)->Arg(1)->Arg(10)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Seconds of a seven-species mix with background noise; rendered on the pool, so wall time
+void BM_SimulatorEcosystem(benchmark::State& state) {
+    AudioSimulator simulator;
+    auto duration = static_cast<double>(state.range(0));
+    Counters counters(state);
+    for (auto _ : state) {
+        auto audio = simulator.generate_ecosystem_audio({1, 2, 3, 4, 5, 6, 7}, duration, 42);
+        benchmark::DoNotOptimize(audio.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(duration * AudioProcessor::SAMPLE_RATE));
+}
+BENCHMARK(BM_SimulatorEcosystem)->Arg(10)->Arg(600)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+// py::array_t results need a live interpreter
+int main(int argc, char** argv) {
+    py::scoped_interpreter interpreter;
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
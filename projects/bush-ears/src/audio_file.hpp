@@ -0,0 +1,627 @@
+/*
+ * Bush Ears - Native audio file source
+ * WAV / RF64 recordings are memory-mapped and converted to floats one block at a
+ * time; FLAC is decoded frame by frame from the same mapping. Pages behind the read
+ * cursor are handed back, so multi-GB overnight recordings stream in constant memory
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::endian::native == std::endian::little, "WAV parsing assumes a little-endian host");
+
+template <typename T>
+T load_le(const unsigned char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+// MSB-first bit reader over a byte range, as FLAC frames are laid out
+class BitReader {
+private:
+    const unsigned char* data_;
+    size_t size_;
+    size_t pos_;         // Next byte to load into the cache
+    uint64_t cache_ = 0; // Unread bits, left-aligned; bits below bits_ are zero
+    unsigned bits_ = 0;
+
+public:
+    BitReader(const unsigned char* data, size_t size, size_t pos) : data_(data), size_(size), pos_(pos) {}
+
+    // Byte offset of the next unread bit; only meaningful when byte aligned
+    size_t byte_position() const { return pos_ - bits_ / 8; }
+
+    uint32_t read(unsigned n) {
+        if (n == 0) {
+            return 0;
+        }
+        if (bits_ < n) {
+            refill();
+            if (bits_ < n) {
+                throw std::runtime_error("FLAC stream is truncated");
+            }
+        }
+        auto value = static_cast<uint32_t>(cache_ >> (64 - n));
+        cache_ <<= n;
+        bits_ -= n;
+        return value;
+    }
+
+    int32_t read_signed(unsigned n) {
+        if (n == 0) {
+            return 0;
+        }
+        unsigned shift = 32 - n;
+        return static_cast<int32_t>(read(n) << shift) >> shift;
+    }
+
+    // Number of 0 bits before the next 1 bit, consuming both
+    uint32_t read_unary() {
+        uint32_t zeros = 0;
+        while (true) {
+            if (bits_ == 0) {
+                refill();
+                if (bits_ == 0) {
+                    throw std::runtime_error("FLAC stream is truncated");
+                }
+            }
+            if (cache_ == 0) {
+                zeros += bits_;
+                bits_ = 0;
+                continue;
+            }
+            auto leading = static_cast<unsigned>(std::countl_zero(cache_));
+            cache_ = leading + 1 < 64 ? cache_ << (leading + 1) : 0;
+            bits_ -= leading + 1;
+            return zeros + leading;
+        }
+    }
+
+    void align_to_byte() {
+        unsigned drop = bits_ % 8;
+        cache_ <<= drop;
+        bits_ -= drop;
+    }
+
+private:
+    void refill() {
+        while (bits_ <= 56 && pos_ < size_) {
+            cache_ |= static_cast<uint64_t>(data_[pos_++]) << (56 - bits_);
+            bits_ += 8;
+        }
+    }
+};
+
+// Decodes FLAC frames (CONSTANT, VERBATIM, FIXED and LPC subframes, all stereo
+// decorrelation modes) into per-channel int32 blocks. Frame CRCs are not checked.
+class FlacFrameDecoder {
+private:
+    BitReader reader_;
+    size_t size_;
+    uint32_t channels_;
+    uint32_t bits_per_sample_;
+    std::vector<std::vector<int32_t>> samples_;  // One max-block-size buffer per channel
+
+public:
+    FlacFrameDecoder(const unsigned char* data, size_t size, size_t first_frame,
+                     uint32_t channels, uint32_t bits_per_sample, uint32_t max_block_size)
+        : reader_(data, size, first_frame), size_(size), channels_(channels), bits_per_sample_(bits_per_sample),
+          samples_(channels, std::vector<int32_t>(max_block_size)) {}
+
+    size_t byte_position() const { return reader_.byte_position(); }
+
+    const int32_t* channel(size_t c) const { return samples_[c].data(); }
+
+    // Decode the next frame; returns its block size, 0 at the end of the stream
+    size_t decode_frame() {
+        if (reader_.byte_position() + 2 > size_) {
+            return 0;
+        }
+        if (reader_.read(14) != 0x3FFE) {
+            throw std::runtime_error("Corrupt FLAC frame: missing sync code");
+        }
+        reader_.read(2);  // Reserved bit, blocking strategy
+        uint32_t block_code = reader_.read(4);
+        uint32_t rate_code = reader_.read(4);
+        uint32_t channel_code = reader_.read(4);
+        uint32_t depth_code = reader_.read(3);
+        reader_.read(1);
+
+        // Frame or sample number, UTF-8 style variable length
+        auto lead = static_cast<uint8_t>(reader_.read(8));
+        for (int extra = std::countl_one(lead) - 1; extra > 0; --extra) {
+            reader_.read(8);
+        }
+
+        size_t block_size;
+        if (block_code == 1) {
+            block_size = 192;
+        } else if (block_code >= 2 && block_code <= 5) {
+            block_size = size_t{576} << (block_code - 2);
+        } else if (block_code == 6) {
+            block_size = reader_.read(8) + 1;
+        } else if (block_code == 7) {
+            block_size = reader_.read(16) + 1;
+        } else if (block_code >= 8) {
+            block_size = size_t{256} << (block_code - 8);
+        } else {
+            throw std::runtime_error("Corrupt FLAC frame: reserved block size");
+        }
+        if (rate_code == 12) {
+            reader_.read(8);
+        } else if (rate_code == 13 || rate_code == 14) {
+            reader_.read(16);
+        }
+        reader_.read(8);  // Header CRC-8
+
+        static constexpr uint32_t DEPTHS[8] = {0, 8, 12, 0, 16, 20, 24, 32};
+        uint32_t depth = depth_code == 0 ? bits_per_sample_ : DEPTHS[depth_code];
+        uint32_t frame_channels = channel_code < 8 ? channel_code + 1 : 2;
+        if (depth == 0 || depth > 24 || channel_code > 10 || frame_channels != channels_ ||
+            block_size > samples_[0].size()) {
+            throw std::runtime_error("Unsupported or corrupt FLAC frame header");
+        }
+
+        for (uint32_t c = 0; c < channels_; ++c) {
+            // The side channel of a decorrelated pair carries one extra bit
+            bool side = (channel_code == 8 && c == 1) || (channel_code == 9 && c == 0) ||
+                        (channel_code == 10 && c == 1);
+            decode_subframe(samples_[c].data(), block_size, depth + (side ? 1 : 0));
+        }
+        reader_.align_to_byte();
+        reader_.read(16);  // Frame CRC-16
+
+        decorrelate(channel_code, block_size);
+        return block_size;
+    }
+
+private:
+    void decode_subframe(int32_t* out, size_t block_size, uint32_t depth) {
+        if (reader_.read(1) != 0) {
+            throw std::runtime_error("Corrupt FLAC subframe");
+        }
+        uint32_t type = reader_.read(6);
+        uint32_t wasted = 0;
+        if (reader_.read(1)) {
+            wasted = reader_.read_unary() + 1;
+            depth -= std::min(wasted, depth);
+        }
+
+        if (type == 0) {
+            std::fill(out, out + block_size, reader_.read_signed(depth));
+        } else if (type == 1) {
+            for (size_t i = 0; i < block_size; ++i) {
+                out[i] = reader_.read_signed(depth);
+            }
+        } else if (type >= 8 && type <= 12) {
+            size_t order = type - 8;
+            read_warmup(out, order, block_size, depth);
+            read_residual(out, block_size, order);
+            restore_fixed(out, block_size, order);
+        } else if (type >= 32) {
+            size_t order = type - 31;
+            read_warmup(out, order, block_size, depth);
+            uint32_t precision = reader_.read(4) + 1;
+            int32_t shift = reader_.read_signed(5);
+            if (precision == 16 || shift < 0) {
+                throw std::runtime_error("Corrupt FLAC LPC subframe");
+            }
+            int32_t coeffs[32];
+            for (size_t j = 0; j < order; ++j) {
+                coeffs[j] = reader_.read_signed(precision);
+            }
+            read_residual(out, block_size, order);
+            for (size_t i = order; i < block_size; ++i) {
+                int64_t prediction = 0;
+                for (size_t j = 0; j < order; ++j) {
+                    prediction += int64_t{coeffs[j]} * out[i - 1 - j];
+                }
+                out[i] += static_cast<int32_t>(prediction >> shift);
+            }
+        } else {
+            throw std::runtime_error("Corrupt FLAC subframe: reserved type");
+        }
+
+        if (wasted != 0) {
+            for (size_t i = 0; i < block_size; ++i) {
+                out[i] = static_cast<int32_t>(static_cast<uint32_t>(out[i]) << wasted);
+            }
+        }
+    }
+
+    void read_warmup(int32_t* out, size_t order, size_t block_size, uint32_t depth) {
+        if (order > block_size) {
+            throw std::runtime_error("Corrupt FLAC subframe: predictor order exceeds block size");
+        }
+        for (size_t i = 0; i < order; ++i) {
+            out[i] = reader_.read_signed(depth);
+        }
+    }
+
+    // Rice-coded residual, written into out[order, block_size)
+    void read_residual(int32_t* out, size_t block_size, size_t order) {
+        uint32_t method = reader_.read(2);
+        if (method > 1) {
+            throw std::runtime_error("Corrupt FLAC residual: reserved coding method");
+        }
+        unsigned param_bits = method == 0 ? 4 : 5;
+        uint32_t escape = method == 0 ? 15 : 31;
+        uint32_t partition_order = reader_.read(4);
+        size_t partition_size = block_size >> partition_order;
+        if ((partition_size << partition_order) != block_size || partition_size < order) {
+            throw std::runtime_error("Corrupt FLAC residual: bad partition order");
+        }
+
+        size_t i = order;
+        for (size_t p = 0; p < (size_t{1} << partition_order); ++p) {
+            size_t end = (p + 1) * partition_size;
+            uint32_t param = reader_.read(param_bits);
+            if (param == escape) {
+                uint32_t raw_bits = reader_.read(5);
+                for (; i < end; ++i) {
+                    out[i] = reader_.read_signed(raw_bits);
+                }
+                continue;
+            }
+            for (; i < end; ++i) {
+                uint32_t folded = (reader_.read_unary() << param) | reader_.read(param);
+                out[i] = static_cast<int32_t>(folded >> 1) ^ -static_cast<int32_t>(folded & 1);
+            }
+        }
+    }
+
+    static void restore_fixed(int32_t* s, size_t block_size, size_t order) {
+        for (size_t i = order; i < block_size; ++i) {
+            switch (order) {
+                case 1: s[i] += s[i - 1]; break;
+                case 2: s[i] += 2 * s[i - 1] - s[i - 2]; break;
+                case 3: s[i] += 3 * s[i - 1] - 3 * s[i - 2] + s[i - 3]; break;
+                case 4: s[i] += 4 * s[i - 1] - 6 * s[i - 2] + 4 * s[i - 3] - s[i - 4]; break;
+                default: break;
+            }
+        }
+    }
+
+    void decorrelate(uint32_t channel_code, size_t block_size) {
+        int32_t* a = samples_[0].data();
+        int32_t* b = channels_ > 1 ? samples_[1].data() : nullptr;
+        for (size_t i = 0; channel_code >= 8 && i < block_size; ++i) {
+            if (channel_code == 8) {         // left / side
+                b[i] = a[i] - b[i];
+            } else if (channel_code == 9) {  // side / right
+                a[i] += b[i];
+            } else {                         // mid / side
+                int32_t side = b[i];
+                int32_t mid = static_cast<int32_t>(static_cast<uint32_t>(a[i]) << 1) | (side & 1);
+                a[i] = (mid + side) >> 1;
+                b[i] = (mid - side) >> 1;
+            }
+        }
+    }
+};
+
+// Read-only, sequential source of audio frames from a WAV (PCM 8/16/24/32-bit or
+// IEEE float, RIFF or RF64) or FLAC (up to 24-bit) recording
+class AudioFile {
+public:
+    enum class Format { Wav, Flac };
+
+private:
+    enum class Encoding { UInt8, Int16, Int24, Int32, Float32, Float64 };
+
+    // Consumed bytes are released in steps of this size
+    static constexpr size_t RELEASE_STEP = size_t{8} << 20;
+
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t released_ = 0;  // Bytes before this offset were dropped with MADV_DONTNEED
+
+    Format format_ = Format::Wav;
+    uint32_t sample_rate_ = 0;
+    uint32_t channels_ = 0;
+    uint32_t bits_per_sample_ = 0;
+    uint64_t num_frames_ = 0;  // 0 when a FLAC stream does not record its length
+    uint64_t frames_read_ = 0;
+
+    // WAV sample data
+    Encoding encoding_ = Encoding::Int16;
+    size_t data_offset_ = 0;
+    size_t block_align_ = 0;
+
+    // FLAC frames decoded but not yet returned by read()
+    std::unique_ptr<FlacFrameDecoder> flac_;
+    size_t flac_block_size_ = 0;
+    size_t flac_block_pos_ = 0;
+
+public:
+    explicit AudioFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open audio file " + path + ": " + std::strerror(errno));
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size < 12) {
+            ::close(fd);
+            throw std::runtime_error("Audio file " + path + " is truncated");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // The mapping keeps the file referenced
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Cannot map audio file " + path + ": " + std::strerror(errno));
+        }
+        data_ = static_cast<const unsigned char*>(mapping);
+        ::madvise(mapping, size_, MADV_SEQUENTIAL);
+
+        try {
+            if (std::memcmp(data_, "fLaC", 4) == 0) {
+                parse_flac(path);
+            } else {
+                parse_wav(path);
+            }
+        } catch (...) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+            throw;
+        }
+    }
+
+    AudioFile(const AudioFile&) = delete;
+    AudioFile& operator=(const AudioFile&) = delete;
+
+    ~AudioFile() {
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+    }
+
+    Format format() const { return format_; }
+    uint32_t sample_rate() const { return sample_rate_; }
+    uint32_t num_channels() const { return channels_; }
+    uint32_t bits_per_sample() const { return bits_per_sample_; }
+    uint64_t num_frames() const { return num_frames_; }
+    uint64_t frames_read() const { return frames_read_; }
+
+    // Read up to max_frames frames as planar rows scaled to [-1, 1): channel c
+    // occupies out[c * n, (c + 1) * n) where n is the returned frame count.
+    // out must hold num_channels() * max_frames values; returns 0 at end of file.
+    template <typename Real>
+    size_t read(Real* out, size_t max_frames) {
+        size_t frames = format_ == Format::Wav ? read_wav(out, max_frames) : read_flac(out, max_frames);
+        frames_read_ += frames;
+        release_consumed(format_ == Format::Wav ? data_offset_ + frames_read_ * block_align_
+                                                : flac_->byte_position());
+        return frames;
+    }
+
+private:
+    template <typename Real>
+    size_t read_wav(Real* out, size_t max_frames) {
+        auto frames = static_cast<size_t>(std::min<uint64_t>(max_frames, num_frames_ - frames_read_));
+        const unsigned char* src = data_ + data_offset_ + frames_read_ * block_align_;
+        switch (encoding_) {
+            case Encoding::UInt8:
+                convert_wav(out, src, frames, [](const unsigned char* p) {
+                    return (Real(p[0]) - Real(128)) * Real(1.0 / 128.0);
+                });
+                break;
+            case Encoding::Int16:
+                convert_wav(out, src, frames, [](const unsigned char* p) {
+                    return Real(load_le<int16_t>(p)) * Real(1.0 / 32768.0);
+                });
+                break;
+            case Encoding::Int24:
+                convert_wav(out, src, frames, [](const unsigned char* p) {
+                    auto v = static_cast<int32_t>((uint32_t{p[0]} << 8) | (uint32_t{p[1]} << 16) | (uint32_t{p[2]} << 24)) >> 8;
+                    return Real(v) * Real(1.0 / 8388608.0);
+                });
+                break;
+            case Encoding::Int32:
+                convert_wav(out, src, frames, [](const unsigned char* p) {
+                    return Real(load_le<int32_t>(p)) * Real(1.0 / 2147483648.0);
+                });
+                break;
+            case Encoding::Float32:
+                convert_wav(out, src, frames, [](const unsigned char* p) { return Real(load_le<float>(p)); });
+                break;
+            case Encoding::Float64:
+                convert_wav(out, src, frames, [](const unsigned char* p) { return Real(load_le<double>(p)); });
+                break;
+        }
+        return frames;
+    }
+
+    // Deinterleave frames x channels samples into planar rows of length frames
+    template <typename Real, typename Convert>
+    void convert_wav(Real* out, const unsigned char* src, size_t frames, Convert convert) const {
+        size_t sample_bytes = bits_per_sample_ / 8;
+        for (size_t i = 0; i < frames; ++i) {
+            const unsigned char* frame = src + i * block_align_;
+            for (size_t c = 0; c < channels_; ++c) {
+                out[c * frames + i] = convert(frame + c * sample_bytes);
+            }
+        }
+    }
+
+    template <typename Real>
+    size_t read_flac(Real* out, size_t max_frames) {
+        const Real scale = Real(1) / Real(uint32_t{1} << (bits_per_sample_ - 1));
+        // Trailing tags after the last frame are not frames; stop at the recorded length
+        if (num_frames_ != 0) {
+            max_frames = static_cast<size_t>(std::min<uint64_t>(max_frames, num_frames_ - frames_read_));
+        }
+        size_t stride = max_frames;
+        size_t frames = 0;
+        while (frames < max_frames) {
+            if (flac_block_pos_ == flac_block_size_) {
+                flac_block_size_ = flac_->decode_frame();
+                flac_block_pos_ = 0;
+                if (flac_block_size_ == 0) {
+                    break;
+                }
+            }
+            size_t n = std::min(max_frames - frames, flac_block_size_ - flac_block_pos_);
+            for (size_t c = 0; c < channels_; ++c) {
+                const int32_t* src = flac_->channel(c) + flac_block_pos_;
+                Real* dst = out + c * stride + frames;
+                for (size_t i = 0; i < n; ++i) {
+                    dst[i] = Real(src[i]) * scale;
+                }
+            }
+            frames += n;
+            flac_block_pos_ += n;
+        }
+
+        // Pack the rows if the stream ended short of max_frames
+        if (frames < stride) {
+            for (size_t c = 1; c < channels_; ++c) {
+                std::copy(out + c * stride, out + c * stride + frames, out + c * frames);
+            }
+        }
+        return frames;
+    }
+
+    // Hand pages behind the read cursor back to the kernel so resident memory stays flat
+    void release_consumed(size_t offset) {
+        static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t end = offset / page * page;
+        if (end >= released_ + RELEASE_STEP) {
+            ::madvise(const_cast<unsigned char*>(data_) + released_, end - released_, MADV_DONTNEED);
+            released_ = end;
+        }
+    }
+
+    void parse_wav(const std::string& path) {
+        bool rf64 = std::memcmp(data_, "RF64", 4) == 0;
+        if ((!rf64 && std::memcmp(data_, "RIFF", 4) != 0) || std::memcmp(data_ + 8, "WAVE", 4) != 0) {
+            throw std::runtime_error(path + " is not a WAV or FLAC file");
+        }
+
+        uint64_t rf64_data_size = 0;
+        uint32_t format_tag = 0;
+        uint64_t data_bytes = 0;
+        bool have_format = false;
+        bool have_data = false;
+        size_t offset = 12;
+        while (offset + 8 <= size_ && !have_data) {
+            const unsigned char* id = data_ + offset;
+            uint64_t chunk_size = load_le<uint32_t>(data_ + offset + 4);
+            size_t body = offset + 8;
+            auto require = [&](size_t bytes) {
+                if (chunk_size < bytes || body + bytes > size_) {
+                    throw std::runtime_error("WAV file " + path + " has a corrupt header");
+                }
+            };
+
+            if (std::memcmp(id, "ds64", 4) == 0) {
+                require(16);
+                rf64_data_size = load_le<uint64_t>(data_ + body + 8);
+            } else if (std::memcmp(id, "fmt ", 4) == 0) {
+                require(16);
+                format_tag = load_le<uint16_t>(data_ + body);
+                channels_ = load_le<uint16_t>(data_ + body + 2);
+                sample_rate_ = load_le<uint32_t>(data_ + body + 4);
+                block_align_ = load_le<uint16_t>(data_ + body + 12);
+                bits_per_sample_ = load_le<uint16_t>(data_ + body + 14);
+                if (format_tag == 0xFFFE) {  // WAVE_FORMAT_EXTENSIBLE: tag leads the sub-format GUID
+                    require(40);
+                    format_tag = load_le<uint16_t>(data_ + body + 24);
+                }
+                have_format = true;
+            } else if (std::memcmp(id, "data", 4) == 0) {
+                if (rf64 && chunk_size == 0xFFFFFFFF) {
+                    chunk_size = rf64_data_size;
+                }
+                data_offset_ = body;
+                // Recorders that lose power leave a data size past the end of the file
+                data_bytes = std::min<uint64_t>(chunk_size, size_ - std::min(body, size_));
+                have_data = true;
+            }
+            offset = body + chunk_size + (chunk_size & 1);
+        }
+        if (!have_format || !have_data) {
+            throw std::runtime_error("WAV file " + path + " has no " + (have_format ? "data" : "fmt") + " chunk");
+        }
+
+        if (format_tag == 1 && bits_per_sample_ == 8) {
+            encoding_ = Encoding::UInt8;
+        } else if (format_tag == 1 && bits_per_sample_ == 16) {
+            encoding_ = Encoding::Int16;
+        } else if (format_tag == 1 && bits_per_sample_ == 24) {
+            encoding_ = Encoding::Int24;
+        } else if (format_tag == 1 && bits_per_sample_ == 32) {
+            encoding_ = Encoding::Int32;
+        } else if (format_tag == 3 && bits_per_sample_ == 32) {
+            encoding_ = Encoding::Float32;
+        } else if (format_tag == 3 && bits_per_sample_ == 64) {
+            encoding_ = Encoding::Float64;
+        } else {
+            throw std::runtime_error("Unsupported WAV encoding (format tag " + std::to_string(format_tag) +
+                                     ", " + std::to_string(bits_per_sample_) + " bits)");
+        }
+        if (channels_ == 0 || sample_rate_ == 0 || block_align_ < channels_ * (bits_per_sample_ / 8)) {
+            throw std::runtime_error("WAV file " + path + " has a corrupt fmt chunk");
+        }
+        format_ = Format::Wav;
+        num_frames_ = data_bytes / block_align_;
+    }
+
+    void parse_flac(const std::string& path) {
+        size_t offset = 4;
+        bool have_stream_info = false;
+        uint32_t max_block_size = 0;
+        bool last = false;
+        while (!last) {
+            if (offset + 4 > size_) {
+                throw std::runtime_error("FLAC file " + path + " has truncated metadata");
+            }
+            last = (data_[offset] & 0x80) != 0;
+            uint32_t type = data_[offset] & 0x7F;
+            size_t length = (size_t{data_[offset + 1]} << 16) | (size_t{data_[offset + 2]} << 8) | data_[offset + 3];
+            size_t body = offset + 4;
+            if (body + length > size_) {
+                throw std::runtime_error("FLAC file " + path + " has truncated metadata");
+            }
+
+            if (type == 0 && length >= 34) {  // STREAMINFO
+                BitReader info(data_, body + 34, body);
+                info.read(16);  // Minimum block size
+                max_block_size = info.read(16);
+                info.read(24);  // Minimum / maximum frame size
+                info.read(24);
+                sample_rate_ = info.read(20);
+                channels_ = info.read(3) + 1;
+                bits_per_sample_ = info.read(5) + 1;
+                num_frames_ = (uint64_t{info.read(4)} << 32) | info.read(32);
+                have_stream_info = true;
+            }
+            offset = body + length;
+        }
+        if (!have_stream_info || sample_rate_ == 0) {
+            throw std::runtime_error("FLAC file " + path + " has no STREAMINFO block");
+        }
+        if (bits_per_sample_ > 24) {
+            throw std::runtime_error("FLAC streams deeper than 24 bits are not supported");
+        }
+
+        format_ = Format::Flac;
+        flac_ = std::make_unique<FlacFrameDecoder>(data_, size_, offset, channels_, bits_per_sample_,
+                                                   max_block_size == 0 ? 65535 : max_block_size);
+    }
+};
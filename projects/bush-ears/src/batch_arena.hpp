@@ -0,0 +1,95 @@
+/*
+ * Bush Ears - Batch scratch arena
+ * Monotonic, cache-line aligned storage for the buffers of one batch, reset between
+ * batches, so a steady stream of batches stops touching the heap after the first
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// allocate() bumps through the current block and chains a bigger one when it runs
+// out; nothing is freed until reset(). If a batch needed more than one block, reset()
+// swaps them for a single block holding all of them, so the next batch of that size
+// is served from one block with no allocation at all. Not synchronised: whoever
+// assembles batches owns the arena, or holds one lock from reset() until the batch's
+// spans are dead, and workers only write into the spans.
+class BatchArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;  // Rows handed to different workers never share a line
+
+    explicit BatchArena(size_t initial_bytes = 0) {
+        if (initial_bytes != 0) {
+            add_block(initial_bytes);
+        }
+    }
+
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    // count value-initialised Ts, valid until the next reset()
+    template <typename T>
+    std::span<T> allocate(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena memory is released without destructors");
+        static_assert(alignof(T) <= ALIGNMENT);
+        size_t bytes = round_up(count * sizeof(T));
+        if (blocks_.empty() || blocks_.back().size - offset_ < bytes) {
+            add_block(std::max(bytes, 2 * capacity()));
+        }
+        T* data = reinterpret_cast<T*>(blocks_.back().data.get() + offset_);
+        offset_ += bytes;
+        used_ += bytes;
+        std::uninitialized_value_construct_n(data, count);
+        return {data, count};
+    }
+
+    // Make all storage reusable; every span handed out since the last reset dies
+    void reset() {
+        if (blocks_.size() > 1) {
+            size_t total = capacity();
+            blocks_.clear();
+            add_block(total);
+        }
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (const Block& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    // Bytes handed out since the last reset, including alignment padding
+    size_t used() const { return used_; }
+
+private:
+    struct Deleter {
+        void operator()(std::byte* data) const { ::operator delete[](data, std::align_val_t{ALIGNMENT}); }
+    };
+    struct Block {
+        std::unique_ptr<std::byte[], Deleter> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t offset_ = 0;  // Into blocks_.back(); earlier blocks are full
+    size_t used_ = 0;
+
+    static size_t round_up(size_t bytes) { return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+    void add_block(size_t bytes) {
+        bytes = round_up(std::max<size_t>(bytes, ALIGNMENT));
+        auto* data = static_cast<std::byte*>(::operator new[](bytes, std::align_val_t{ALIGNMENT}));
+        blocks_.push_back(Block{std::unique_ptr<std::byte[], Deleter>(data), bytes});
+        offset_ = 0;
+    }
+};
@@ -3,11 +3,27 @@
 from ._core import (
     AustralianSpecies, 
     AudioProcessor, 
+    AudioProcessor22k,
+    AudioProcessor48k,
+    AudioProcessor96k,
+    AudioProcessorBat,
+    AudioProcessorF32,
+    create_audio_processor,
+    StreamingFeatureExtractor,
+    StreamingFeatureExtractorF32,
     WildlifeClassifier, 
+    WildlifeClassifierF32,
     EcosystemMonitor, 
+    EcosystemMonitorF32,
     AudioSimulator,
-    benchmark_performance
+    LoadGenerator,
+    AudioFile,
+    benchmark_performance,
+    write_model_file,
+    set_num_threads,
+    get_num_threads
 )
+import asyncio
 import numpy as np
 import matplotlib.pyplot as plt
 from typing import Dict, List, Tuple, Optional
@@ -15,6 +31,18 @@ import time
 from dataclasses import dataclass
 from datetime import datetime, timedelta
 
+# Columns of native feature vectors and matrices, in order
+FEATURE_NAMES = (
+    'spectral_centroid',
+    'spectral_bandwidth',
+    'spectral_rolloff',
+    'zero_crossing_rate',
+    'energy_low',
+    'energy_mid',
+    'energy_high',
+    'energy_very_high',
+)
+
 @dataclass
 class EcosystemHealth:
     """Ecosystem health assessment based on audio monitoring."""
@@ -66,14 +94,29 @@ class BushEarsAnalyzer:
         self.monitor = EcosystemMonitor()
         self.simulator = AudioSimulator()
         self.session_start = datetime.now()
-        self.detection_history = []
         
     def analyze_audio_stream(self, audio_data: np.ndarray) -> Dict:
         """Analyze a chunk of audio for wildlife identification."""
         
         # Process with C++ engine
         result = self.monitor.process_audio_stream(audio_data)
+        return self._add_species_context(result)
+    
+    async def analyze_audio_stream_async(self, audio_data: np.ndarray, channel: int = 0) -> Dict:
+        """Non-blocking analyze_audio_stream for asyncio code.
         
+        The chunk is queued natively and batched with whatever else is pending (e.g. from
+        other connections), so the event loop never waits on analysis. Give every
+        concurrent stream its own channel.
+        """
+        result = await asyncio.wrap_future(self.monitor.submit(audio_data, channel))
+        return self._add_species_context(result)
+    
+    def close_stream(self, channel: int) -> None:
+        """End a channel once its stream is done: flush its open event and free its state."""
+        self.monitor.close_stream(channel)
+    
+    def _add_species_context(self, result: Dict) -> Dict:
         # Add Python-level analysis
         if result.get('species_detected', False):
             species_id = AustralianSpecies(result['species_id'])
@@ -87,16 +130,14 @@ class BushEarsAnalyzer:
                     'ecosystem_role': species_info['ecosystem_role'],
                     'detection_time': datetime.now().isoformat()
                 })
-                
-                # Track detection
-                self.detection_history.append({
-                    'species': species_info['name'],
-                    'timestamp': datetime.now(),
-                    'conservation_weight': result['conservation_weight']
-                })
         
         return result
     
+    def species_name(self, species_id: int) -> str:
+        """Common name for a species id, or 'Unknown'."""
+        info = self.SPECIES_INFO.get(AustralianSpecies(species_id))
+        return info['name'] if info else 'Unknown'
+    
     def get_ecosystem_health(self) -> EcosystemHealth:
         """Get comprehensive ecosystem health assessment."""
         report = self.monitor.get_ecosystem_report()
@@ -110,8 +151,8 @@ class BushEarsAnalyzer:
             timestamp=datetime.now()
         )
     
-    def generate_test_audio(self, scenario: str = 'dawn_chorus') -> np.ndarray:
-        """Generate realistic test audio for different scenarios."""
+    def generate_test_audio(self, scenario: str = 'dawn_chorus', seed: Optional[int] = None) -> np.ndarray:
+        """Generate realistic test audio for different scenarios (reproducible with a seed)."""
         
         scenarios = {
             'dawn_chorus': [
@@ -140,14 +181,18 @@ class BushEarsAnalyzer:
             scenario = 'dawn_chorus'
         
         species_list = [int(species) for species in scenarios[scenario]]
-        return self.simulator.generate_ecosystem_audio(species_list, 10.0)
+        return self.simulator.generate_ecosystem_audio(species_list, 10.0, seed=seed)
     
-    def create_spectrogram_visualization(self, audio_data: np.ndarray) -> plt.Figure:
+    def create_spectrogram_visualization(self, audio_data: np.ndarray, max_columns: int = 2000) -> plt.Figure:
         """Create publication-ready spectrogram visualization."""
         
-        # Generate spectrogram using C++ processor
+        # Generate a dBFS spectrogram using C++ processor, pooled natively so long
+        # recordings come back at roughly display resolution
         processor = AudioProcessor()
-        spectrogram = processor.compute_spectrogram(audio_data)
+        frames = max(1, (len(audio_data) - processor.fft_size) // processor.hop_size + 1)
+        spectrogram = processor.compute_spectrogram(
+            audio_data, scale='db', dtype='float32',
+            time_decimation=max(1, -(-frames // max_columns)))
         
         # Create figure
         fig, (ax1, ax2) = plt.subplots(2, 1, figsize=(12, 8), 
@@ -164,14 +209,14 @@ class BushEarsAnalyzer:
         # Spectrogram
         extent = [0, len(audio_data) / 44100, 0, 22050]
         im = ax2.imshow(spectrogram.T, aspect='auto', origin='lower', 
-                       extent=extent, cmap='inferno')
+                       extent=extent, cmap='inferno', vmin=-80.0, vmax=0.0)
         ax2.set_xlabel('Time (s)')
         ax2.set_ylabel('Frequency (Hz)')
         ax2.set_title('Spectrogram - Wildlife Audio Analysis')
         
         # Add colorbar
         cbar = plt.colorbar(im, ax=ax2)
-        cbar.set_label('Magnitude')
+        cbar.set_label('Level (dBFS)')
         
         plt.tight_layout()
         return fig
@@ -215,44 +260,61 @@ class BushEarsAnalyzer:
         }
     
     def get_detection_timeline(self, hours_back: int = 24) -> List[Dict]:
-        """Get timeline of species detections for analysis."""
-        cutoff_time = datetime.now() - timedelta(hours=hours_back)
-        
-        recent_detections = [
-            detection for detection in self.detection_history
-            if detection['timestamp'] >= cutoff_time
-        ]
+        """Get timeline of species detections for analysis, from the monitor's sliding window."""
+        window = self.monitor.export_metrics_window()
+        counts = window['species_counts']
+        bucket_starts = window['start_time'] + window['bucket_seconds'] * np.arange(len(counts))
+        recent = bucket_starts >= time.time() - hours_back * 3600
         
-        # Group by hour for trend analysis
-        hourly_data = {}
-        for detection in recent_detections:
-            hour_key = detection['timestamp'].strftime('%H:00')
-            if hour_key not in hourly_data:
-                hourly_data[hour_key] = {'species': set(), 'count': 0, 'conservation_value': 0.0}
-            
-            hourly_data[hour_key]['species'].add(detection['species'])
-            hourly_data[hour_key]['count'] += 1
-            hourly_data[hour_key]['conservation_value'] += detection['conservation_weight']
+        # Group buckets by hour for trend analysis
+        hours = (bucket_starts[recent] // 3600).astype(np.int64)
+        counts = counts[recent]
+        weights = window['conservation_weights']
         
-        # Convert to timeline format
         timeline = []
-        for hour, data in sorted(hourly_data.items()):
+        for hour in np.unique(hours):
+            hour_counts = counts[hours == hour].sum(axis=0)
+            total = int(hour_counts.sum())
+            if total == 0:
+                continue
+            species_list = [self.SPECIES_INFO[AustralianSpecies(int(i))]['name']
+                            for i in np.flatnonzero(hour_counts) if AustralianSpecies(int(i)) in self.SPECIES_INFO]
             timeline.append({
-                'hour': hour,
-                'species_count': len(data['species']),
-                'detection_count': data['count'],
-                'species_list': list(data['species']),
-                'conservation_value': data['conservation_value'] / data['count']
+                'hour': datetime.fromtimestamp(int(hour) * 3600).strftime('%H:00'),
+                'species_count': len(species_list),
+                'detection_count': total,
+                'species_list': species_list,
+                'conservation_value': float(hour_counts @ weights) / total
             })
         
         return timeline
     
+    def get_perf_stats(self) -> Dict:
+        """Native per-stage latency percentiles (microseconds) and real-time factor."""
+        return self.monitor.get_perf_stats()
+    
     def reset_session(self):
         """Reset monitoring session."""
         self.monitor.reset_metrics()
-        self.detection_history.clear()
+        self.monitor.reset_perf_stats()
         self.session_start = datetime.now()
 
+def features_to_arrow(features: np.ndarray, species_ids: Optional[np.ndarray] = None):
+    """Arrow table with one column per feature (and species_id when given).
+    
+    The features of classify_audio_batch(..., return_features=True) are stored
+    column by column, so each column is wrapped without a copy. Requires pyarrow.
+    """
+    try:
+        import pyarrow as pa
+    except ImportError as error:
+        raise ImportError("features_to_arrow requires pyarrow (pip install pyarrow)") from error
+    
+    columns = {name: pa.array(features[:, i]) for i, name in enumerate(FEATURE_NAMES)}
+    if species_ids is not None:
+        columns['species_id'] = pa.array(species_ids)
+    return pa.table(columns)
+
 def create_ecosystem_health_report(health_data: EcosystemHealth) -> str:
     """Create a formatted ecosystem health report."""
     
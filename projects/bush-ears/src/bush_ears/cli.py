@@ -7,7 +7,8 @@ import time
 import webbrowser
 import threading
 from pathlib import Path
-from . import BushEarsAnalyzer, AustralianSpecies, create_ecosystem_health_report
+from . import (BushEarsAnalyzer, AustralianSpecies, create_ecosystem_health_report,
+               EcosystemMonitor, EcosystemMonitorF32, LoadGenerator, set_num_threads)
 from .server import run_server
 
 @click.group()
@@ -51,11 +52,13 @@ def simulate(scenario, duration, analyze, visualize):
             chunk = audio[i:i + chunk_size]
             result = analyzer.analyze_audio_stream(chunk)
             
-            if result.get('species_detected', False):
+            # One line per call once it ends, not per chunk it spans
+            event = result.get('event')
+            if event:
                 detections.append({
-                    'time': i / 44100,
-                    'species': result['common_name'],
-                    'confidence': result.get('conservation_weight', 0.5)
+                    'time': event['start'],
+                    'species': analyzer.species_name(event['species_id']),
+                    'confidence': event['peak_confidence']
                 })
         
         if detections:
@@ -230,11 +233,13 @@ def live_demo(scenario, duration):
         chunk = audio[i:i + chunk_size]
         result = analyzer.analyze_audio_stream(chunk)
         
-        if result.get('species_detected', False):
-            species_name = result['common_name']
-            habitat = result.get('habitat', 'Unknown')
+        event = result.get('event')
+        if event:
+            species_name = analyzer.species_name(event['species_id'])
+            call_seconds = event['end'] - event['start']
             
-            click.echo(f"{current_time:5.1f}s - 🦜 {species_name} detected ({habitat})")
+            click.echo(f"{current_time:5.1f}s - 🦜 {species_name} call ({call_seconds:.1f}s, "
+                       f"peak confidence {event['peak_confidence']:.2f})")
             detections.append((current_time, species_name, result))
         
         # Show progress occasionally
@@ -264,5 +269,90 @@ def live_demo(scenario, duration):
         for species, count in species_summary.items():
             click.echo(f"   • {species}: {count} detections")
 
+@main.command()
+@click.argument('paths', nargs=-1, required=True, type=click.Path(exists=True, path_type=Path))
+@click.option('--output', '-o', default='scan_summary.csv', help='CSV file for per-file summaries')
+@click.option('--model', type=click.Path(exists=True), default=None, help='Trained model file')
+@click.option('--readers', default=2, help='Threads reading and decoding recordings')
+@click.option('--threads', default=0, help='Compute threads (0 = one per core)')
+@click.option('--float32', 'use_float32', is_flag=True, help='Run the float32 pipeline')
+def scan(paths, output, model, readers, threads, use_float32):
+    """Re-score WAV/FLAC recordings (files or directories) and write per-file summaries."""
+    
+    click.echo("🗂️ BUSH EARS ARCHIVE SCAN")
+    click.echo("━━━━━━━━━━━━━━━━━━━━━━━━")
+    
+    recordings = []
+    for path in paths:
+        if path.is_dir():
+            recordings.extend(sorted(p for p in path.rglob('*') if p.suffix.lower() in ('.wav', '.flac')))
+        else:
+            recordings.append(path)
+    
+    set_num_threads(threads)
+    monitor_class = EcosystemMonitorF32 if use_float32 else EcosystemMonitor
+    monitor = monitor_class(model) if model else monitor_class()
+    
+    click.echo(f"\n🔍 Scanning {len(recordings):,} recordings...")
+    start_time = time.time()
+    summaries = monitor.scan_archive([str(p) for p in recordings], num_readers=readers,
+                                     summary_path=output)
+    elapsed = time.time() - start_time
+    
+    audio_hours = sum(s['duration_seconds'] for s in summaries) / 3600
+    failed = [s for s in summaries if 'error' in s]
+    click.echo(f"   Scanned {audio_hours:.1f} hours of audio in {elapsed:.1f}s "
+               f"({audio_hours * 3600 / max(elapsed, 1e-9):.0f}x real-time)")
+    click.echo(f"   Detections: {sum(s['detections'] for s in summaries):,}")
+    click.echo(f"   Summary written to: {output}")
+    for summary in failed:
+        click.echo(f"   ⚠️ {summary['path']}: {summary['error']}")
+
+@main.command()
+@click.option('--channels', default=8, help='Synthetic channels fed per chunk')
+@click.option('--rate', default='1', help='Target speed as a multiple of real time, or "max"')
+@click.option('--duration', default=30.0, help='Wall-clock seconds to run')
+@click.option('--chunk-ms', default=100, help='Chunk length in milliseconds')
+@click.option('--calls-per-minute', default=6.0, help='Mean calls per channel per minute of audio')
+@click.option('--queue-depth', default=4, help='Chunks buffered before the generator starts dropping')
+@click.option('--threads', default=0, help='Compute threads (0 = one per core)')
+@click.option('--float32', 'use_float32', is_flag=True, help='Run the float32 pipeline')
+@click.option('--seed', type=int, default=None, help='Seed for a reproducible load')
+def soak(channels, rate, duration, chunk_ms, calls_per_minute, queue_depth, threads, use_float32, seed):
+    """Soak-test the monitor with endless synthetic audio at N x real time."""
+    
+    click.echo("🔥 BUSH EARS SOAK TEST")
+    click.echo("━━━━━━━━━━━━━━━━━━━━━━")
+    
+    target_rate = 0.0 if rate == 'max' else float(rate)
+    set_num_threads(threads)
+    monitor = EcosystemMonitorF32() if use_float32 else EcosystemMonitor()
+    generator = LoadGenerator(num_channels=channels, chunk_size=max(1, 44100 * chunk_ms // 1000),
+                              calls_per_minute=calls_per_minute, seed=seed)
+    
+    pace = "as fast as possible" if target_rate == 0 else f"at {target_rate:g}x real time"
+    click.echo(f"\n📡 Feeding {channels} channels {pace} for {duration:g}s...")
+    report = generator.run(monitor, duration=duration, rate=target_rate, queue_depth=queue_depth)
+    
+    click.echo(f"\n⏱️ Sustained Throughput:")
+    click.echo(f"   Audio per channel: {report['audio_seconds']:,.1f}s in {report['wall_seconds']:.1f}s")
+    click.echo(f"   Real-time factor: {report['realtime_factor']:.1f}x "
+               f"({report['channel_realtime_factor']:.1f} channel-seconds per second)")
+    click.echo(f"   Chunks: {report['chunks_processed']:,} processed, {report['chunks_dropped']:,} dropped")
+    click.echo(f"   Detections: {report['detections']:,}")
+    
+    chunk = monitor.get_perf_stats()['stages']['chunk']
+    if chunk['count']:
+        click.echo(f"   Chunk latency: p50 {chunk['p50_us'] / 1e3:.2f} ms, p99 {chunk['p99_us'] / 1e3:.2f} ms, "
+                   f"max {chunk['max_us'] / 1e3:.2f} ms")
+    
+    if report['chunks_dropped']:
+        click.echo(f"\n❌ Monitor fell behind: {report['chunks_dropped'] / report['chunks_generated']:.1%} "
+                   f"of chunks dropped")
+    elif target_rate and report['realtime_factor'] < 0.95 * target_rate:
+        click.echo(f"\n❌ Generator could not hold {target_rate:g}x real time")
+    else:
+        click.echo(f"\n✅ Kept up with {channels} channels at {report['realtime_factor']:.1f}x real time")
+
 if __name__ == "__main__":
     main()
@@ -1,6 +1,7 @@
 """FastAPI server for real-time wildlife monitoring interface."""
 
 import asyncio
+import itertools
 import json
 import logging
 import numpy as np
@@ -17,6 +18,18 @@ logger = logging.getLogger(__name__)
 analyzer = BushEarsAnalyzer()
 active_connections: List[WebSocket] = []
 
+# Each websocket streams on its own monitor channel; 0 is process_audio_stream's stream.
+# Closed channels are reused, so the monitor keeps one stream per concurrent connection
+new_stream_channels = itertools.count(1)
+free_stream_channels: List[int] = []
+
+def acquire_stream_channel() -> int:
+    return free_stream_channels.pop() if free_stream_channels else next(new_stream_channels)
+
+def release_stream_channel(channel: int) -> None:
+    analyzer.close_stream(channel)
+    free_stream_channels.append(channel)
+
 def get_scientific_name(common_name: str) -> str:
     """Get scientific name for species."""
     scientific_names = {
@@ -187,6 +200,13 @@ async def dashboard():
             
             <h4 style="margin-top: 20px; margin-bottom: 10px;">Species Count</h4>
             <div id="speciesList"></div>
+            
+            <h4 style="margin-top: 20px; margin-bottom: 10px;">Pipeline Latency</h4>
+            <div class="metric">
+                <div class="metric-label">Real-time Factor</div>
+                <div class="metric-value" id="realtimeFactor">-</div>
+            </div>
+            <div id="stageLatency"></div>
         </div>
     </div>
     
@@ -204,6 +224,32 @@ async def dashboard():
                     'Dingo': '🐺'
                 };
                 this.bindEvents();
+                this.pollPerfStats();
+                setInterval(() => this.pollPerfStats(), 2000);
+            }
+            
+            async pollPerfStats() {
+                try {
+                    const response = await fetch('/api/perf');
+                    const data = await response.json();
+                    this.updatePerfStats(data.perf_stats, data.alerts);
+                } catch (e) {
+                    // Server unavailable; keep the last values
+                }
+            }
+            
+            updatePerfStats(stats, alerts) {
+                const factor = document.getElementById('realtimeFactor');
+                factor.textContent = stats.chunks > 0 ? `${stats.realtime_factor.toFixed(1)}x` : '-';
+                factor.style.color = alerts.falling_behind_realtime ? '#ff3333' : '#fff';
+                
+                const rows = Object.entries(stats.stages)
+                    .filter(([, stage]) => stage.count > 0)
+                    .map(([name, stage]) =>
+                        `<div class="metric-label">${name}: p50 ${stage.p50_us.toFixed(1)} / ` +
+                        `p99 ${stage.p99_us.toFixed(1)} / p999 ${stage.p999_us.toFixed(1)} us</div>`);
+                document.getElementById('stageLatency').innerHTML =
+                    stats.enabled ? rows.join('') : '<div class="metric-label">instrumentation disabled</div>';
             }
             
             bindEvents() {
@@ -353,11 +399,17 @@ async def websocket_endpoint(websocket: WebSocket, scenario: str):
         ]
     }
     
+    channel = acquire_stream_channel()
     try:
         scheduled_detections = demo_species.get(scenario, [])
         detection_index = 0
         simulation_time = 0.0
         
+        # Scenario audio streamed through the native analyser alongside the demo;
+        # submissions from every connection are batched together off the event loop
+        audio = await asyncio.get_running_loop().run_in_executor(None, analyzer.generate_test_audio, scenario)
+        chunk_samples = 4410
+        
         logger.info(f"Running demo mode for {scenario} with {len(scheduled_detections)} scheduled detections")
         
         # Run for 10 seconds, sending updates every 0.1 seconds
@@ -393,6 +445,12 @@ async def websocket_endpoint(websocket: WebSocket, scenario: str):
                 
                 logger.debug(f"Demo detection: {species_name} at {simulation_time:.1f}s")
             
+            start = int(round(simulation_time * 44100))
+            chunk = audio[start:start + chunk_samples]
+            if len(chunk) == chunk_samples:
+                analysis = await analyzer.analyze_audio_stream_async(chunk, channel)
+                detection_data['audio_features'] = analysis.get('audio_features', [])
+            
             # Always send update (with or without detection)
             await websocket.send_text(json.dumps(detection_data, default=str))
             await asyncio.sleep(0.1)
@@ -415,6 +473,7 @@ async def websocket_endpoint(websocket: WebSocket, scenario: str):
     except Exception as e:
         logger.error(f"WebSocket error: {e}")
     finally:
+        release_stream_channel(channel)
         active_connections.remove(websocket)
 
 @app.get("/api/species")
@@ -439,12 +498,41 @@ async def run_benchmark():
     
     return {
         "benchmark_results": results,
+        "pipeline": analyzer.get_perf_stats(),
         "analysis": {
             "realtime_capable": results['cpp_samples_per_second'] >= 44100,
             "speedup_category": "exceptional" if results['speedup'] > 20 else "good" if results['speedup'] > 5 else "modest"
         }
     }
 
+@app.get("/api/perf")
+async def get_perf_stats():
+    """Per-stage latency of the live native pipeline, alerting when it falls behind real time."""
+    stats = analyzer.get_perf_stats()
+    falling_behind = stats['chunks'] > 0 and stats['realtime_factor'] < 1.0
+    if falling_behind:
+        logger.warning(f"Pipeline below real time: {stats['realtime_factor']:.2f}x")
+    
+    return {
+        "perf_stats": stats,
+        "alerts": {"falling_behind_realtime": falling_behind}
+    }
+
+@app.get("/api/metrics/window")
+async def get_metrics_window(window_seconds: float = 3600.0):
+    """Ecosystem indices over a recent window plus the per-bucket series behind them."""
+    window = analyzer.monitor.export_metrics_window()
+    bucket_starts = window['start_time'] + window['bucket_seconds'] * np.arange(len(window['frames_analyzed']))
+    
+    return {
+        "scores": analyzer.monitor.get_window_metrics(window_seconds),
+        "bucket_seconds": window['bucket_seconds'],
+        "bucket_start": bucket_starts.tolist(),
+        "detections": window['species_counts'].sum(axis=1).tolist(),
+        "species_counts": window['species_counts'].tolist(),
+        "frames_analyzed": window['frames_analyzed'].tolist()
+    }
+
 def run_server(host: str = "127.0.0.1", port: int = 8002, debug: bool = False, headless: bool = False):
     """Run the FastAPI server."""
     log_level = "debug" if debug else "error"
@@ -0,0 +1,111 @@
+/*
+ * Bush Ears - Detection event queue
+ * Bounded lock-free ring carrying compact detection events from native producers
+ * to a Python consumer that drains them in bulk
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+// One detection, laid out as a NumPy structured array record
+struct DetectionEvent {
+    double timestamp;      // Onset: Unix time, or seconds into the stream for files
+    float features[8];     // AudioProcessor feature vector (of the most confident frame)
+    float confidence;      // Winning class probability (peak over the event)
+    float duration;        // Seconds from onset to offset
+    uint32_t channel;
+    uint8_t species_id;    // AustralianSpecies
+};
+
+// Bounded multi-producer / single-consumer ring (Vyukov's per-slot sequence scheme).
+// Producers claim a slot with one CAS on head_ and publish it through the slot's
+// sequence number; the consumer never touches head_, so neither side takes a lock.
+// A full ring drops the new event and counts it instead of blocking the producer.
+template <typename T>
+class BoundedMpscQueue {
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};    // Next slot to claim (producers)
+    alignas(64) std::atomic<size_t> tail_{0};    // Next slot to read (consumer only writes)
+    alignas(64) std::atomic<size_t> dropped_{0};
+
+public:
+    explicit BoundedMpscQueue(size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("Queue capacity must be a power of two >= 2");
+        }
+        slots_ = std::make_unique<Slot[]>(capacity);
+        mask_ = capacity - 1;
+        for (size_t i = 0; i < capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Events claimed but not yet drained (approximate while producers run).
+    // Tail is read first so a concurrent drain can never make head - tail negative.
+    size_t size() const {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return head - tail;
+    }
+
+    size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Safe from any number of threads; false if the ring is full
+    bool try_push(const T& value) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Copy up to max_count published events into out; single consumer only.
+    // Stops early at a slot a producer has claimed but not yet published.
+    size_t drain(T* out, size_t max_count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < max_count) {
+            Slot& slot = slots_[tail & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+                break;
+            }
+            out[count++] = slot.value;
+            slot.sequence.store(tail + capacity(), std::memory_order_release);
+            ++tail;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+};
+
+using DetectionQueue = BoundedMpscQueue<DetectionEvent>;
@@ -0,0 +1,189 @@
+/*
+ * Bush Ears - Detection event segmentation
+ * Merges runs of frame-level classifications into one event per call, with
+ * per-species onset / offset hysteresis scaled by the species' typical call length
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "detection_queue.hpp"
+#include "species.hpp"
+
+// Hysteresis for one species. An event opens once frames at or above
+// onset_confidence have run for onset_seconds, stays open while frames stay at or
+// above offset_confidence with gaps of at most hold_seconds, and is split after
+// max_seconds so a chorus of back-to-back calls still counts call by call.
+struct SpeciesHysteresis {
+    double onset_confidence = 0.4;
+    double offset_confidence = 0.3;  // Below the classifier's unknown threshold this has no effect
+    double onset_seconds = 0.05;
+    double hold_seconds = 0.1;
+    double max_seconds = 2.0;
+
+    // Timings from the species' typical call duration (the prior)
+    static SpeciesHysteresis for_call_duration(double typical_duration) {
+        constexpr double DEFAULT_DURATION = 1.0;  // Species without a profile
+        double duration = typical_duration > 0.0 ? typical_duration : DEFAULT_DURATION;
+        SpeciesHysteresis hysteresis;
+        hysteresis.onset_seconds = 0.05 * duration;
+        hysteresis.hold_seconds = std::max(0.05, 0.1 * duration);
+        hysteresis.max_seconds = 2.0 * duration;
+        return hysteresis;
+    }
+};
+
+struct EventSegmenterConfig {
+    bool enabled = true;  // False: every detected frame is its own event
+    std::array<SpeciesHysteresis, NUM_SPECIES> species;
+
+    EventSegmenterConfig() {
+        for (size_t id = 0; id < NUM_SPECIES; ++id) {
+            species[id] = SpeciesHysteresis::for_call_duration(SPECIES_TABLE[id].typical_duration);
+        }
+    }
+};
+
+inline constexpr size_t EVENT_FEATURES = std::size(DetectionEvent{}.features);
+
+// One merged call; times are seconds on the caller's stream clock
+struct SegmentedEvent {
+    AustralianSpecies species = AustralianSpecies::Unknown;
+    double start = 0.0;
+    double end = 0.0;  // End of the last frame that matched
+    float peak_confidence = 0.0f;
+    std::array<float, EVENT_FEATURES> peak_features{};  // Features of the most confident frame
+    size_t frames = 0;  // Frames merged into the event
+};
+
+// Per-stream state machine: at most one open event plus one candidate waiting out
+// its onset. Frames must arrive in time order; frames the caller never classifies
+// (e.g. gated silence) count as gaps. emit(const SegmentedEvent&) runs for every
+// event as it closes.
+class EventSegmenter {
+private:
+    EventSegmenterConfig config_;
+    SegmentedEvent open_;       // species Unknown when no event is open
+    SegmentedEvent candidate_;  // Run not yet long enough to open
+
+public:
+    void configure(const EventSegmenterConfig& config) { config_ = config; }
+    const EventSegmenterConfig& config() const { return config_; }
+
+    bool has_open_event() const { return open_.species != AustralianSpecies::Unknown; }
+
+    // One classified frame covering [time, time + duration)
+    template <typename Feature, typename Emit>
+    void observe(double time, double duration, AustralianSpecies species, double confidence,
+                 const Feature* features, Emit&& emit) {
+        advance(time, emit);
+        if (species == AustralianSpecies::Unknown) {
+            candidate_ = {};
+            return;
+        }
+        if (!config_.enabled) {
+            SegmentedEvent event;
+            begin(event, time, duration, species, confidence, features);
+            emit(static_cast<const SegmentedEvent&>(event));
+            return;
+        }
+
+        const SpeciesHysteresis& hysteresis = config_.species[static_cast<size_t>(species)];
+        if (species == open_.species && confidence >= hysteresis.offset_confidence) {
+            if (time + duration - open_.start > hysteresis.max_seconds) {
+                close(emit);
+                begin(open_, time, duration, species, confidence, features);
+            } else {
+                extend(open_, time, duration, confidence, features);
+            }
+            candidate_ = {};
+            return;
+        }
+
+        if (confidence < hysteresis.onset_confidence) {
+            // Inside the hysteresis band a candidate of the same species survives
+            if (species != candidate_.species || confidence < hysteresis.offset_confidence) {
+                candidate_ = {};
+            }
+            return;
+        }
+        if (species == candidate_.species) {
+            extend(candidate_, time, duration, confidence, features);
+        } else {
+            begin(candidate_, time, duration, species, confidence, features);
+        }
+        if (candidate_.end - candidate_.start >= hysteresis.onset_seconds) {
+            close(emit);
+            open_ = candidate_;
+            candidate_ = {};
+        }
+    }
+
+    // Close the open event if its hold has run out by time, even without new frames
+    template <typename Emit>
+    void advance(double time, Emit&& emit) {
+        if (has_open_event() && time - open_.end > hold_seconds(open_.species)) {
+            close(emit);
+        }
+        if (candidate_.species != AustralianSpecies::Unknown &&
+            time - candidate_.end > hold_seconds(candidate_.species)) {
+            candidate_ = {};
+        }
+    }
+
+    // End of stream: close the open event and forget the candidate
+    template <typename Emit>
+    void flush(Emit&& emit) {
+        close(emit);
+        candidate_ = {};
+    }
+
+    void reset() {
+        open_ = {};
+        candidate_ = {};
+    }
+
+private:
+    double hold_seconds(AustralianSpecies species) const {
+        return config_.species[static_cast<size_t>(species)].hold_seconds;
+    }
+
+    template <typename Emit>
+    void close(Emit&& emit) {
+        if (has_open_event()) {
+            emit(static_cast<const SegmentedEvent&>(open_));
+            open_ = {};
+        }
+    }
+
+    template <typename Feature>
+    static void begin(SegmentedEvent& event, double time, double duration, AustralianSpecies species,
+                      double confidence, const Feature* features) {
+        event.species = species;
+        event.start = time;
+        event.end = time + duration;
+        event.frames = 1;
+        set_peak(event, confidence, features);
+    }
+
+    template <typename Feature>
+    static void extend(SegmentedEvent& event, double time, double duration, double confidence,
+                       const Feature* features) {
+        event.end = time + duration;
+        event.frames++;
+        if (confidence > event.peak_confidence) {
+            set_peak(event, confidence, features);
+        }
+    }
+
+    template <typename Feature>
+    static void set_peak(SegmentedEvent& event, double confidence, const Feature* features) {
+        event.peak_confidence = static_cast<float>(confidence);
+        std::transform(features, features + EVENT_FEATURES, event.peak_features.begin(),
+                       [](Feature value) { return static_cast<float>(value); });
+    }
+};
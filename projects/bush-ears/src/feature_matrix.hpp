@@ -0,0 +1,99 @@
+/*
+ * Bush Ears - Columnar feature matrix
+ * Batch features stored column by column (structure of arrays) in one aligned block:
+ * extraction fills it row by row, inference reads it in place, and every feature is
+ * one contiguous array that NumPy or Arrow can wrap without a copy
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// Column-major (rows x Columns) matrix. Each column starts on a cache line and is
+// padded to whole ROW_GROUPs, so workers filling disjoint row groups never write to
+// the same line. Storage is either owned (e.g. to hand to Python) or borrowed from a
+// caller such as a BatchArena.
+template <typename Real, size_t Columns>
+class FeatureMatrixT {
+public:
+    static constexpr size_t COLUMNS = Columns;
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t ROW_GROUP = ALIGNMENT / sizeof(Real);  // Rows per cache line of a column
+
+    // Read-only rows of a matrix; element (row, column) is data[column * stride + row]
+    struct View {
+        const Real* data = nullptr;
+        size_t rows = 0;
+        size_t stride = 0;
+
+        Real operator()(size_t row, size_t column) const { return data[column * stride + row]; }
+
+        // Rows [first, first + count)
+        View subview(size_t first, size_t count) const { return {data + first, count, stride}; }
+    };
+
+    // Values between the starts of consecutive columns
+    static constexpr size_t column_stride(size_t rows) { return (rows + ROW_GROUP - 1) / ROW_GROUP * ROW_GROUP; }
+
+    // Values of storage a matrix of rows needs
+    static constexpr size_t storage_size(size_t rows) { return column_stride(rows) * COLUMNS; }
+
+    FeatureMatrixT() = default;
+
+    // Owned, zeroed storage
+    explicit FeatureMatrixT(size_t rows) : rows_(rows), stride_(column_stride(rows)) {
+        size_t bytes = std::max<size_t>(storage_size(rows) * sizeof(Real), ALIGNMENT);
+        owned_.reset(static_cast<Real*>(::operator new[](bytes, std::align_val_t{ALIGNMENT})));
+        data_ = owned_.get();
+        std::fill_n(data_, storage_size(rows), Real(0));
+    }
+
+    // Borrowed storage of at least storage_size(rows) values aligned to ALIGNMENT,
+    // which must outlive the matrix
+    FeatureMatrixT(std::span<Real> storage, size_t rows)
+        : data_(storage.data()), rows_(rows), stride_(column_stride(rows)) {
+        if (storage.size() < storage_size(rows)) {
+            throw std::invalid_argument("Feature matrix storage is too small for " + std::to_string(rows) + " rows");
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t stride() const { return stride_; }
+
+    Real* data() { return data_; }
+    const Real* data() const { return data_; }
+
+    Real* column(size_t column) { return data_ + column * stride_; }
+    const Real* column(size_t column) const { return data_ + column * stride_; }
+
+    // Scatter COLUMNS values into one row
+    void set_row(size_t row, const Real* values) {
+        for (size_t column = 0; column < COLUMNS; ++column) {
+            data_[column * stride_ + row] = values[column];
+        }
+    }
+
+    void get_row(size_t row, Real* values) const {
+        for (size_t column = 0; column < COLUMNS; ++column) {
+            values[column] = data_[column * stride_ + row];
+        }
+    }
+
+    View view() const { return {data_, rows_, stride_}; }
+
+private:
+    struct Deleter {
+        void operator()(Real* data) const { ::operator delete[](data, std::align_val_t{ALIGNMENT}); }
+    };
+
+    std::unique_ptr<Real[], Deleter> owned_;
+    Real* data_ = nullptr;
+    size_t rows_ = 0;
+    size_t stride_ = 0;
+};
@@ -0,0 +1,93 @@
+/*
+ * Bush Ears - Real-input FFT engine
+ * Iterative radix-2 transform with twiddle and bit-reversal tables built once per size
+ * and precision
+ */
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <cstddef>
+
+// Forward FFT of N real samples producing the N/2 + 1 non-redundant bins.
+// The real input is packed into an N/2-point complex sequence (even samples as the
+// real part, odd samples as the imaginary part), transformed, then split back into
+// the real spectrum, so a frame costs one half-length complex FFT.
+// Real is double or float; float halves the working set and doubles the SIMD lanes.
+template <size_t N, typename Real = double>
+class RealFFT {
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "FFT size must be a power of two >= 4");
+
+    static constexpr size_t HALF = N / 2;
+
+    using Complex = std::complex<Real>;
+    
+    std::vector<Complex> twiddles_;               // W_N^k for k in [0, N/2)
+    std::vector<size_t> bit_reverse_;              // Input permutation for the N/2-point transform
+
+public:
+    static constexpr size_t SIZE = N;
+    static constexpr size_t BINS = N / 2 + 1;
+    static constexpr size_t WORK_SIZE = N / 2;
+
+    RealFFT() : twiddles_(HALF), bit_reverse_(HALF) {
+        for (size_t k = 0; k < HALF; ++k) {
+            double angle = -2.0 * M_PI * static_cast<double>(k) / N;
+            twiddles_[k] = Complex(static_cast<Real>(std::cos(angle)), static_cast<Real>(std::sin(angle)));
+        }
+
+        size_t bits = 0;
+        while ((size_t{1} << bits) < HALF) {
+            ++bits;
+        }
+        for (size_t i = 0; i < HALF; ++i) {
+            size_t reversed = 0;
+            for (size_t b = 0; b < bits; ++b) {
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            bit_reverse_[i] = reversed;
+        }
+    }
+
+    // Transform N real samples into BINS complex bins (no allocation).
+    // The tables are read-only, so threads may share one engine as long as
+    // each passes its own WORK_SIZE scratch buffer.
+    void forward(const Real* input, Complex* output, Complex* work) const {
+        const Complex* twiddles = twiddles_.data();
+        const size_t* bit_reverse = bit_reverse_.data();
+
+        // Pack even/odd samples, scattering straight into bit-reversed order
+        for (size_t n = 0; n < HALF; ++n) {
+            work[bit_reverse[n]] = Complex(input[2 * n], input[2 * n + 1]);
+        }
+
+        // Radix-2 butterflies; W_len^j is W_N^(j * N / len) from the shared table
+        for (size_t len = 2; len <= HALF; len <<= 1) {
+            const size_t half_len = len / 2;
+            const size_t stride = N / len;
+            for (size_t start = 0; start < HALF; start += len) {
+                Complex* lo = work + start;
+                Complex* hi = lo + half_len;
+                for (size_t j = 0; j < half_len; ++j) {
+                    Complex t = hi[j] * twiddles[j * stride];
+                    hi[j] = lo[j] - t;
+                    lo[j] = lo[j] + t;
+                }
+            }
+        }
+
+        // Split the packed spectrum into even/odd halves and recombine
+        output[0] = Complex(work[0].real() + work[0].imag(), 0);
+        output[HALF] = Complex(work[0].real() - work[0].imag(), 0);
+
+        for (size_t k = 1; k < HALF; ++k) {
+            Complex z = work[k];
+            Complex z_mirror = std::conj(work[HALF - k]);
+            Complex even = Real(0.5) * (z + z_mirror);
+            Complex odd = Complex(0, Real(-0.5)) * (z - z_mirror);
+            output[k] = even + twiddles[k] * odd;
+        }
+    }
+};
@@ -10,8 +10,8 @@
 
 #include <vector>
 #include <array>
+#include <bit>
 #include <string>
-#include <unordered_map>
 #include <algorithm>
 #include <numeric>
 #include <execution>
@@ -19,421 +19,1218 @@
 #include <complex>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <functional>
+#include <fstream>
 #include <random>
-#include <optional>
+#include <span>
+#include <thread>
+#include <unordered_map>
 
-namespace py = pybind11;
+#include "audio_file.hpp"
+#include "batch_arena.hpp"
+#include "blocking_queue.hpp"
+#include "fft.hpp"
+#include "detection_queue.hpp"
+#include "event_segmenter.hpp"
+#include "feature_matrix.hpp"
+#include "mel.hpp"
+#include "metrics_window.hpp"
+#include "micro_batcher.hpp"
+#include "model_file.hpp"
+#include "perf_stats.hpp"
+#include "species.hpp"
+#include "thread_pool.hpp"
+#include "spectral_kernels.hpp"
+#include "spectrogram.hpp"
+#include "synthesis.hpp"
 
-// Australian wildlife species database
-enum class AustralianSpecies : uint8_t {
-    Unknown = 0,
-    Kookaburra = 1,
-    Magpie = 2,
-    Galah = 3,
-    Cockatoo = 4,
-    Lorikeet = 5,
-    Butcherbird = 6,
-    WattleBird = 7,
-    Koala = 8,
-    PossumBrushtail = 9,
-    Dingo = 10,
-    FruitBat = 11
-};
+namespace py = pybind11;
 
-// Species data with call characteristics
-struct SpeciesProfile {
-    AustralianSpecies species;
-    std::string common_name;
-    std::string scientific_name;
-    double min_frequency;    // Hz
-    double max_frequency;    // Hz
-    double typical_duration; // seconds
-    double conservation_weight; // ecosystem importance (0-1)
-    std::vector<double> call_pattern; // frequency signature
-};
+// Input samples as Real: 16-bit PCM is scaled to [-1, 1), floating-point passes through
+template <typename Real, typename Sample>
+constexpr Real sample_value(Sample sample) {
+    if constexpr (std::is_same_v<Sample, int16_t>) {
+        return static_cast<Real>(sample) * static_cast<Real>(1.0 / 32768.0);
+    } else {
+        return static_cast<Real>(sample);
+    }
+}
 
-// Audio processing utilities
-class AudioProcessor {
+// Audio processing utilities, specialised at compile time per recorder configuration
+// and working precision (double, or float for the float32 pipeline)
+template <size_t SampleRate, size_t FftSize, size_t HopSize, typename Precision = double>
+class AudioProcessorT {
+public:
+    using Real = Precision;
+    static constexpr size_t SAMPLE_RATE = SampleRate;
+    static constexpr size_t FFT_SIZE = FftSize;
+    static constexpr size_t HOP_SIZE = HopSize;
+    
+    static_assert(HOP_SIZE > 0 && HOP_SIZE <= FFT_SIZE, "Hop size must be in (0, FFT_SIZE]");
+    
+private:
+    static constexpr double NYQUIST = SAMPLE_RATE / 2.0;
+    static constexpr double BIN_HZ = static_cast<double>(SAMPLE_RATE) / FFT_SIZE;
+    
+    // Energy bands: low [0, 1 kHz), mid [1, 4 kHz), high [4, 8 kHz), very high [8 kHz, Nyquist)
+    static constexpr size_t NUM_BANDS = 4;
+    static_assert(NYQUIST > 8000.0, "Sample rate too low for the 8 kHz band edge");
+    static constexpr std::array<size_t, NUM_BANDS + 1> BAND_EDGES = [] {
+        constexpr std::array<double, NUM_BANDS> band_start_hz = {0.0, 1000.0, 4000.0, 8000.0};
+        std::array<size_t, NUM_BANDS + 1> edges{};
+        for (size_t band = 0; band < NUM_BANDS; ++band) {
+            edges[band] = static_cast<size_t>(band_start_hz[band] * 2.0 * (FFT_SIZE / 2 + 1) / SAMPLE_RATE);
+        }
+        edges[NUM_BANDS] = FFT_SIZE / 2 + 1;
+        return edges;
+    }();
+    
+public:
+    static constexpr size_t FREQ_BINS = FFT_SIZE / 2 + 1;
+    static constexpr size_t NUM_FEATURES = 8;
+    
 private:
-    static constexpr size_t SAMPLE_RATE = 44100;
-    static constexpr size_t FFT_SIZE = 1024;
-    static constexpr size_t HOP_SIZE = 512;
+    // Working buffers for transforming one frame; one per thread when running in parallel
+    struct FrameScratch {
+        std::vector<Real> frame_buffer = std::vector<Real>(FFT_SIZE);
+        std::vector<std::complex<Real>> fft_buffer = std::vector<std::complex<Real>>(FREQ_BINS);
+        std::vector<std::complex<Real>> fft_work =
+            std::vector<std::complex<Real>>(RealFFT<FFT_SIZE, Real>::WORK_SIZE);
+    };
     
-    std::vector<std::complex<double>> fft_buffer_;
-    std::vector<double> window_;
-    std::vector<double> magnitude_spectrum_;
+    RealFFT<FFT_SIZE, Real> fft_;
+    FrameScratch scratch_;
+    std::vector<Real> window_;
+    std::vector<Real> bin_freq_;
+    std::vector<Real> magnitude_spectrum_;
+    std::shared_ptr<const MelFeatureEngine> mel_engine_;  // Built on first mel / MFCC call
+    PerfStats* perf_ = nullptr;  // Stage timings of extract_features, when attached
     
 public:
-    AudioProcessor() : fft_buffer_(FFT_SIZE), 
-                      window_(FFT_SIZE), 
-                      magnitude_spectrum_(FFT_SIZE / 2 + 1) {
+    AudioProcessorT() : window_(FFT_SIZE), 
+                      bin_freq_(FREQ_BINS),
+                      magnitude_spectrum_(FREQ_BINS) {
         // Initialize Hann window for audio analysis
         for (size_t i = 0; i < FFT_SIZE; ++i) {
-            window_[i] = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / (FFT_SIZE - 1)));
+            window_[i] = static_cast<Real>(0.5 * (1.0 - std::cos(2.0 * M_PI * i / (FFT_SIZE - 1))));
+        }
+        
+        // Centre frequency of every bin, shared by all spectral features
+        for (size_t i = 0; i < FREQ_BINS; ++i) {
+            bin_freq_[i] = static_cast<Real>(i * BIN_HZ);
+        }
+    }
+    
+    // Fraction of adjacent sample pairs that change sign; shared with the activity gate
+    template <typename Sample>
+    static double compute_zero_crossing_rate(std::span<const Sample> audio_data) {
+        size_t crossings = 0;
+        for (size_t i = 1; i < audio_data.size(); ++i) {
+            if ((audio_data[i-1] >= Sample(0)) != (audio_data[i] >= Sample(0))) {
+                crossings++;
+            }
         }
+        return static_cast<double>(crossings) / audio_data.size();
+    }
+    
+    // Charge extract_features' window / FFT / feature stages to stats (nullptr detaches)
+    void set_perf_stats(PerfStats* stats) { perf_ = stats; }
+    
+    // Number of complete analysis frames in a buffer of the given length
+    static constexpr size_t frame_count(size_t length) {
+        return length < FFT_SIZE ? 0 : (length - FFT_SIZE) / HOP_SIZE + 1;
     }
     
     // Extract audio features for wildlife identification
-    std::vector<double> extract_features(const std::vector<double>& audio_data) {
+    template <typename Sample>
+    std::vector<Real> extract_features(std::span<const Sample> audio_data) {
+        std::vector<Real> features(NUM_FEATURES);
+        extract_features(audio_data, features.data());
+        return features;
+    }
+    
+    // Same, written into NUM_FEATURES caller-owned values (e.g. a row of a batch
+    // matrix) so batch paths allocate nothing per segment
+    template <typename Sample>
+    void extract_features(std::span<const Sample> audio_data, Real* out) {
         
         if (audio_data.size() < FFT_SIZE) {
             throw std::runtime_error("Audio segment too short for analysis");
         }
         
-        // Apply window and compute FFT
-        for (size_t i = 0; i < FFT_SIZE; ++i) {
-            fft_buffer_[i] = std::complex<double>(audio_data[i] * window_[i], 0.0);
-        }
-        
-        // Simple DFT (in production, use FFTW or similar)
-        compute_dft();
-        
-        // Extract magnitude spectrum
-        for (size_t i = 0; i < FFT_SIZE / 2 + 1; ++i) {
-            magnitude_spectrum_[i] = std::abs(fft_buffer_[i]);
-        }
-        
-        // Extract key features for wildlife identification
-        std::vector<double> features;
-        features.reserve(8);
+        StageTimer timer(perf_);
+        compute_magnitude_spectrum(audio_data.first(FFT_SIZE), scratch_, magnitude_spectrum_.data(), &timer);
         
-        // Spectral features
-        features.push_back(compute_spectral_centroid());
-        features.push_back(compute_spectral_bandwidth());
-        features.push_back(compute_spectral_rolloff());
-        features.push_back(compute_zero_crossing_rate(audio_data));
+        // Extract key features for wildlife identification: centroid, bandwidth,
+        // rolloff, zero-crossing rate, then energy in the four frequency bands
+        // (important for bird call identification)
+        std::array<double, NUM_FEATURES> features;
+        compute_spectral_features(features);
+        features[3] = compute_zero_crossing_rate(audio_data);
+        timer.lap(PerfStage::Features);
         
-        // Energy in frequency bands (important for bird call identification)
-        features.push_back(compute_band_energy(0, 1000));     // Low frequency
-        features.push_back(compute_band_energy(1000, 4000));  // Mid frequency  
-        features.push_back(compute_band_energy(4000, 8000));  // High frequency
-        features.push_back(compute_band_energy(8000, 22050)); // Very high frequency
-        
-        return features;
+        std::copy(features.begin(), features.end(), out);
     }
     
-    // Real-time spectrogram computation for visualization
-    py::array_t<double> compute_spectrogram(py::array_t<double> audio) {
-        auto buf = audio.request();
-        auto* ptr = static_cast<double*>(buf.ptr);
-        size_t length = buf.shape[0];
-        
-        size_t num_frames = (length - FFT_SIZE) / HOP_SIZE + 1;
-        size_t freq_bins = FFT_SIZE / 2 + 1;
+    // Real-time spectrogram computation for visualization: the full (frames x FREQ_BINS)
+    // linear magnitude spectrogram at working precision
+    template <typename Sample>
+    py::array_t<Real> compute_spectrogram(std::span<const Sample> audio, size_t num_threads = 1) {
+        return compute_spectrogram<Real>(audio, SpectrogramConfig{}, num_threads);
+    }
+    
+    // Spectrogram cropped, pooled and scaled per config as (rows x columns) of Out
+    // (double, float, or uint8_t quantized dB), built frame by frame so only the
+    // reduced result is ever allocated. Every call brings its own scratch buffers, and
+    // output rows are independent, so with num_threads != 1 they are split across
+    // threads that each own theirs; 0 uses every hardware thread.
+    template <typename Out = Real, typename Sample>
+    py::array_t<Out> compute_spectrogram(std::span<const Sample> audio, const SpectrogramConfig& config,
+                                         size_t num_threads = 1) {
+        if (std::is_same_v<Out, uint8_t> && config.scale != SpectrogramScale::Decibels) {
+            throw std::invalid_argument("uint8 spectrograms quantize decibels; use the dB scale");
+        }
+        SpectrogramLayout layout = spectrogram_layout(config);
+        size_t num_frames = frame_count(audio.size());
+        size_t rows = layout.rows(num_frames);
         
-        auto result = py::array_t<double>({num_frames, freq_bins});
-        auto result_buf = result.request();
-        auto* result_ptr = static_cast<double*>(result_buf.ptr);
+        auto result = py::array_t<Out>({rows, layout.columns()});
+        Out* result_ptr = result.mutable_data();
         
-        // Process audio in overlapping windows
-        for (size_t frame = 0; frame < num_frames; ++frame) {
-            size_t start_idx = frame * HOP_SIZE;
-            std::vector<double> segment(ptr + start_idx, ptr + start_idx + FFT_SIZE);
-            
-            try {
-                auto features = extract_features(segment);
-                // Copy magnitude spectrum to result
-                std::copy(magnitude_spectrum_.begin(), magnitude_spectrum_.end(),
-                         result_ptr + frame * freq_bins);
-            } catch (const std::exception&) {
-                // Fill with zeros on error
-                std::fill(result_ptr + frame * freq_bins, 
-                         result_ptr + (frame + 1) * freq_bins, 0.0);
-            }
+        {
+            py::gil_scoped_release release;
+            compute_spectrogram_rows(audio, layout, result_ptr, num_frames, num_threads);
         }
         
         return result;
     }
+    
+    // Geometry of config's output for this processor (validates the config)
+    SpectrogramLayout spectrogram_layout(const SpectrogramConfig& config) const {
+        // A full-scale sine's peak bin has magnitude sum(window) / 2: that power is 0 dBFS
+        double window_sum = std::accumulate(window_.begin(), window_.end(), 0.0);
+        return SpectrogramLayout(SAMPLE_RATE, FFT_SIZE, config, window_sum * window_sum / 4.0);
+    }
+
+    // Log-mel spectrogram (frames x num_mels), float32 for downstream models
+    template <typename Sample>
+    py::array_t<float> compute_mel_spectrogram(std::span<const Sample> audio, const MelConfig& config) {
+        return compute_mel_frames(audio, config, false);
+    }
+    
+    // MFCCs (frames x num_coeffs): DCT-II of the log-mel energies, float32
+    template <typename Sample>
+    py::array_t<float> compute_mfcc(std::span<const Sample> audio, const MelConfig& config) {
+        return compute_mel_frames(audio, config, true);
+    }
 
 private:
-    void compute_dft() {
-        // Simplified DFT (use FFTW in production for better performance)
-        std::vector<std::complex<double>> temp(FFT_SIZE);
-        
-        for (size_t k = 0; k < FFT_SIZE; ++k) {
-            std::complex<double> sum(0.0, 0.0);
-            for (size_t n = 0; n < FFT_SIZE; ++n) {
-                double angle = -2.0 * M_PI * k * n / FFT_SIZE;
-                sum += fft_buffer_[n] * std::complex<double>(std::cos(angle), std::sin(angle));
+    // Reuse the cached engine unless the requested shape differs; callers hold their
+    // own reference, so a later call with another shape cannot free it under them
+    std::shared_ptr<const MelFeatureEngine> mel_engine(MelConfig config) {
+        if (config.max_hz == 0.0) {
+            config.max_hz = NYQUIST;
+        }
+        if (!mel_engine_ || !(mel_engine_->config() == config)) {
+            mel_engine_ = std::make_shared<const MelFeatureEngine>(SAMPLE_RATE, FFT_SIZE, config);
+        }
+        return mel_engine_;
+    }
+    
+    template <typename Sample>
+    py::array_t<float> compute_mel_frames(std::span<const Sample> audio, const MelConfig& config, bool mfcc) {
+        std::shared_ptr<const MelFeatureEngine> engine = mel_engine(config);
+        size_t num_mels = engine->config().num_mels;
+        size_t width = mfcc ? engine->config().num_coeffs : num_mels;
+        size_t num_frames = frame_count(audio.size());
+        
+        auto result = py::array_t<float>({num_frames, width});
+        float* out = result.mutable_data();
+        
+        {
+            // Other calls may run on this processor once the GIL is released, so the
+            // frames go through scratch of this call's own
+            py::gil_scoped_release release;
+            FrameScratch scratch;
+            std::vector<Real> magnitude(FREQ_BINS);
+            std::vector<double> power(FREQ_BINS);
+            std::vector<double> log_mel(num_mels);
+            for (size_t frame = 0; frame < num_frames; ++frame) {
+                compute_magnitude_spectrum(audio.subspan(frame * HOP_SIZE, FFT_SIZE), scratch, magnitude.data());
+                engine->log_mel(magnitude.data(), FREQ_BINS, power.data(), log_mel.data());
+                float* row = out + frame * width;
+                if (mfcc) {
+                    engine->mfcc(log_mel.data(), row);
+                } else {
+                    std::transform(log_mel.begin(), log_mel.end(), row,
+                                   [](double value) { return static_cast<float>(value); });
+                }
             }
-            temp[k] = sum;
         }
         
-        fft_buffer_ = std::move(temp);
+        return result;
     }
     
-    double compute_spectral_centroid() {
-        double weighted_sum = 0.0;
-        double magnitude_sum = 0.0;
+    // Write every row of layout's spectrogram straight into output, pooling each
+    // row's frames into per-column power sums as they are transformed
+    template <typename Out, typename Sample>
+    void compute_spectrogram_rows(std::span<const Sample> audio, const SpectrogramLayout& layout, Out* output,
+                                  size_t num_frames, size_t num_threads) {
+        size_t rows = layout.rows(num_frames);
+        size_t columns = layout.columns();
+        size_t decimation = layout.config().time_decimation;
+        bool pool_bins = layout.config().freq_decimation > 1;
+        bool direct = decimation == 1 && !pool_bins && layout.config().scale == SpectrogramScale::Magnitude;
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        num_threads = std::min(num_threads, rows);
+        
+        // Process audio in overlapping windows, reading frames in place
+        auto process_range = [&](size_t first, size_t last, FrameScratch& scratch) {
+            std::vector<Real> power(pool_bins ? FREQ_BINS : 0);
+            std::vector<double> sums(columns);
+            for (size_t row = first; row < last; ++row) {
+                if constexpr (std::is_same_v<Out, Real>) {
+                    // Unpooled magnitudes need no accumulator: write the cropped bins in place
+                    if (direct) {
+                        transform_frame(audio.subspan(row * HOP_SIZE, FFT_SIZE), scratch);
+                        const std::complex<Real>* bins = scratch.fft_buffer.data() + layout.first_bin();
+                        Real* out = output + row * columns;
+                        for (size_t column = 0; column < columns; ++column) {
+                            out[column] = std::sqrt(std::norm(bins[column]));
+                        }
+                        continue;
+                    }
+                }
+                size_t first_frame = row * decimation;
+                size_t last_frame = std::min(first_frame + decimation, num_frames);
+                std::fill(sums.begin(), sums.end(), 0.0);
+                for (size_t frame = first_frame; frame < last_frame; ++frame) {
+                    transform_frame(audio.subspan(frame * HOP_SIZE, FFT_SIZE), scratch);
+                    if (pool_bins) {
+                        for (size_t i = layout.first_bin(); i < layout.last_bin(); ++i) {
+                            power[i] = std::norm(scratch.fft_buffer[i]);
+                        }
+                        layout.accumulate(power.data(), sums.data());
+                    } else {
+                        const std::complex<Real>* bins = scratch.fft_buffer.data() + layout.first_bin();
+                        for (size_t column = 0; column < columns; ++column) {
+                            sums[column] += std::norm(bins[column]);
+                        }
+                    }
+                }
+                layout.write_row(sums.data(), last_frame - first_frame, output + row * columns);
+            }
+        };
         
-        for (size_t i = 0; i < magnitude_spectrum_.size(); ++i) {
-            double freq = i * SAMPLE_RATE / (2.0 * (magnitude_spectrum_.size() - 1));
-            weighted_sum += freq * magnitude_spectrum_[i];
-            magnitude_sum += magnitude_spectrum_[i];
+        if (num_threads <= 1) {
+            FrameScratch scratch;  // Runs without the GIL: the member scratch may be in use by another call
+            process_range(0, rows, scratch);
+            return;
         }
         
-        return magnitude_sum > 0 ? weighted_sum / magnitude_sum : 0.0;
+        size_t rows_per_thread = (rows + num_threads - 1) / num_threads;
+        std::vector<FrameScratch> thread_scratch(num_threads);
+        std::vector<std::jthread> workers;
+        workers.reserve(num_threads);
+        
+        for (size_t t = 0; t < num_threads; ++t) {
+            size_t first = std::min(t * rows_per_thread, rows);
+            size_t last = std::min(first + rows_per_thread, rows);
+            workers.emplace_back(process_range, first, last, std::ref(thread_scratch[t]));
+        }
     }
     
-    double compute_spectral_bandwidth() {
-        double centroid = compute_spectral_centroid();
-        double weighted_deviation = 0.0;
-        double magnitude_sum = 0.0;
+    // Window one FFT_SIZE frame and transform it into scratch.fft_buffer
+    template <typename Sample>
+    void transform_frame(std::span<const Sample> frame, FrameScratch& scratch, StageTimer* timer = nullptr) const {
+        for (size_t i = 0; i < FFT_SIZE; ++i) {
+            scratch.frame_buffer[i] = sample_value<Real>(frame[i]) * window_[i];
+        }
+        if (timer) {
+            timer->lap(PerfStage::Window);
+        }
         
-        for (size_t i = 0; i < magnitude_spectrum_.size(); ++i) {
-            double freq = i * SAMPLE_RATE / (2.0 * (magnitude_spectrum_.size() - 1));
-            double deviation = freq - centroid;
-            weighted_deviation += deviation * deviation * magnitude_spectrum_[i];
-            magnitude_sum += magnitude_spectrum_[i];
+        fft_.forward(scratch.frame_buffer.data(), scratch.fft_buffer.data(), scratch.fft_work.data());
+    }
+    
+    // Window one FFT_SIZE frame and write its FREQ_BINS magnitudes to magnitude
+    template <typename Sample>
+    void compute_magnitude_spectrum(std::span<const Sample> frame, FrameScratch& scratch,
+                                    Real* magnitude, StageTimer* timer = nullptr) const {
+        transform_frame(frame, scratch, timer);
+        
+        for (size_t i = 0; i < FREQ_BINS; ++i) {
+            magnitude[i] = std::sqrt(std::norm(scratch.fft_buffer[i]));
+        }
+        if (timer) {
+            timer->lap(PerfStage::Fft);
         }
+    }
+    
+    // Centroid, bandwidth, rolloff and band energies in one vectorized pass over
+    // magnitude_spectrum_, split at band edges so each band's energy is the change
+    // in the running magnitude sum. Rolloff then only rescans the band it falls in.
+    void compute_spectral_features(std::array<double, NUM_FEATURES>& features) const {
+        const Real* magnitude = magnitude_spectrum_.data();
+        SpectralMoments moments;
+        std::array<double, NUM_BANDS> band_energy{};
+        
+        for (size_t band = 0; band < NUM_BANDS; ++band) {
+            double before = moments.magnitude_sum;
+            accumulate_spectral_moments(magnitude, bin_freq_.data(),
+                                        BAND_EDGES[band], BAND_EDGES[band + 1], moments);
+            band_energy[band] = moments.magnitude_sum - before;
+        }
+        
+        double total = moments.magnitude_sum;
+        double centroid = total > 0 ? moments.weighted_freq_sum / total : 0.0;
         
-        return magnitude_sum > 0 ? std::sqrt(weighted_deviation / magnitude_sum) : 0.0;
+        // Var(f) = E[f^2] - E[f]^2, so bandwidth no longer needs a second pass around the centroid
+        double variance = total > 0 ? moments.weighted_freq_sq_sum / total - centroid * centroid : 0.0;
+        
+        features[0] = centroid;
+        features[1] = std::sqrt(std::max(variance, 0.0));
+        features[2] = compute_spectral_rolloff(band_energy, total);
+        for (size_t band = 0; band < NUM_BANDS; ++band) {
+            features[4 + band] = band_energy[band];
+        }
     }
     
-    double compute_spectral_rolloff(double threshold = 0.85) {
-        double total_energy = std::accumulate(magnitude_spectrum_.begin(), 
-                                            magnitude_spectrum_.end(), 0.0);
-        double cumulative_energy = 0.0;
+    double compute_spectral_rolloff(const std::array<double, NUM_BANDS>& band_energy, double total_energy,
+                                    double threshold = 0.85) const {
         double target_energy = total_energy * threshold;
+        double cumulative_energy = 0.0;
         
-        for (size_t i = 0; i < magnitude_spectrum_.size(); ++i) {
+        // Skip whole bands that stay below the target, then scan bins in the crossing band
+        size_t band = 0;
+        while (band + 1 < NUM_BANDS && cumulative_energy + band_energy[band] < target_energy) {
+            cumulative_energy += band_energy[band];
+            ++band;
+        }
+        
+        for (size_t i = BAND_EDGES[band]; i < FREQ_BINS; ++i) {
             cumulative_energy += magnitude_spectrum_[i];
             if (cumulative_energy >= target_energy) {
-                return i * SAMPLE_RATE / (2.0 * (magnitude_spectrum_.size() - 1));
+                return bin_freq_[i];
             }
         }
         
-        return SAMPLE_RATE / 2.0;  // Nyquist frequency
+        return NYQUIST;
     }
+};
+
+// Pre-instantiated recorder configurations (the 44.1 kHz variant is the default)
+using AudioProcessor = AudioProcessorT<44100, 1024, 512>;
+using AudioProcessor22k = AudioProcessorT<22050, 512, 256>;
+using AudioProcessor48k = AudioProcessorT<48000, 1024, 512>;
+using AudioProcessor96k = AudioProcessorT<96000, 2048, 1024>;
+using AudioProcessorBat = AudioProcessorT<96000, 4096, 1024>; // Finer resolution for FruitBat calls
+
+// float32 pipeline variants of the same configurations
+using AudioProcessorF32 = AudioProcessorT<44100, 1024, 512, float>;
+using AudioProcessor22kF32 = AudioProcessorT<22050, 512, 256, float>;
+using AudioProcessor48kF32 = AudioProcessorT<48000, 1024, 512, float>;
+using AudioProcessor96kF32 = AudioProcessorT<96000, 2048, 1024, float>;
+using AudioProcessorBatF32 = AudioProcessorT<96000, 4096, 1024, float>;
+
+// Cheap pre-filter run before the FFT. A frame counts as activity when its loudest
+// sub-window rises threshold_db above an adaptive noise floor and it is not
+// broadband hiss (zero-crossing rate above max_zero_crossing_rate). The floor
+// follows quiet frames quickly and creeps up slowly under sustained activity.
+struct ActivityGateConfig {
+    bool enabled = false;
+    double threshold_db = 6.0;
+    double max_zero_crossing_rate = 0.4;  // White noise sits near 0.5
+    double adaptation = 0.05;             // Floor update rate on quiet frames
+};
+
+class ActivityGate {
+private:
+    static constexpr size_t SUB_WINDOWS = 4;
+    static constexpr double MIN_ENERGY = 1e-10;       // Digital silence (-100 dBFS)
+    static constexpr double ACTIVE_ADAPTATION = 0.001; // Floor drift while active
     
-    double compute_zero_crossing_rate(const std::vector<double>& audio_data) {
-        size_t crossings = 0;
-        for (size_t i = 1; i < audio_data.size(); ++i) {
-            if ((audio_data[i-1] >= 0.0) != (audio_data[i] >= 0.0)) {
-                crossings++;
+    ActivityGateConfig config_;
+    double threshold_ratio_ = 1.0;
+    double noise_floor_ = 0.0;  // Mean-square energy; 0 until the first frame
+    
+public:
+    ActivityGate() { configure(ActivityGateConfig{}); }
+    
+    void configure(const ActivityGateConfig& config) {
+        config_ = config;
+        threshold_ratio_ = std::pow(10.0, config.threshold_db / 10.0);
+    }
+    
+    const ActivityGateConfig& config() const { return config_; }
+    double noise_floor() const { return noise_floor_; }
+    void reset() { noise_floor_ = 0.0; }
+    
+    // True if the frame should go on to feature extraction (always, when disabled)
+    template <typename Sample>
+    bool admit(std::span<const Sample> frame) {
+        if (!config_.enabled || frame.empty()) {
+            return true;
+        }
+        
+        // Frame energy plus the loudest short sub-window, so brief calls are not averaged away
+        size_t window = std::max<size_t>(frame.size() / SUB_WINDOWS, 1);
+        double total = 0.0, peak_window = 0.0;
+        for (size_t start = 0; start < frame.size(); start += window) {
+            size_t end = std::min(start + window, frame.size());
+            double sum = 0.0;
+            for (size_t i = start; i < end; ++i) {
+                double x = sample_value<double>(frame[i]);
+                sum += x * x;
             }
+            total += sum;
+            peak_window = std::max(peak_window, sum / (end - start));
         }
-        return static_cast<double>(crossings) / audio_data.size();
+        double energy = total / frame.size();
+        
+        if (noise_floor_ == 0.0) {
+            noise_floor_ = std::max(energy, MIN_ENERGY);
+        }
+        
+        bool active = energy > MIN_ENERGY &&
+                      peak_window > noise_floor_ * threshold_ratio_ &&
+                      AudioProcessor::compute_zero_crossing_rate(frame) <= config_.max_zero_crossing_rate;
+        
+        double rate = active ? ACTIVE_ADAPTATION : config_.adaptation;
+        if (energy < noise_floor_) {
+            rate = std::max(rate, 0.5);  // Drop to a quieter background quickly
+        }
+        noise_floor_ = std::max(noise_floor_ + rate * (energy - noise_floor_), MIN_ENERGY);
+        return active;
+    }
+};
+
+// Runtime dispatch from a recorder configuration to its compiled processor variant
+template <typename Processor, typename... Rest>
+py::object create_audio_processor(size_t sample_rate, size_t fft_size, size_t hop_size) {
+    if (Processor::SAMPLE_RATE == sample_rate &&
+        Processor::FFT_SIZE == fft_size &&
+        Processor::HOP_SIZE == hop_size) {
+        return py::cast(Processor());
+    }
+    if constexpr (sizeof...(Rest) > 0) {
+        return create_audio_processor<Rest...>(sample_rate, fft_size, hop_size);
+    } else {
+        throw py::value_error("No AudioProcessor variant for sample_rate=" + std::to_string(sample_rate) +
+                              ", fft_size=" + std::to_string(fft_size) +
+                              ", hop_size=" + std::to_string(hop_size));
     }
+}
+
+// Stateful feature extractor for audio arriving in arbitrary-sized chunks.
+// Samples are kept in a mirrored ring (each written at i and i + FFT_SIZE) so the
+// latest FFT_SIZE samples are always one contiguous view, and the HOP_SIZE overlap
+// carries across push() calls. Frames line up with compute_spectrogram on the
+// concatenated stream.
+template <typename Processor>
+class StreamingFeatureExtractorT {
+public:
+    static constexpr size_t FFT_SIZE = Processor::FFT_SIZE;
+    static constexpr size_t HOP_SIZE = Processor::HOP_SIZE;
+    static constexpr size_t NUM_FEATURES = Processor::NUM_FEATURES;
+    using Real = typename Processor::Real;
     
-    double compute_band_energy(double min_freq, double max_freq) {
-        size_t start_bin = static_cast<size_t>(min_freq * 2 * magnitude_spectrum_.size() / SAMPLE_RATE);
-        size_t end_bin = static_cast<size_t>(max_freq * 2 * magnitude_spectrum_.size() / SAMPLE_RATE);
-        
-        start_bin = std::min(start_bin, magnitude_spectrum_.size() - 1);
-        end_bin = std::min(end_bin, magnitude_spectrum_.size());
+private:
+    Processor processor_;
+    std::vector<Real> ring_;
+    size_t write_pos_ = 0;
+    size_t until_next_frame_ = FFT_SIZE;  // Samples still needed before the next frame completes
+    size_t samples_pushed_ = 0;
+    size_t frames_emitted_ = 0;
+    std::array<Real, NUM_FEATURES> frame_features_{};  // Latest frame, handed to on_frame
+    
+public:
+    StreamingFeatureExtractorT() : ring_(2 * FFT_SIZE, Real(0)) {}
+    
+    // Number of frames the next push of chunk_size samples will complete
+    size_t pending_frames(size_t chunk_size) const {
+        return chunk_size < until_next_frame_ ? 0 : 1 + (chunk_size - until_next_frame_) / HOP_SIZE;
+    }
+    
+    // Append a chunk and return features for every frame it completes (frames x NUM_FEATURES)
+    template <typename Sample>
+    py::array_t<Real> push(std::span<const Sample> chunk) {
+        size_t num_frames = pending_frames(chunk.size());
+        auto result = py::array_t<Real>({num_frames, NUM_FEATURES});
+        Real* out = result.mutable_data();
+        
+        push(chunk, [&](std::span<const Real> features) {
+            std::copy(features.begin(), features.end(), out);
+            out += NUM_FEATURES;
+        });
         
-        return std::accumulate(magnitude_spectrum_.begin() + start_bin,
-                             magnitude_spectrum_.begin() + end_bin, 0.0);
+        return result;
+    }
+    
+    // Native variant: on_frame(features) runs for each completed frame, in order, with
+    // a span valid only during the call. Touches no Python objects, so it may run with
+    // the GIL released.
+    template <typename Sample, typename OnFrame>
+    size_t push(std::span<const Sample> chunk, OnFrame&& on_frame) {
+        return push(chunk, std::forward<OnFrame>(on_frame), [](std::span<const Real>) { return true; });
+    }
+    
+    // As above, but frames for which admit(frame) is false skip feature extraction
+    template <typename Sample, typename OnFrame, typename Admit>
+    size_t push(std::span<const Sample> chunk, OnFrame&& on_frame, Admit&& admit) {
+        size_t frames = 0;
+        while (!chunk.empty()) {
+            size_t n = std::min(chunk.size(), until_next_frame_);
+            append_to_ring(chunk.first(n));
+            chunk = chunk.subspan(n);
+            until_next_frame_ -= n;
+            
+            if (until_next_frame_ == 0) {
+                if (admit(current_frame())) {
+                    processor_.extract_features(current_frame(), frame_features_.data());
+                    on_frame(std::span<const Real>(frame_features_));
+                }
+                ++frames;
+                ++frames_emitted_;
+                until_next_frame_ = HOP_SIZE;
+            }
+        }
+        return frames;
+    }
+    
+    // Start sample index (within the stream) of the next frame to be emitted
+    size_t next_frame_start() const {
+        return frames_emitted_ * HOP_SIZE;
+    }
+    
+    size_t samples_pushed() const { return samples_pushed_; }
+    size_t frames_emitted() const { return frames_emitted_; }
+    
+    void set_perf_stats(PerfStats* stats) { processor_.set_perf_stats(stats); }
+    
+    void reset() {
+        std::fill(ring_.begin(), ring_.end(), Real(0));
+        write_pos_ = 0;
+        until_next_frame_ = FFT_SIZE;
+        samples_pushed_ = 0;
+        frames_emitted_ = 0;
+    }
+
+private:
+    template <typename Sample>
+    void append_to_ring(std::span<const Sample> samples) {
+        for (Sample sample : samples) {
+            Real value = sample_value<Real>(sample);
+            ring_[write_pos_] = value;
+            ring_[write_pos_ + FFT_SIZE] = value;
+            write_pos_ = (write_pos_ + 1) & (FFT_SIZE - 1);
+        }
+        samples_pushed_ += samples.size();
+    }
+    
+    // Oldest buffered sample sits at write_pos_; its mirror keeps the frame contiguous
+    std::span<const Real> current_frame() const {
+        return std::span<const Real>(ring_.data() + write_pos_, FFT_SIZE);
     }
 };
 
-// Lightweight ML inference engine for species classification
-class WildlifeClassifier {
+using StreamingFeatureExtractor = StreamingFeatureExtractorT<AudioProcessor>;
+using StreamingFeatureExtractorF32 = StreamingFeatureExtractorT<AudioProcessorF32>;
+
+// Lightweight ML inference engine for species classification, in double or
+// float (float32 pipeline) precision
+template <typename Precision = double>
+class WildlifeClassifierT {
+public:
+    using Real = Precision;
+    
+    // Network shape is fixed at compile time: 8 features -> 16 hidden -> 12 species
+    static constexpr size_t INPUT_DIM = 8;
+    static constexpr size_t HIDDEN_DIM = 16;
+    static constexpr size_t OUTPUT_DIM = 12;
+    static constexpr double DEFAULT_UNKNOWN_THRESHOLD = 0.3;
+    static constexpr size_t BATCH_BLOCK = 64; // Rows per block; activations stay in L1
+    
+    using FeatureVector = std::span<const Real, INPUT_DIM>;
+    using FeatureMatrix = FeatureMatrixT<Real, INPUT_DIM>;
+    using Probabilities = std::array<Real, OUTPUT_DIM>;
+    
+    // Destinations for one batched forward pass; null outputs are skipped. Rows of
+    // probabilities are in output unit order (unit o is species output_species(o)).
+    struct BatchOutputs {
+        int* species_ids = nullptr;     // (rows) best species, Unknown below the threshold
+        Real* confidences = nullptr;    // (rows) best unit's probability
+        Real* probabilities = nullptr;  // (rows x OUTPUT_DIM)
+        size_t top_k = 0;               // At most OUTPUT_DIM
+        int* top_species = nullptr;     // (rows x top_k) species ids, most probable first
+        Real* top_scores = nullptr;     // (rows x top_k) their probabilities
+    };
+    
 private:
-    std::unordered_map<AustralianSpecies, SpeciesProfile> species_database_;
-    std::vector<std::vector<double>> model_weights_; // Simple neural network weights
+    // Contiguous, cache-line aligned weights laid out [input][unit] so the
+    // inner loop over units is unit-stride (same layout as a model file)
+    struct alignas(64) ModelWeights {
+        std::array<Real, INPUT_DIM * HIDDEN_DIM> hidden;
+        std::array<Real, HIDDEN_DIM * OUTPUT_DIM> output;
+        std::array<uint8_t, OUTPUT_DIM> species_map;
+    };
+    
+    // Simple neural network weights, either owned or mapped from a model file.
+    // Copies share the storage, which is never written after construction.
+    std::shared_ptr<const void> model_storage_;
+    const Real* hidden_weights_ = nullptr;
+    const Real* output_weights_ = nullptr;
+    const uint8_t* species_map_ = nullptr;  // Output unit -> AustralianSpecies id
+    std::atomic<double> unknown_threshold_{DEFAULT_UNKNOWN_THRESHOLD};  // Settable while inference runs
     
 public:
-    WildlifeClassifier() {
-        initialize_species_database();
+    WildlifeClassifierT() {
         initialize_classifier_model();
     }
     
+    // Use a trained model file. Weights stored in this precision are mapped in
+    // place; the other precision is converted into owned storage once.
+    explicit WildlifeClassifierT(const std::string& model_path) {
+        load_model(model_path);
+    }
+    
+    // Export the current weights in the model file format (dtype follows Real)
+    void save_model(const std::string& path) const {
+        write_model_file(path, INPUT_DIM, HIDDEN_DIM, OUTPUT_DIM,
+                         species_map_, hidden_weights_, output_weights_);
+    }
+    
     // Classify audio features
-    AustralianSpecies classify_audio_features(const std::vector<double>& features) {
+    AustralianSpecies classify_audio_features(std::span<const Real> features) const {
         
-        if (features.size() != 8) {
+        if (features.size() != INPUT_DIM) {
             return AustralianSpecies::Unknown;
         }
         
-        // Simple neural network inference (1 hidden layer)
-        std::vector<double> hidden_layer = compute_hidden_layer(features);
-        std::vector<double> output_layer = compute_output_layer(hidden_layer);
-        
-        // Find species with highest probability
-        auto max_iter = std::max_element(output_layer.begin(), output_layer.end());
-        size_t predicted_class = std::distance(output_layer.begin(), max_iter);
-        
-        double confidence = *max_iter;
-        
-        if (confidence < 0.3) {
-            return AustralianSpecies::Unknown;
+        return classify_audio_features(FeatureVector(features.data(), INPUT_DIM));
+    }
+    
+    // Fixed-size inference path: all scratch lives on the stack
+    AustralianSpecies classify_audio_features(FeatureVector features) const {
+        double confidence;
+        return classify_audio_features(features, confidence);
+    }
+    
+    // Same, also reporting the winning class probability
+    AustralianSpecies classify_audio_features(FeatureVector features, double& confidence) const {
+        Probabilities output_layer;
+        predict_probabilities(features, output_layer);
+        return species_from_probabilities(output_layer.data(), unknown_threshold(), &confidence);
+    }
+    
+    // Simple neural network inference (1 hidden layer) into caller-owned storage
+    void predict_probabilities(FeatureVector features, Probabilities& output) const {
+        std::array<Real, HIDDEN_DIM> hidden;
+        compute_hidden_layer(features, hidden);
+        compute_output_layer(hidden, output);
+    }
+    
+    // Get species information from the shared registry; null when the species has no profile
+    const SpeciesProfile* get_species_info(AustralianSpecies species) const {
+        return has_species_profile(species) ? &species_profile(species) : nullptr;
+    }
+    
+    // Species id of an output unit (a probability column)
+    AustralianSpecies output_species(size_t unit) const {
+        return static_cast<AustralianSpecies>(species_map_[unit]);
+    }
+    
+    // Minimum winning probability for a named species; below it classifications are
+    // Unknown. May change while inference runs on other threads: each classify call
+    // reads it once, so every row of one call sees the same threshold.
+    double unknown_threshold() const { return unknown_threshold_.load(std::memory_order_relaxed); }
+    
+    void set_unknown_threshold(double threshold) {
+        // NaN is caught on the bits: the module's -ffast-math folds comparisons with it away
+        bool is_nan = (std::bit_cast<uint64_t>(threshold) & ~(uint64_t{1} << 63)) > 0x7FF0000000000000;
+        if (is_nan || !(threshold >= 0.0 && threshold <= 1.0)) {
+            throw std::invalid_argument("Unknown threshold must be in [0, 1]");
         }
-        
-        return static_cast<AustralianSpecies>(predicted_class + 1);
+        unknown_threshold_.store(threshold, std::memory_order_relaxed);
     }
     
-    // Get species information
-    std::optional<SpeciesProfile> get_species_info(AustralianSpecies species) const {
-        auto it = species_database_.find(species);
-        return it != species_database_.end() ? 
-               std::make_optional(it->second) : 
-               std::nullopt;
+    // Batched classification of a row-major (num_rows x INPUT_DIM) feature matrix
+    void classify_batch(const Real* features, size_t num_rows, int* species_ids) const {
+        BatchOutputs outputs;
+        outputs.species_ids = species_ids;
+        classify_batch(features, num_rows, outputs);
     }
     
-    // Batch processing for performance testing
-    std::vector<AustralianSpecies> classify_batch(const std::vector<std::vector<double>>& feature_batch) {
-        std::vector<AustralianSpecies> results;
-        results.reserve(feature_batch.size());
-        
-        // Process each feature vector
-        for (const auto& features : feature_batch) {
-            results.push_back(classify_audio_features(features));
+    // Every requested output from the same forward pass, block by block.
+    // Probabilities are written straight into outputs.probabilities when given.
+    void classify_batch(const Real* features, size_t num_rows, const BatchOutputs& outputs) const {
+        classify_blocks(num_rows, outputs, [&](size_t start, size_t, Real*) -> const Real* {
+            return features + start * INPUT_DIM;
+        });
+    }
+    
+    // Same, reading a columnar feature matrix in place: each block's rows are
+    // gathered from the columns into an L1-resident row-major tile
+    void classify_batch(typename FeatureMatrix::View features, const BatchOutputs& outputs) const {
+        classify_blocks(features.rows, outputs, [&](size_t start, size_t rows, Real* tile) -> const Real* {
+            for (size_t i = 0; i < INPUT_DIM; ++i) {
+                const Real* column = features.data + i * features.stride + start;
+                for (size_t r = 0; r < rows; ++r) {
+                    tile[r * INPUT_DIM + i] = column[r];
+                }
+            }
+            return tile;
+        });
+    }
+    
+    // Batched forward pass writing a row-major (num_rows x OUTPUT_DIM) probability matrix
+    void predict_probabilities_batch(const Real* features, size_t num_rows, Real* probabilities) const {
+        for (size_t start = 0; start < num_rows; start += BATCH_BLOCK) {
+            size_t rows = std::min(BATCH_BLOCK, num_rows - start);
+            predict_probabilities_block(features + start * INPUT_DIM, rows,
+                                        probabilities + start * OUTPUT_DIM);
         }
-        
-        return results;
     }
 
 private:
-    void initialize_species_database() {
-        // Australian wildlife with realistic call characteristics
-        species_database_ = {
-            {AustralianSpecies::Kookaburra, {
-                AustralianSpecies::Kookaburra,
-                "Laughing Kookaburra",
-                "Dacelo novaeguineae", 
-                200.0, 2000.0, 3.0, 0.8,
-                {0.1, 0.3, 0.8, 0.4, 0.2, 0.1, 0.05, 0.02}
-            }},
-            {AustralianSpecies::Magpie, {
-                AustralianSpecies::Magpie,
-                "Australian Magpie",
-                "Gymnorhina tibicen",
-                400.0, 4000.0, 2.5, 0.9,
-                {0.05, 0.2, 0.6, 0.7, 0.3, 0.15, 0.08, 0.03}
-            }},
-            {AustralianSpecies::Galah, {
-                AustralianSpecies::Galah,
-                "Galah",
-                "Eolophus roseicapilla",
-                800.0, 3500.0, 1.5, 0.7,
-                {0.02, 0.1, 0.4, 0.8, 0.5, 0.2, 0.1, 0.05}
-            }},
-            {AustralianSpecies::Koala, {
-                AustralianSpecies::Koala,
-                "Koala",
-                "Phascolarctos cinereus",
-                100.0, 1200.0, 4.0, 1.0,
-                {0.3, 0.5, 0.2, 0.1, 0.05, 0.02, 0.01, 0.005}
-            }},
-            {AustralianSpecies::Dingo, {
-                AustralianSpecies::Dingo,
-                "Dingo",
-                "Canis dingo",
-                150.0, 1500.0, 2.0, 0.95,
-                {0.2, 0.4, 0.3, 0.15, 0.08, 0.04, 0.02, 0.01}
-            }}
-        };
+    // classify_batch body; load_block(start, rows, tile) returns the block's row-major
+    // (rows x INPUT_DIM) features, either in place or gathered into tile
+    template <typename LoadBlock>
+    void classify_blocks(size_t num_rows, const BatchOutputs& outputs, LoadBlock&& load_block) const {
+        if (outputs.top_k > OUTPUT_DIM) {
+            throw std::invalid_argument("top_k must be at most " + std::to_string(OUTPUT_DIM));
+        }
+        alignas(64) std::array<Real, BATCH_BLOCK * OUTPUT_DIM> scratch;
+        alignas(64) std::array<Real, BATCH_BLOCK * INPUT_DIM> tile;
+        double threshold = unknown_threshold();  // One threshold for every row of the call
+        
+        for (size_t start = 0; start < num_rows; start += BATCH_BLOCK) {
+            size_t rows = std::min(BATCH_BLOCK, num_rows - start);
+            Real* probabilities = outputs.probabilities ? outputs.probabilities + start * OUTPUT_DIM
+                                                        : scratch.data();
+            predict_probabilities_block(load_block(start, rows, tile.data()), rows, probabilities);
+            
+            for (size_t r = 0; r < rows; ++r) {
+                const Real* row = probabilities + r * OUTPUT_DIM;
+                size_t index = start + r;
+                if (outputs.species_ids || outputs.confidences) {
+                    double confidence;
+                    auto species = species_from_probabilities(row, threshold, &confidence);
+                    if (outputs.species_ids) {
+                        outputs.species_ids[index] = static_cast<int>(species);
+                    }
+                    if (outputs.confidences) {
+                        outputs.confidences[index] = static_cast<Real>(confidence);
+                    }
+                }
+                if (outputs.top_k != 0) {
+                    write_top_k(row, outputs.top_k, outputs.top_species + index * outputs.top_k,
+                                outputs.top_scores + index * outputs.top_k);
+                }
+            }
+        }
     }
     
     void initialize_classifier_model() {
         // Simple neural network: 8 inputs -> 16 hidden -> 12 outputs (species)
-        // In production, load from trained model file
-        
-        // Hidden layer weights (8x16)
-        model_weights_.resize(2);
-        model_weights_[0].resize(8 * 16);
-        model_weights_[1].resize(16 * 12);
+        // Untrained fallback; deployments pass a model file instead
+        auto weights = std::make_shared<ModelWeights>();
         
         // Initialize with small random values
         std::random_device rd;
         std::mt19937 gen(rd());
-        std::normal_distribution<double> dist(0.0, 0.1);
+        std::normal_distribution<Real> dist(0.0, 0.1);
         
-        for (auto& weight : model_weights_[0]) {
+        for (auto& weight : weights->hidden) {
             weight = dist(gen);
         }
-        for (auto& weight : model_weights_[1]) {
+        for (auto& weight : weights->output) {
             weight = dist(gen);
         }
+        // Units map to species ids 1..11 in order; the spare twelfth unit reads as Unknown
+        constexpr auto last_species = static_cast<uint8_t>(AustralianSpecies::FruitBat);
+        for (size_t o = 0; o < OUTPUT_DIM; ++o) {
+            weights->species_map[o] = o < last_species ? static_cast<uint8_t>(o + 1) : 0;
+        }
+        
+        hidden_weights_ = weights->hidden.data();
+        output_weights_ = weights->output.data();
+        species_map_ = weights->species_map.data();
+        model_storage_ = std::move(weights);
+    }
+    
+    void load_model(const std::string& path) {
+        auto file = std::make_shared<const MappedModelFile>(path);
+        const ModelFileHeader& header = file->header();
+        
+        if (header.input_dim != INPUT_DIM || header.hidden_dim != HIDDEN_DIM || header.output_dim != OUTPUT_DIM) {
+            throw std::runtime_error("Model " + path + " has layer sizes " +
+                                     std::to_string(header.input_dim) + "x" +
+                                     std::to_string(header.hidden_dim) + "x" +
+                                     std::to_string(header.output_dim) + ", expected " +
+                                     std::to_string(INPUT_DIM) + "x" + std::to_string(HIDDEN_DIM) +
+                                     "x" + std::to_string(OUTPUT_DIM));
+        }
+        
+        for (size_t o = 0; o < OUTPUT_DIM; ++o) {
+            if (file->species_map()[o] > static_cast<uint8_t>(AustralianSpecies::FruitBat)) {
+                throw std::runtime_error("Model " + path + " maps output " + std::to_string(o) +
+                                         " to unknown species id " + std::to_string(file->species_map()[o]));
+            }
+        }
+        
+        if (header.dtype == model_dtype<Real>()) {
+            hidden_weights_ = file->template hidden_weights<Real>();
+            output_weights_ = file->template output_weights<Real>();
+            species_map_ = file->species_map();
+            model_storage_ = std::move(file);
+            return;
+        }
+        
+        // Stored in the other precision: convert once, then drop the mapping
+        auto weights = std::make_shared<ModelWeights>();
+        auto convert = [&](const auto* hidden, const auto* output) {
+            std::copy(hidden, hidden + weights->hidden.size(), weights->hidden.begin());
+            std::copy(output, output + weights->output.size(), weights->output.begin());
+        };
+        if (header.dtype == ModelFileHeader::DTYPE_FLOAT64) {
+            convert(file->template hidden_weights<double>(), file->template output_weights<double>());
+        } else {
+            convert(file->template hidden_weights<float>(), file->template output_weights<float>());
+        }
+        std::copy(file->species_map(), file->species_map() + OUTPUT_DIM, weights->species_map.begin());
+        
+        hidden_weights_ = weights->hidden.data();
+        output_weights_ = weights->output.data();
+        species_map_ = weights->species_map.data();
+        model_storage_ = std::move(weights);
     }
     
-    std::vector<double> compute_hidden_layer(const std::vector<double>& features) {
-        std::vector<double> hidden(16, 0.0);
+    void compute_hidden_layer(FeatureVector features, std::array<Real, HIDDEN_DIM>& hidden) const {
+        hidden.fill(0);
         
-        for (size_t h = 0; h < 16; ++h) {
-            for (size_t i = 0; i < 8; ++i) {
-                hidden[h] += features[i] * model_weights_[0][i * 16 + h];
+        for (size_t i = 0; i < INPUT_DIM; ++i) {
+            const Real* row = &hidden_weights_[i * HIDDEN_DIM];
+            for (size_t h = 0; h < HIDDEN_DIM; ++h) {
+                hidden[h] += features[i] * row[h];
             }
-            hidden[h] = std::tanh(hidden[h]); // Activation function
         }
         
-        return hidden;
+        for (auto& x : hidden) {
+            x = std::tanh(x); // Activation function
+        }
     }
     
-    std::vector<double> compute_output_layer(const std::vector<double>& hidden) {
-        std::vector<double> output(12, 0.0);
+    void compute_output_layer(const std::array<Real, HIDDEN_DIM>& hidden, Probabilities& output) const {
+        output.fill(0);
         
-        for (size_t o = 0; o < 12; ++o) {
-            for (size_t h = 0; h < 16; ++h) {
-                output[o] += hidden[h] * model_weights_[1][h * 12 + o];
+        for (size_t h = 0; h < HIDDEN_DIM; ++h) {
+            const Real* row = &output_weights_[h * OUTPUT_DIM];
+            for (size_t o = 0; o < OUTPUT_DIM; ++o) {
+                output[o] += hidden[h] * row[o];
             }
         }
         
         // Softmax activation
-        double max_val = *std::max_element(output.begin(), output.end());
+        Real max_val = *std::max_element(output.begin(), output.end());
         for (auto& x : output) {
             x = std::exp(x - max_val);
         }
         
-        double sum = std::accumulate(output.begin(), output.end(), 0.0);
+        Real sum = std::accumulate(output.begin(), output.end(), Real(0));
         for (auto& x : output) {
             x = x / sum;
         }
+    }
+    
+    // Highest-probability species, or Unknown below threshold
+    AustralianSpecies species_from_probabilities(const Real* probabilities, double threshold,
+                                                 double* confidence_out = nullptr) const {
+        const Real* max_iter = std::max_element(probabilities, probabilities + OUTPUT_DIM);
+        size_t predicted_class = std::distance(probabilities, max_iter);
+        
+        double confidence = *max_iter;
+        if (confidence_out) {
+            *confidence_out = confidence;
+        }
+        
+        if (confidence < threshold) {
+            return AustralianSpecies::Unknown;
+        }
+        
+        return static_cast<AustralianSpecies>(species_map_[predicted_class]);
+    }
+    
+    // The k most probable units of one row as (species id, probability), best first;
+    // either destination may be null
+    void write_top_k(const Real* probabilities, size_t k, int* species, Real* scores) const {
+        std::array<uint8_t, OUTPUT_DIM> units;
+        std::iota(units.begin(), units.end(), uint8_t(0));
+        std::partial_sort(units.begin(), units.begin() + k, units.end(), [&](uint8_t a, uint8_t b) {
+            return probabilities[a] > probabilities[b] || (probabilities[a] == probabilities[b] && a < b);
+        });
+        for (size_t i = 0; i < k; ++i) {
+            if (species) {
+                species[i] = species_map_[units[i]];
+            }
+            if (scores) {
+                scores[i] = probabilities[units[i]];
+            }
+        }
+    }
+    
+    // Forward pass for up to BATCH_BLOCK rows as two small matrix-matrix products.
+    // Activations run over whole contiguous blocks, which lets -ffast-math
+    // vectorize tanh and exp (libmvec on glibc).
+    BUSH_EARS_MULTIVERSION
+    void predict_probabilities_block(const Real* x, size_t rows, Real* out) const {
+        alignas(64) std::array<Real, BATCH_BLOCK * HIDDEN_DIM> hidden;
+        
+        // hidden = tanh(X * W1)
+        for (size_t r = 0; r < rows; ++r) {
+            Real* h_row = &hidden[r * HIDDEN_DIM];
+            std::fill(h_row, h_row + HIDDEN_DIM, Real(0));
+            for (size_t i = 0; i < INPUT_DIM; ++i) {
+                const Real xi = x[r * INPUT_DIM + i];
+                const Real* w_row = &hidden_weights_[i * HIDDEN_DIM];
+                for (size_t h = 0; h < HIDDEN_DIM; ++h) {
+                    h_row[h] += xi * w_row[h];
+                }
+            }
+        }
+        for (size_t i = 0; i < rows * HIDDEN_DIM; ++i) {
+            hidden[i] = std::tanh(hidden[i]);
+        }
         
-        return output;
+        // logits = hidden * W2, then a row-wise softmax
+        for (size_t r = 0; r < rows; ++r) {
+            Real* o_row = out + r * OUTPUT_DIM;
+            std::fill(o_row, o_row + OUTPUT_DIM, Real(0));
+            for (size_t h = 0; h < HIDDEN_DIM; ++h) {
+                const Real hv = hidden[r * HIDDEN_DIM + h];
+                const Real* w_row = &output_weights_[h * OUTPUT_DIM];
+                for (size_t o = 0; o < OUTPUT_DIM; ++o) {
+                    o_row[o] += hv * w_row[o];
+                }
+            }
+            Real max_val = *std::max_element(o_row, o_row + OUTPUT_DIM);
+            for (size_t o = 0; o < OUTPUT_DIM; ++o) {
+                o_row[o] -= max_val;
+            }
+        }
+        for (size_t i = 0; i < rows * OUTPUT_DIM; ++i) {
+            out[i] = std::exp(out[i]);
+        }
+        for (size_t r = 0; r < rows; ++r) {
+            Real* o_row = out + r * OUTPUT_DIM;
+            Real sum = std::accumulate(o_row, o_row + OUTPUT_DIM, Real(0));
+            for (size_t o = 0; o < OUTPUT_DIM; ++o) {
+                o_row[o] /= sum;
+            }
+        }
     }
 };
 
-// Real-time ecosystem monitoring system
-class EcosystemMonitor {
+using WildlifeClassifier = WildlifeClassifierT<double>;
+using WildlifeClassifierF32 = WildlifeClassifierT<float>;
+
+// Outcome of one recording in an archive scan
+struct FileScanSummary {
+    std::string path;
+    std::string error;  // Empty unless the file could not be read
+    uint32_t sample_rate = 0;
+    uint32_t channels = 0;
+    double duration_seconds = 0.0;
+    size_t frames_analyzed = 0;  // Summed over channels
+    size_t detections = 0;
+    std::array<size_t, NUM_SPECIES> species_counts{};
+};
+
+// Real-time ecosystem monitoring system; Precision selects the float64 or float32 pipeline
+template <typename Precision = double>
+class EcosystemMonitorT {
+public:
+    using Real = Precision;
+    using Processor = AudioProcessorT<44100, 1024, 512, Real>;
+    using Classifier = WildlifeClassifierT<Real>;
+    using FeatureMatrix = typename Classifier::FeatureMatrix;
+    using Extractor = StreamingFeatureExtractorT<Processor>;
+    
 private:
-    AudioProcessor processor_;
-    WildlifeClassifier classifier_;
+    Processor processor_;
+    Classifier classifier_;
+    
+    // Serialises the batch entry points (classify_audio_batch, scan_archive) over the
+    // worker scratch and the batch arena, from reset() until the last span is read;
+    // taken before state_mutex_ when both are needed
+    std::mutex batch_mutex_;
+    std::vector<Processor> worker_processors_; // Scratch per shared-pool worker or scan scorer
+    BatchArena batch_arena_;                   // Feature matrix of classify_audio_batch, reused per call
+    
+    // Detections published for bulk draining from Python
+    static constexpr size_t DETECTION_QUEUE_CAPACITY = 4096;
+    DetectionQueue detections_{DETECTION_QUEUE_CAPACITY};
     
-    // Ecosystem health metrics
+    PerfStats perf_;  // Stage latencies of every processor and stream owned by this monitor
+    
+    static constexpr size_t FILE_BLOCK_FRAMES = 65536;  // process_file read size per channel
+    
+    // Lifetime ecosystem health metrics. Counts are dense by species id and the running
+    // sums let every detection update the indices in O(1):
+    //   H = log(N) - sum(c * log c) / N,  conservation = sum(c * w) / N
     struct EcosystemMetrics {
-        std::unordered_map<AustralianSpecies, size_t> species_counts;
+        std::array<size_t, NUM_SPECIES> species_counts;
+        double count_log_count_sum;  // sum(c * log c) over species
+        double conservation_sum;     // sum(c * conservation_weight) over species
         double biodiversity_index;
         double conservation_score;
-        std::chrono::time_point<std::chrono::steady_clock> last_update;
+        std::chrono::time_point<std::chrono::steady_clock> started;
+        std::chrono::time_point<std::chrono::steady_clock> last_detection;  // Epoch until the first
         size_t total_detections;
+        size_t frames_analyzed;
+        size_t frames_skipped;      // Rejected by the activity gate
     };
     
     EcosystemMetrics metrics_;
+    SlidingWindowMetrics window_;  // The same counts bucketed by wall-clock time of ingestion
+    
+    // One sensor channel: its own streaming window, event segmenter and a metrics
+    // shard. Workers only write the shards of the channels they process; the
+    // calling thread folds them into metrics_ once the batch has finished.
+    struct alignas(64) ChannelState {
+        Extractor extractor;
+        ActivityGate gate;
+        EventSegmenter segmenter;
+        std::vector<Real> deinterleaved;                   // Scratch for interleaved input
+        std::array<size_t, NUM_SPECIES> pending_counts{};  // Detections not yet merged
+        size_t pending_frames = 0;     // Completed frames not yet merged
+        size_t pending_analyzed = 0;   // Of those, frames the gate admitted
+        size_t total_detections = 0;
+    };
+    
+    std::vector<std::unique_ptr<ChannelState>> channels_;
+    ActivityGate gate_;  // Single-stream path; channels copy its configuration
+    
+    // Single-stream path: one segmenter per ingest_audio channel id, clocked by the
+    // samples that channel has seen
+    struct SegmentStream {
+        EventSegmenter segmenter;
+        size_t samples = 0;
+    };
+    EventSegmenterConfig segmenter_config_;
+    std::unordered_map<uint32_t, SegmentStream> segment_streams_;
+    
+    static constexpr double FRAME_SECONDS = static_cast<double>(Processor::FFT_SIZE) / Processor::SAMPLE_RATE;
     
 public:
-    EcosystemMonitor() : metrics_{} {
-        metrics_.last_update = std::chrono::steady_clock::now();
-    }
+    // Outcome of one single-stream chunk, from process_audio_stream or submit()
+    struct StreamResult {
+        AustralianSpecies species = AustralianSpecies::Unknown;
+        bool skipped = false;           // Rejected by the activity gate
+        std::array<Real, Classifier::INPUT_DIM> features{};  // Set when the chunk was analysed
+        SegmentedEvent event;           // species Unknown unless a call ended with this chunk
+        std::string error;              // Set when the chunk could not be analysed
+        double ecosystem_health = 0.0;  // Metrics as of this chunk
+        double biodiversity_index = 0.0;
+        size_t total_detections = 0;
+    };
     
-    // Process real-time audio stream
-    py::dict process_audio_stream(py::array_t<double> audio_chunk) {
-        auto buf = audio_chunk.request();
-        std::vector<double> audio_data(static_cast<double*>(buf.ptr), 
-                                      static_cast<double*>(buf.ptr) + buf.shape[0]);
-        
+    using SubmitCallback = std::function<void(StreamResult&)>;
+    
+    struct SubmitConfig {
+        size_t max_batch = 64;
+        size_t max_pending = 4096;
+        std::chrono::microseconds max_wait{0};
+    };
+    
+private:
+    // submit(): chunks are copied at working precision and analysed by the batcher's
+    // thread, which runs everything queued in one batched pass
+    struct StreamSubmission {
+        std::vector<Real> samples;
+        uint32_t channel = 0;
+        PerfStamp submitted;
+        SubmitCallback done;
+    };
+    
+    // Serialises the submission thread with calling threads over the single-stream
+    // state, the metrics and the configuration. Never held while calling back into Python.
+    std::mutex state_mutex_;
+    std::vector<Processor> dispatch_processors_;  // Scratch per shared-pool worker, submission batches only
+    BatchArena dispatch_arena_;                   // Per-batch buffers of the submission thread, under state_mutex_
+    std::vector<StreamResult> dispatch_results_;
+    
+    std::mutex submit_mutex_;  // Guards batcher_ and submit_config_
+    SubmitConfig submit_config_;
+    std::shared_ptr<MicroBatcher<StreamSubmission>> batcher_;  // Started by the first submit()
+    std::atomic<bool> stopping_submissions_{false};   // Draining batcher_ under submit_mutex_
+    std::atomic<std::thread::id> dispatch_thread_{};  // Thread of the current batcher
+    
+public:
+    EcosystemMonitorT() : metrics_{} {
+        metrics_.started = std::chrono::steady_clock::now();
+        processor_.set_perf_stats(&perf_);
+    }
+    
+    explicit EcosystemMonitorT(const std::string& model_path) : classifier_(model_path), metrics_{} {
+        metrics_.started = std::chrono::steady_clock::now();
+        processor_.set_perf_stats(&perf_);
+    }
+    
+    // Submitted chunks still queued are analysed and their callbacks run first
+    ~EcosystemMonitorT() { stop_submissions(); }
+    
+    // Process real-time audio stream
+    template <typename Sample>
+    py::dict process_audio_stream(std::span<const Sample> audio_data) {
+        StreamResult result;
+        {
+            // The submission thread holds state_mutex_ across a whole batch, so wait for
+            // it without the GIL
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            try {
+                ingest_segment(audio_data, 0, result);
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+            snapshot_metrics(result);
+        }
+        return stream_result_dict(result);
+    }
+    
+    // The process_audio_stream dict for a result
+    static py::dict stream_result_dict(const StreamResult& stream_result) {
         py::dict result;
         
-        try {
-            // Extract features
-            auto features = processor_.extract_features(audio_data);
+        if (stream_result.error.empty()) {
+            result["skipped"] = stream_result.skipped;
             
-            // Classify species
-            auto species = classifier_.classify_audio_features(features);
+            // A call that ended with this chunk, merged over all its chunks
+            const SegmentedEvent& event = stream_result.event;
+            if (event.species != AustralianSpecies::Unknown) {
+                py::dict event_info;
+                event_info["species_id"] = static_cast<int>(event.species);
+                event_info["start"] = event.start;
+                event_info["end"] = event.end;
+                event_info["peak_confidence"] = event.peak_confidence;
+                event_info["chunks"] = event.frames;
+                result["event"] = event_info;
+            }
             
+            AustralianSpecies species = stream_result.species;
             if (species != AustralianSpecies::Unknown) {
-                // Update ecosystem metrics
-                update_ecosystem_metrics(species);
-                
                 // Get species information
-                if (auto species_info = classifier_.get_species_info(species)) {
+                if (has_species_profile(species)) {
+                    const SpeciesProfile& species_info = species_profile(species);
                     result["species_detected"] = true;
                     result["species_id"] = static_cast<int>(species);
-                    result["common_name"] = species_info->common_name;
-                    result["scientific_name"] = species_info->scientific_name;
-                    result["conservation_weight"] = species_info->conservation_weight;
+                    result["common_name"] = species_info.common_name;
+                    result["scientific_name"] = species_info.scientific_name;
+                    result["conservation_weight"] = species_info.conservation_weight;
                 }
             } else {
                 result["species_detected"] = false;
@@ -441,108 +1238,1179 @@ public:
             
             // Add audio features for visualization
             py::list feature_list;
-            for (double feature : features) {
-                feature_list.append(feature);
+            if (!stream_result.skipped) {
+                for (Real feature : stream_result.features) {
+                    feature_list.append(feature);
+                }
             }
             result["audio_features"] = feature_list;
-            
-        } catch (const std::exception& e) {
-            result["error"] = e.what();
+        } else {
+            result["error"] = stream_result.error;
             result["species_detected"] = false;
         }
         
         // Add current ecosystem metrics
-        result["ecosystem_health"] = get_ecosystem_health_score();
-        result["biodiversity_index"] = metrics_.biodiversity_index;
-        result["total_detections"] = metrics_.total_detections;
+        result["ecosystem_health"] = stream_result.ecosystem_health;
+        result["biodiversity_index"] = stream_result.biodiversity_index;
+        result["total_detections"] = stream_result.total_detections;
         
         return result;
     }
     
-    // Batch processing for performance comparison
-    std::vector<int> classify_audio_batch(const std::vector<std::vector<double>>& audio_segments) {
-        std::vector<std::vector<double>> all_features;
-        all_features.reserve(audio_segments.size());
-        
-        // Extract features for all segments
-        for (const auto& segment : audio_segments) {
-            try {
-                auto features = processor_.extract_features(segment);
-                all_features.push_back(features);
-            } catch (const std::exception&) {
-                all_features.push_back(std::vector<double>(8, 0.0));
+    // Non-blocking process_audio_stream: queue the chunk on channel's stream (0 is the
+    // process_audio_stream stream) and return at once. A native thread analyses
+    // whatever has queued up, across all channels, in one batched pass and then calls
+    // done(result) from that thread with the GIL held, in submission order; done must
+    // not throw. Returns false, leaving done uncalled, when max_pending chunks are
+    // already waiting, or when done of an earlier chunk submits while
+    // configure_submissions is draining the queue. Call with the GIL released: a
+    // concurrent configure_submissions holds the submit lock until callbacks finish.
+    template <typename Sample>
+    bool submit(std::span<const Sample> audio_data, uint32_t channel, SubmitCallback done) {
+        StreamSubmission submission;
+        submission.samples.resize(audio_data.size());
+        std::transform(audio_data.begin(), audio_data.end(), submission.samples.begin(),
+                       [](Sample sample) { return sample_value<Real>(sample); });
+        submission.channel = channel;
+        submission.submitted = PerfStamp::now();
+        submission.done = std::move(done);
+        
+        std::unique_lock<std::mutex> lock(submit_mutex_, std::defer_lock);
+        if (std::this_thread::get_id() == dispatch_thread_.load(std::memory_order_relaxed)) {
+            // From a callback: configure_submissions may hold the lock while it waits for this thread
+            while (!lock.try_lock()) {
+                if (stopping_submissions_.load()) {
+                    return false;
+                }
+                std::this_thread::yield();
             }
+        } else {
+            lock.lock();
+        }
+        if (!batcher_) {
+            batcher_ = std::make_shared<MicroBatcher<StreamSubmission>>(
+                submit_config_.max_batch, submit_config_.max_pending, submit_config_.max_wait,
+                [this](std::vector<StreamSubmission>& batch) { process_submissions(batch); });
+        }
+        return batcher_->try_submit(submission);
+    }
+    
+    // Batching limits for submit(); chunks already queued finish under the old ones.
+    // The old batcher drains and the limits change in one critical section, so no
+    // concurrent submit() can start a batcher with the old limits in between.
+    void configure_submissions(const SubmitConfig& config) {
+        if (config.max_batch == 0 || config.max_pending == 0) {
+            throw std::invalid_argument("max_batch and max_pending must be at least 1");
+        }
+        std::lock_guard<std::mutex> lock(submit_mutex_);
+        drain_batcher();
+        submit_config_ = config;
+    }
+    
+    SubmitConfig submit_config() {
+        std::lock_guard<std::mutex> lock(submit_mutex_);
+        return submit_config_;
+    }
+    
+    // Submitted chunks whose callbacks have not finished
+    size_t pending_submissions() {
+        auto batcher = current_batcher();
+        return batcher ? batcher->pending() : 0;
+    }
+    
+    // Block until every chunk submitted so far has been called back. Callbacks take
+    // the GIL on the submission thread, so call this (and configure_submissions, and
+    // the destructor) with the GIL released.
+    void wait_submissions() {
+        if (auto batcher = current_batcher()) {
+            batcher->wait_idle();
+        }
+    }
+    
+    // Dict-free variant of process_audio_stream for high stream counts: detections
+    // only reach Python through drain_detections(). Returns the species id.
+    template <typename Sample>
+    int ingest_audio(std::span<const Sample> audio_data, uint32_t channel) {
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        StreamResult result;
+        ingest_segment(audio_data, channel, result);
+        return static_cast<int>(result.species);
+    }
+    
+    // Move up to max_events queued detections (0 = all) into a structured array
+    py::array_t<DetectionEvent> drain_detections(size_t max_events = 0) {
+        size_t available = detections_.size();
+        if (max_events != 0) {
+            available = std::min(available, max_events);
         }
         
-        // Classify all at once
-        auto species_results = classifier_.classify_batch(all_features);
-        
-        // Convert to int for Python
-        std::vector<int> int_results;
-        int_results.reserve(species_results.size());
-        for (AustralianSpecies s : species_results) {
-            int_results.push_back(static_cast<int>(s));
+        py::array_t<DetectionEvent> events(available);
+        size_t drained = detections_.drain(events.mutable_data(), available);
+        if (drained == available) {
+            return events;
+        }
+        // A producer had claimed a slot without publishing it yet
+        return py::array_t<DetectionEvent>(drained, events.data());
+    }
+    
+    size_t dropped_detections() const { return detections_.dropped(); }
+    
+    // Batch processing on the shared work-stealing pool. Each worker extracts
+    // features with its own AudioProcessor into its rows of one columnar matrix,
+    // which the classifier then reads in place; rows keep the input order. The
+    // matrix is arena scratch unless features_out is given, in which case it is
+    // allocated there for the caller (segments too short to analyse stay zero).
+    template <typename Sample>
+    py::array_t<int> classify_audio_batch(std::span<const std::span<const Sample>> audio_segments,
+                                          FeatureMatrix* features_out = nullptr) {
+        constexpr size_t num_features = Classifier::INPUT_DIM;
+        constexpr size_t block = Classifier::BATCH_BLOCK;
+        static_assert(Processor::NUM_FEATURES == num_features);
+        
+        size_t num_segments = audio_segments.size();
+        py::array_t<int> species_ids(num_segments);
+        int* species_out = species_ids.mutable_data();
+        
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+        auto pool = SharedThreadPool::acquire();
+        reserve_worker_processors(pool->num_threads());
+        
+        batch_arena_.reset();
+        FeatureMatrix scratch;
+        if (features_out) {
+            *features_out = FeatureMatrix(num_segments);
+        } else {
+            scratch = FeatureMatrix(batch_arena_.allocate<Real>(FeatureMatrix::storage_size(num_segments)),
+                                    num_segments);
         }
+        FeatureMatrix& features = features_out ? *features_out : scratch;
         
-        return int_results;
+        // Tasks cover whole row groups, so no two workers write the same cache line
+        pool->parallel_for(num_segments, [&](size_t i, size_t worker) {
+            try {
+                std::array<Real, num_features> row;
+                worker_processors_[worker].extract_features(audio_segments[i], row.data());
+                features.set_row(i, row.data());
+            } catch (const std::exception&) {
+                // Leave the row zeroed
+            }
+        }, batch_grain(num_segments, pool->num_threads(), FeatureMatrix::ROW_GROUP));
+        
+        // Classify block by block with the batched engine
+        size_t num_blocks = (num_segments + block - 1) / block;
+        pool->parallel_for(num_blocks, [&](size_t b, size_t) {
+            size_t first = b * block;
+            StageTimer timer(&perf_);
+            typename Classifier::BatchOutputs outputs;
+            outputs.species_ids = species_out + first;
+            classifier_.classify_batch(features.view().subview(first, std::min(block, num_segments - first)),
+                                       outputs);
+            timer.lap(PerfStage::Inference);
+        }, batch_grain(num_blocks, pool->num_threads()));
+        
+        return species_ids;
     }
     
-    py::dict get_ecosystem_report() {
+    py::dict get_ecosystem_report(double window_seconds = 3600.0) {
+        EcosystemSnapshot snapshot;
+        {
+            py::gil_scoped_release release;  // Batches hold state_mutex_ for their whole pass
+            snapshot = ecosystem_snapshot();
+        }
         py::dict report;
         
         // Species diversity
         py::dict species_counts;
-        for (const auto& [species, count] : metrics_.species_counts) {
-            if (auto info = classifier_.get_species_info(species)) {
-                species_counts[info->common_name.c_str()] = count;
+        for (size_t id = 0; id < NUM_SPECIES; ++id) {
+            size_t count = snapshot.species_counts[id];
+            if (count == 0) {
+                continue;
+            }
+            if (auto info = classifier_.get_species_info(static_cast<AustralianSpecies>(id))) {
+                species_counts[std::string(info->common_name).c_str()] = count;
             }
         }
         report["species_counts"] = species_counts;
         
         // Health metrics
-        report["biodiversity_index"] = metrics_.biodiversity_index;
-        report["conservation_score"] = metrics_.conservation_score;
-        report["total_detections"] = metrics_.total_detections;
+        report["biodiversity_index"] = snapshot.biodiversity_index;
+        report["conservation_score"] = snapshot.conservation_score;
+        report["total_detections"] = snapshot.total_detections;
         
-        auto now = std::chrono::steady_clock::now();
-        auto monitoring_duration = std::chrono::duration_cast<std::chrono::seconds>(
-            now - metrics_.last_update).count();
-        report["monitoring_duration_seconds"] = monitoring_duration;
+        py::list channel_detections;
+        for (size_t detections : snapshot.channel_detections) {
+            channel_detections.append(detections);
+        }
+        report["channel_detections"] = channel_detections;
+        
+        report["activity_gate"] = snapshot.activity_gate;
+        report["frames_analyzed"] = snapshot.frames_analyzed;
+        report["frames_skipped"] = snapshot.frames_skipped;
+        report["monitoring_duration_seconds"] = snapshot.monitoring_duration_seconds;
+        if (snapshot.seconds_since_last_detection) {
+            report["seconds_since_last_detection"] = *snapshot.seconds_since_last_detection;
+        } else {
+            report["seconds_since_last_detection"] = py::none();
+        }
+        
+        // The same indices over recent buckets only
+        report["window"] = get_window_metrics(window_seconds);
         
         return report;
     }
     
+    // Lifetime metrics and per-channel totals as of one instant, for get_ecosystem_report
+    struct EcosystemSnapshot {
+        std::array<size_t, NUM_SPECIES> species_counts{};
+        double biodiversity_index = 0.0;
+        double conservation_score = 0.0;
+        size_t total_detections = 0;
+        std::vector<size_t> channel_detections;
+        bool activity_gate = false;
+        size_t frames_analyzed = 0;
+        size_t frames_skipped = 0;
+        int64_t monitoring_duration_seconds = 0;
+        std::optional<double> seconds_since_last_detection;  // Empty before the first detection
+    };
+    
+    EcosystemSnapshot ecosystem_snapshot() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        EcosystemSnapshot snapshot;
+        snapshot.species_counts = metrics_.species_counts;
+        snapshot.biodiversity_index = metrics_.biodiversity_index;
+        snapshot.conservation_score = metrics_.conservation_score;
+        snapshot.total_detections = metrics_.total_detections;
+        for (const auto& channel : channels_) {
+            snapshot.channel_detections.push_back(channel->total_detections);
+        }
+        snapshot.activity_gate = gate_.config().enabled;
+        snapshot.frames_analyzed = metrics_.frames_analyzed;
+        snapshot.frames_skipped = metrics_.frames_skipped;
+        
+        auto now = std::chrono::steady_clock::now();
+        snapshot.monitoring_duration_seconds = std::chrono::duration_cast<std::chrono::seconds>(
+            now - metrics_.started).count();
+        if (metrics_.total_detections != 0) {
+            snapshot.seconds_since_last_detection = std::chrono::duration<double>(now - metrics_.last_detection).count();
+        }
+        return snapshot;
+    }
+    
+    py::dict get_window_metrics(double window_seconds = 3600.0) {
+        WindowScores scores;
+        {
+            py::gil_scoped_release release;  // Batches hold state_mutex_ for their whole pass
+            scores = window_scores(window_seconds);
+        }
+        py::dict result;
+        py::dict species_counts;
+        for (size_t id = 0; id < NUM_SPECIES; ++id) {
+            if (scores.species_counts[id] == 0) {
+                continue;
+            }
+            if (auto info = classifier_.get_species_info(static_cast<AustralianSpecies>(id))) {
+                species_counts[std::string(info->common_name).c_str()] = scores.species_counts[id];
+            }
+        }
+        result["window_seconds"] = scores.window_seconds;
+        result["species_counts"] = species_counts;
+        result["species_richness"] = scores.species_richness;
+        result["biodiversity_index"] = scores.biodiversity_index;
+        result["conservation_score"] = scores.conservation_score;
+        result["total_detections"] = scores.total_detections;
+        result["frames_analyzed"] = scores.frames_analyzed;
+        result["frames_skipped"] = scores.frames_skipped;
+        return result;
+    }
+    
+    // Multi-channel ingestion of a (channels x samples) block, or (samples x channels)
+    // when interleaved. Each channel keeps its own streaming state across calls and
+    // channels run in parallel on the shared pool. Returns detections per channel.
+    template <typename Sample>
+    py::array_t<int> process_channels(const Sample* audio, size_t num_channels, size_t num_samples,
+                                      bool interleaved) {
+        py::array_t<int> detections(num_channels);
+        int* detections_out = detections.mutable_data();
+        
+        py::gil_scoped_release release;
+        ingest_channels(audio, num_channels, num_samples, interleaved, detections_out);
+        return detections;
+    }
+    
+    // Native core of process_channels; touches no Python objects. Writes detections
+    // per channel to detections_out (if given) and returns their total. Holds
+    // state_mutex_ across the whole dispatch, so concurrent blocks and the calls that
+    // walk channels_ (reports, flushes, reconfiguration) see channels between blocks.
+    template <typename Sample>
+    size_t ingest_channels(const Sample* audio, size_t num_channels, size_t num_samples, bool interleaved,
+                           int* detections_out = nullptr) {
+        StageTimer chunk_timer(&perf_);
+        std::atomic<size_t> total{0};
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        while (channels_.size() < num_channels) {
+            channels_.push_back(make_channel_state());
+        }
+        
+        auto pool = SharedThreadPool::acquire();
+        pool->parallel_for(num_channels, [&](size_t c, size_t) {
+            ChannelState& channel = *channels_[c];
+            size_t found;
+            if (interleaved) {
+                channel.deinterleaved.resize(num_samples);
+                for (size_t i = 0; i < num_samples; ++i) {
+                    channel.deinterleaved[i] = sample_value<Real>(audio[i * num_channels + c]);
+                }
+                found = process_channel(channel, std::span<const Real>(channel.deinterleaved),
+                                        static_cast<uint32_t>(c));
+            } else {
+                found = process_channel(channel, std::span<const Sample>(audio + c * num_samples, num_samples),
+                                        static_cast<uint32_t>(c));
+            }
+            if (detections_out) {
+                detections_out[c] = static_cast<int>(found);
+            }
+            total.fetch_add(found, std::memory_order_relaxed);
+        });
+        
+        StageTimer metrics_timer(&perf_);
+        for (auto& channel : channels_) {
+            merge_channel_metrics(*channel);
+        }
+        metrics_timer.lap(PerfStage::Metrics);
+        chunk_timer.lap_chunk(audio_duration_ns(num_samples));
+        return total.load(std::memory_order_relaxed);
+    }
+    
+    size_t num_channels() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return channels_.size();
+    }
+    
+    // Analyse a WAV or FLAC recording natively, block by block, and return its
+    // detections in onset order (timestamps are seconds into the file, channels are
+    // file channels). File channels get fresh streaming state and their events are
+    // collected per call, so live channels and the detection queue are not disturbed.
+    py::array_t<DetectionEvent> process_file(const std::string& path) {
+        std::vector<DetectionEvent> events;
+        {
+            py::gil_scoped_release release;
+            AudioFile file(path);
+            if (file.sample_rate() != Processor::SAMPLE_RATE) {
+                throw std::invalid_argument("process_file expects " + std::to_string(Processor::SAMPLE_RATE) +
+                                            " Hz audio, " + path + " is " + std::to_string(file.sample_rate()) + " Hz");
+            }
+            
+            size_t num_channels = file.num_channels();
+            std::vector<std::unique_ptr<ChannelState>> file_channels;
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                for (size_t c = 0; c < num_channels; ++c) {
+                    file_channels.push_back(make_channel_state());
+                }
+            }
+            std::vector<std::vector<DetectionEvent>> channel_events(num_channels);  // One writer each
+            std::vector<Real> block(num_channels * FILE_BLOCK_FRAMES);
+            
+            auto pool = SharedThreadPool::acquire();
+            StageTimer chunk_timer(&perf_);
+            while (size_t frames = file.read(block.data(), FILE_BLOCK_FRAMES)) {
+                pool->parallel_for(num_channels, [&](size_t c, size_t) {
+                    process_channel(*file_channels[c], std::span<const Real>(block.data() + c * frames, frames),
+                                    static_cast<uint32_t>(c), &channel_events[c]);
+                });
+                {
+                    std::lock_guard<std::mutex> lock(state_mutex_);
+                    for (auto& channel : file_channels) {
+                        merge_channel_metrics(*channel);
+                    }
+                }
+                chunk_timer.lap_chunk(audio_duration_ns(frames));
+            }
+            
+            // Calls still sounding at the end of the file
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                for (size_t c = 0; c < num_channels; ++c) {
+                    ChannelState& channel = *file_channels[c];
+                    channel.segmenter.flush([&](const SegmentedEvent& event) {
+                        record_channel_event(channel, event, static_cast<uint32_t>(c), event.start,
+                                             &channel_events[c]);
+                    });
+                    merge_channel_metrics(channel);
+                }
+            }
+            
+            for (const auto& found : channel_events) {
+                events.insert(events.end(), found.begin(), found.end());
+            }
+            std::stable_sort(events.begin(), events.end(), [](const DetectionEvent& a, const DetectionEvent& b) {
+                return a.timestamp < b.timestamp;
+            });
+        }
+        return py::array_t<DetectionEvent>(events.size(), events.data());
+    }
+    
+    // Batch re-scoring of many recordings as a bounded pipeline: num_readers threads
+    // decode files into blocks, one scoring thread per shared-pool thread extracts and
+    // classifies them, and the counts land in one summary per path. The scorers are the
+    // scan's own threads, so the pool stays free for short tasks (submit batches,
+    // channels, synthesis) however long the archive is. At most queue_depth decoded
+    // blocks wait for compute (0 = two per scorer), so memory is bounded however large
+    // the archive. Blocks overlap by FFT_SIZE - HOP_SIZE samples, so they are scored
+    // independently and even one long file spreads over every scorer; their frames
+    // then pass through one event segmenter per file channel in file order, so the
+    // counts are events, as process_file reports them. The activity gate is not
+    // applied. Files that cannot be read report an error and are skipped.
+    std::vector<FileScanSummary> scan_archive(const std::vector<std::string>& paths, size_t num_readers,
+                                              size_t queue_depth) {
+        constexpr size_t overlap = Processor::FFT_SIZE - Processor::HOP_SIZE;
+        std::vector<FileScanSummary> summaries(paths.size());
+        std::vector<FileScanState> files(paths.size());
+        
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+        EventSegmenterConfig segmenter_config;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            segmenter_config = segmenter_config_;
+        }
+        size_t num_workers = SharedThreadPool::size();
+        reserve_worker_processors(num_workers);
+        num_readers = std::clamp<size_t>(num_readers, 1, std::max<size_t>(paths.size(), 1));
+        queue_depth = queue_depth == 0 ? 2 * num_workers : queue_depth;
+        
+        // Every block in flight comes from this fixed set, recycled through free_blocks
+        BoundedBlockingQueue<std::unique_ptr<ScanBlock>> free_blocks(queue_depth + num_workers + num_readers);
+        BoundedBlockingQueue<std::unique_ptr<ScanBlock>> full_blocks(queue_depth);
+        for (size_t i = 0; i < queue_depth + num_workers + num_readers; ++i) {
+            free_blocks.push(std::make_unique<ScanBlock>());
+        }
+        auto abort_pipeline = [&] {
+            free_blocks.close();
+            full_blocks.close();
+        };
+        
+        std::atomic<size_t> next_file{0};
+        std::atomic<size_t> readers_left{num_readers};
+        auto read_files = [&] {
+            std::vector<Real> staging;
+            std::vector<Real> tail;  // Last `overlap` samples per channel of the previous block
+            bool running = true;
+            for (size_t f; running && (f = next_file.fetch_add(1)) < paths.size();) {
+                FileScanSummary& summary = summaries[f];
+                FileScanState& state = files[f];
+                summary.path = paths[f];
+                size_t pushed = 0;
+                try {
+                    AudioFile file(paths[f]);
+                    if (file.sample_rate() != Processor::SAMPLE_RATE) {
+                        throw std::invalid_argument("expected " + std::to_string(Processor::SAMPLE_RATE) +
+                                                    " Hz audio, file is " + std::to_string(file.sample_rate()) + " Hz");
+                    }
+                    size_t channels = file.num_channels();
+                    summary.sample_rate = file.sample_rate();
+                    summary.channels = static_cast<uint32_t>(channels);
+                    staging.resize(channels * FILE_BLOCK_FRAMES);
+                    tail.resize(channels * overlap);
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        state.segmenters.resize(channels);
+                        for (auto& segmenter : state.segmenters) {
+                            segmenter.configure(segmenter_config);
+                        }
+                    }
+                    
+                    size_t carried = 0;
+                    size_t block_start = 0;  // Sample offset of the block in the file
+                    while (size_t frames = file.read(staging.data(), FILE_BLOCK_FRAMES)) {
+                        auto block = free_blocks.pop();
+                        if (!block) {
+                            running = false;
+                            break;
+                        }
+                        ScanBlock& b = **block;
+                        b.file = f;
+                        b.sequence = pushed;
+                        b.first_frame = block_start / Processor::HOP_SIZE;
+                        b.channels = channels;
+                        b.length = carried + frames;
+                        b.samples.resize(channels * b.length);
+                        for (size_t c = 0; c < channels; ++c) {
+                            Real* row = b.samples.data() + c * b.length;
+                            std::copy(tail.begin() + c * overlap, tail.begin() + c * overlap + carried, row);
+                            std::copy(staging.begin() + c * frames, staging.begin() + (c + 1) * frames, row + carried);
+                        }
+                        carried = std::min(overlap, b.length);
+                        for (size_t c = 0; c < channels; ++c) {
+                            const Real* row_end = b.samples.data() + (c + 1) * b.length;
+                            std::copy(row_end - carried, row_end, tail.begin() + c * overlap);
+                        }
+                        block_start += b.length - carried;
+                        if (!full_blocks.push(std::move(*block))) {
+                            running = false;
+                            break;
+                        }
+                        ++pushed;
+                    }
+                    summary.duration_seconds = static_cast<double>(file.frames_read()) / file.sample_rate();
+                } catch (const std::exception& e) {
+                    summary.error = e.what();
+                }
+                
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.num_blocks = pushed;
+                finish_scan_file(state, summary);
+            }
+            if (readers_left.fetch_sub(1) == 1) {
+                full_blocks.close();
+            }
+        };
+        
+        // The first scorer failure stops the pipeline and is rethrown once every thread is joined
+        std::mutex failure_mutex;
+        std::exception_ptr failure;
+        auto score_blocks = [&](size_t worker) {
+            Processor& processor = worker_processors_[worker];
+            try {
+                while (auto block = full_blocks.pop()) {
+                    size_t f = (*block)->file;
+                    score_block(**block, processor);
+                    complete_scan_block(std::move(*block), files[f], summaries[f],
+                                        [&](std::unique_ptr<ScanBlock> done) { free_blocks.push(std::move(done)); });
+                }
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(failure_mutex);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+                abort_pipeline();
+            }
+        };
+        
+        std::vector<std::thread> threads;
+        threads.reserve(num_readers + num_workers);
+        try {
+            for (size_t r = 0; r < num_readers; ++r) {
+                threads.emplace_back(read_files);
+            }
+            for (size_t w = 0; w < num_workers; ++w) {
+                threads.emplace_back(score_blocks, w);
+            }
+        } catch (...) {
+            abort_pipeline();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            throw;
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        for (const auto& summary : summaries) {
+            count_frames(summary.frames_analyzed, 0);
+            for (size_t id = 0; id < NUM_SPECIES; ++id) {
+                if (summary.species_counts[id] != 0) {
+                    add_detections(static_cast<AustralianSpecies>(id), summary.species_counts[id]);
+                }
+            }
+        }
+        return summaries;
+    }
+    
+    // Enable or retune the energy / zero-crossing pre-filter on every stream
+    void set_activity_gate(const ActivityGateConfig& config) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        gate_.configure(config);
+        gate_.reset();
+        for (auto& channel : channels_) {
+            channel->gate.configure(config);
+            channel->gate.reset();
+        }
+    }
+    
+    // Applies to every classification path (streams, batches and archive scans). The
+    // classifier keeps it atomic, so no lock: calls already running keep the value
+    // they started with
+    double unknown_threshold() const { return classifier_.unknown_threshold(); }
+    void set_unknown_threshold(double threshold) { classifier_.set_unknown_threshold(threshold); }
+    
+    // Hysteresis for every stream, including ones already running (their open events
+    // finish under the new settings)
+    void configure_event_segmenter(const EventSegmenterConfig& config) {
+        update_event_segmenter([&](EventSegmenterConfig& current) { current = config; });
+    }
+    
+    // Read-modify-write of the hysteresis in one critical section: update(config&)
+    // edits the current settings, which then apply to every stream
+    template <typename Update>
+    void update_event_segmenter(Update&& update) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        update(segmenter_config_);
+        for (auto& channel : channels_) {
+            channel->segmenter.configure(segmenter_config_);
+        }
+        for (auto& [id, stream] : segment_streams_) {
+            stream.segmenter.configure(segmenter_config_);
+        }
+    }
+    
+    EventSegmenterConfig event_segmenter_config() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return segmenter_config_;
+    }
+    
+    // Close every open event now (e.g. before shutdown or a report) and count it
+    size_t flush_events() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        size_t flushed = 0;
+        double now = wall_clock_seconds();
+        for (size_t c = 0; c < channels_.size(); ++c) {
+            ChannelState& channel = *channels_[c];
+            double stream_now = static_cast<double>(channel.extractor.next_frame_start()) / Processor::SAMPLE_RATE;
+            channel.segmenter.flush([&](const SegmentedEvent& event) {
+                record_channel_event(channel, event, static_cast<uint32_t>(c), now - (stream_now - event.start));
+                ++flushed;
+            });
+            merge_channel_metrics(channel);
+        }
+        for (auto& [id, stream] : segment_streams_) {
+            double stream_now = static_cast<double>(stream.samples) / Processor::SAMPLE_RATE;
+            stream.segmenter.flush([&](const SegmentedEvent& event) {
+                update_ecosystem_metrics(event.species);
+                publish_event(event, id, now - (stream_now - event.start));
+                ++flushed;
+            });
+        }
+        return flushed;
+    }
+    
+    // End an ingest_audio channel: close its open event (counted and published like
+    // flush_events) and forget its segment stream. A later chunk on the same id starts
+    // a fresh stream. Returns whether the channel had a stream.
+    bool close_stream(uint32_t channel) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        auto it = segment_streams_.find(channel);
+        if (it == segment_streams_.end()) {
+            return false;
+        }
+        double now = wall_clock_seconds();
+        double stream_now = static_cast<double>(it->second.samples) / Processor::SAMPLE_RATE;
+        it->second.segmenter.flush([&](const SegmentedEvent& event) {
+            update_ecosystem_metrics(event.species);
+            publish_event(event, channel, now - (stream_now - event.start));
+        });
+        segment_streams_.erase(it);
+        return true;
+    }
+    
+    // Stage latency histograms and chunk throughput; see perf_stats.hpp
+    const PerfStats& perf_stats() const { return perf_; }
+    
+    void reset_perf_stats() { perf_.reset(); }
+    
+    // Sliding-window metrics over the last num_buckets * bucket_seconds; clears the window
+    void configure_metrics_window(double bucket_seconds, size_t num_buckets) {
+        SlidingWindowMetrics window(bucket_seconds, num_buckets);
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        window_ = std::move(window);
+    }
+    
+    // Indices over the newest window_seconds of buckets (0 = the whole window)
+    WindowScores window_scores(double window_seconds) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return window_.scores(wall_clock_seconds(), window_seconds);
+    }
+    
+    // Bucket rows oldest first with the window's shape, in one critical section so a
+    // concurrent configure_metrics_window cannot resize it mid-copy; times in Unix seconds
+    WindowExport export_metrics_window() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return window_.export_window(wall_clock_seconds());
+    }
+    
     void reset_metrics() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         metrics_ = EcosystemMetrics{};
-        metrics_.last_update = std::chrono::steady_clock::now();
+        metrics_.started = std::chrono::steady_clock::now();
+        window_.reset();
+        for (auto& channel : channels_) {
+            channel->pending_counts.fill(0);
+            channel->pending_frames = 0;
+            channel->pending_analyzed = 0;
+            channel->total_detections = 0;
+            channel->segmenter.reset();  // Open events are dropped with the counts
+        }
+        for (auto& [id, stream] : segment_streams_) {
+            stream.segmenter.reset();
+        }
     }
 
 private:
-    void update_ecosystem_metrics(AustralianSpecies species) {
-        metrics_.species_counts[species]++;
-        metrics_.total_detections++;
+    // Classify one segment and feed the channel's event segmenter; events it closes
+    // update the metrics and are published (the last one also goes to result.event).
+    // Touches no Python objects. Allocates only the first time a channel is seen (its
+    // segment stream) and for an error message. Fills result's species, skipped
+    // (rejected by the activity gate) and features. Callers hold state_mutex_.
+    template <typename Sample>
+    void ingest_segment(std::span<const Sample> audio_data, uint32_t channel, StreamResult& result) {
+        StageTimer chunk_timer(&perf_);
+        SegmentSlot slot = claim_segment(channel, audio_data.size());
+        
+        if (!admit_segment(audio_data)) {
+            result.skipped = true;
+            finish_segment(slot, AustralianSpecies::Unknown, 0.0, nullptr, &result.event);
+            chunk_timer.lap_chunk(audio_duration_ns(audio_data.size()));
+            return;
+        }
+        processor_.extract_features(audio_data, result.features.data());
         
-        // Calculate Shannon biodiversity index
-        size_t total = metrics_.total_detections;
-        double shannon_index = 0.0;
+        StageTimer timer(&perf_);
+        double confidence = 0.0;
+        result.species = classifier_.classify_audio_features(
+            typename Classifier::FeatureVector(result.features.data(), Classifier::INPUT_DIM), confidence);
+        timer.lap(PerfStage::Inference);
         
-        for (const auto& [sp, count] : metrics_.species_counts) {
-            double proportion = static_cast<double>(count) / total;
-            if (proportion > 0) {
-                shannon_index -= proportion * std::log(proportion);
+        finish_segment(slot, result.species, confidence, result.features.data(), &result.event);
+        timer.lap(PerfStage::Metrics);
+        chunk_timer.lap_chunk(audio_duration_ns(audio_data.size()));
+    }
+    
+    // One segment's place on its channel's stream clock
+    struct SegmentSlot {
+        SegmentStream* stream;  // Map nodes are stable, so this survives later insertions
+        uint32_t channel;
+        double time;
+        double duration;
+    };
+    
+    // Advance the channel's clock past a segment of length samples, whether or not it
+    // can be analysed
+    SegmentSlot claim_segment(uint32_t channel, size_t length) {
+        SegmentStream& stream = segment_stream(channel);
+        SegmentSlot slot{&stream, channel, static_cast<double>(stream.samples) / Processor::SAMPLE_RATE,
+                         static_cast<double>(length) / Processor::SAMPLE_RATE};
+        stream.samples += length;
+        return slot;
+    }
+    
+    // The single-stream activity gate; segments shorter than a frame always pass
+    template <typename Sample>
+    bool admit_segment(std::span<const Sample> audio_data) {
+        return audio_data.size() < Processor::FFT_SIZE || gate_.admit(audio_data.first(Processor::FFT_SIZE));
+    }
+    
+    // Count the segment and feed its classification to the segmenter; features is
+    // null for a segment the gate rejected
+    void finish_segment(const SegmentSlot& slot, AustralianSpecies species, double confidence,
+                        const Real* features, SegmentedEvent* closed_event) {
+        auto emit = [&](const SegmentedEvent& event) {
+            update_ecosystem_metrics(event.species);
+            publish_event(event, slot.channel, wall_clock_seconds() - (slot.time + slot.duration - event.start));
+            if (closed_event) {
+                *closed_event = event;
+            }
+        };
+        if (!features) {
+            count_frames(0, 1);
+            slot.stream->segmenter.advance(slot.time + slot.duration, emit);
+            return;
+        }
+        count_frames(1, 0);
+        slot.stream->segmenter.observe(slot.time, slot.duration, species, confidence, features, emit);
+    }
+    
+    // Batcher handler: one submit() batch through the single-stream path. The gate
+    // and segmenters run in submission order; feature extraction is spread over the
+    // shared pool and the whole batch is classified in one batched forward pass.
+    // Callbacks run after state_mutex_ is released. Batch buffers come from
+    // dispatch_arena_ and dispatch_results_, reused across batches, so steady traffic on
+    // known channels only allocates the submitted chunks themselves (copied in
+    // submit()). A channel's first chunk allocates its segment stream, and errors
+    // allocate their message.
+    // The batcher requires this not to throw: if the batch fails as a whole, every
+    // chunk not yet finished reports the error and every callback still runs.
+    void process_submissions(std::vector<StreamSubmission>& batch) {
+        dispatch_thread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        size_t count = batch.size();
+        std::vector<StreamResult>& results = dispatch_results_;
+        size_t finished = 0;  // Results complete in submission order
+        try {
+            results.assign(count, StreamResult{});
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            StageTimer chunk_timer(&perf_);
+            dispatch_arena_.reset();
+            auto slots = dispatch_arena_.allocate<SegmentSlot>(count);
+            auto admitted = dispatch_arena_.allocate<uint8_t>(count);
+            size_t total_samples = 0;
+            for (size_t i = 0; i < count; ++i) {
+                std::span<const Real> samples(batch[i].samples);
+                slots[i] = claim_segment(batch[i].channel, samples.size());
+                admitted[i] = admit_segment(samples);
+                total_samples += samples.size();
+            }
+            
+            auto pool = SharedThreadPool::acquire();
+            if (dispatch_processors_.size() < pool->num_threads()) {
+                dispatch_processors_.resize(pool->num_threads());
+                for (auto& processor : dispatch_processors_) {
+                    processor.set_perf_stats(&perf_);
+                }
+            }
+            FeatureMatrix features(dispatch_arena_.allocate<Real>(FeatureMatrix::storage_size(count)), count);
+            pool->parallel_for(count, [&](size_t i, size_t worker) {
+                if (!admitted[i]) {
+                    return;
+                }
+                try {
+                    Real* row = results[i].features.data();
+                    dispatch_processors_[worker].extract_features(std::span<const Real>(batch[i].samples), row);
+                    features.set_row(i, row);
+                } catch (const std::exception& e) {
+                    results[i].error = e.what();
+                }
+            }, batch_grain(count, pool->num_threads(), FeatureMatrix::ROW_GROUP));
+            
+            StageTimer timer(&perf_);
+            auto species_ids = dispatch_arena_.allocate<int>(count);
+            auto confidences = dispatch_arena_.allocate<Real>(count);
+            typename Classifier::BatchOutputs outputs;
+            outputs.species_ids = species_ids.data();
+            outputs.confidences = confidences.data();
+            classifier_.classify_batch(features.view(), outputs);
+            timer.lap(PerfStage::Inference);
+            
+            for (size_t i = 0; i < count; ++i) {
+                StreamResult& result = results[i];
+                if (result.error.empty()) {
+                    if (admitted[i]) {
+                        result.species = static_cast<AustralianSpecies>(species_ids[i]);
+                        finish_segment(slots[i], result.species, confidences[i], result.features.data(),
+                                       &result.event);
+                    } else {
+                        result.skipped = true;
+                        finish_segment(slots[i], AustralianSpecies::Unknown, 0.0, nullptr, &result.event);
+                    }
+                }
+                snapshot_metrics(result);
+                finished = i + 1;
             }
+            timer.lap(PerfStage::Metrics);
+            chunk_timer.lap_chunk(audio_duration_ns(total_samples));
+        } catch (const std::exception& e) {
+            fail_submissions(results, count, finished, e.what());
+        } catch (...) {
+            fail_submissions(results, count, finished, "unknown error");
         }
         
-        metrics_.biodiversity_index = shannon_index;
+        for (size_t i = 0; i < count; ++i) {
+            StageTimer(&perf_, batch[i].submitted).lap(PerfStage::Submit);
+        }
         
-        // Calculate conservation score (weighted by species importance)
-        double conservation_sum = 0.0;
-        for (const auto& [sp, count] : metrics_.species_counts) {
-            if (auto info = classifier_.get_species_info(sp)) {
-                conservation_sum += count * info->conservation_weight;
+        // One GIL acquisition for the whole batch; callbacks are dropped under it too
+        py::gil_scoped_acquire acquire;
+        for (size_t i = 0; i < count; ++i) {
+            batch[i].done(results[i]);
+            batch[i].done = nullptr;
+        }
+    }
+    
+    // Results from first on of a batch that failed as a whole carry only the error
+    static void fail_submissions(std::vector<StreamResult>& results, size_t count, size_t first,
+                                 const char* message) {
+        results.resize(count);
+        for (size_t i = first; i < count; ++i) {
+            results[i] = StreamResult{};
+            results[i].error = std::string("Submission batch failed: ") + message;
+        }
+    }
+    
+    void snapshot_metrics(StreamResult& result) {
+        result.ecosystem_health = get_ecosystem_health_score();
+        result.biodiversity_index = metrics_.biodiversity_index;
+        result.total_detections = metrics_.total_detections;
+    }
+    
+    std::shared_ptr<MicroBatcher<StreamSubmission>> current_batcher() {
+        std::lock_guard<std::mutex> lock(submit_mutex_);
+        return batcher_;
+    }
+    
+    // Finish everything submitted and stop the submission thread (restarted on demand)
+    void stop_submissions() {
+        std::lock_guard<std::mutex> lock(submit_mutex_);
+        drain_batcher();
+    }
+    
+    // Callers hold submit_mutex_. Callbacks that submit meanwhile are refused
+    // rather than waiting on the lock.
+    void drain_batcher() {
+        if (batcher_) {
+            stopping_submissions_ = true;
+            batcher_->close();
+            batcher_.reset();
+            dispatch_thread_.store(std::thread::id{}, std::memory_order_relaxed);
+            stopping_submissions_ = false;
+        }
+    }
+    
+    SegmentStream& segment_stream(uint32_t channel) {
+        auto [it, inserted] = segment_streams_.try_emplace(channel);
+        if (inserted) {
+            it->second.segmenter.configure(segmenter_config_);
+        }
+        return it->second;
+    }
+    
+    // Grain that deals a batch out as about TASKS_PER_WORKER tasks per pool thread:
+    // enough to balance by stealing, few enough that the pool's task queues do not
+    // grow (and allocate) with the batch size. Rounded up to a multiple of multiple.
+    static constexpr size_t TASKS_PER_WORKER = 16;
+    
+    static size_t batch_grain(size_t count, size_t num_threads, size_t multiple = 1) {
+        size_t grain = std::max<size_t>(1, count / (num_threads * TASKS_PER_WORKER));
+        return (grain + multiple - 1) / multiple * multiple;
+    }
+    
+    static uint64_t audio_duration_ns(size_t samples) {
+        return static_cast<uint64_t>(samples) * 1000000000ull / Processor::SAMPLE_RATE;
+    }
+    
+    // Worker scratch for the shared pool, timed into perf_; needs batch_mutex_
+    void reserve_worker_processors(size_t num_workers) {
+        if (worker_processors_.size() < num_workers) {
+            worker_processors_.resize(num_workers);
+            for (auto& processor : worker_processors_) {
+                processor.set_perf_stats(&perf_);
+            }
+        }
+    }
+    
+    // Fresh streaming state with the current gate and segmenter configuration; needs state_mutex_
+    std::unique_ptr<ChannelState> make_channel_state() {
+        auto channel = std::make_unique<ChannelState>();
+        channel->gate.configure(gate_.config());
+        channel->segmenter.configure(segmenter_config_);
+        channel->extractor.set_perf_stats(&perf_);
+        return channel;
+    }
+    
+    static double wall_clock_seconds() {
+        return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    static DetectionEvent make_detection_event(const SegmentedEvent& segment, uint32_t channel, double timestamp) {
+        static_assert(EVENT_FEATURES == Processor::NUM_FEATURES);
+        DetectionEvent event{};
+        event.timestamp = timestamp;
+        std::copy(segment.peak_features.begin(), segment.peak_features.end(), event.features);
+        event.confidence = segment.peak_confidence;
+        event.duration = static_cast<float>(segment.end - segment.start);
+        event.channel = channel;
+        event.species_id = static_cast<uint8_t>(segment.species);
+        return event;
+    }
+    
+    void publish_event(const SegmentedEvent& segment, uint32_t channel, double timestamp) {
+        detections_.try_push(make_detection_event(segment, channel, timestamp));  // A full queue counts the drop
+    }
+    
+    // n * log(n) with 0 * log(0) = 0
+    static double count_log_count(size_t count) {
+        return count > 1 ? static_cast<double>(count) * std::log(static_cast<double>(count)) : 0.0;
+    }
+    
+    // Stream one channel's samples through its segmenter; closed events go to its
+    // shard and the event queue. With a sink, events go there instead, timestamped
+    // with the onset's offset into the stream in seconds. Returns the events closed.
+    template <typename Sample>
+    size_t process_channel(ChannelState& channel, std::span<const Sample> samples, uint32_t channel_id,
+                           std::vector<DetectionEvent>* sink = nullptr) {
+        size_t found = 0;
+        auto stream_seconds = [&] {
+            return static_cast<double>(channel.extractor.next_frame_start()) / Processor::SAMPLE_RATE;
+        };
+        auto emit = [&](const SegmentedEvent& event) {
+            double timestamp = sink ? event.start : wall_clock_seconds() - (stream_seconds() - event.start);
+            record_channel_event(channel, event, channel_id, timestamp, sink);
+            ++found;
+        };
+        size_t frames = channel.extractor.push(samples, [&](std::span<const Real> features) {
+            StageTimer timer(&perf_);
+            double confidence = 0.0;
+            auto species = classifier_.classify_audio_features(
+                typename Classifier::FeatureVector(features.data(), Classifier::INPUT_DIM), confidence);
+            timer.lap(PerfStage::Inference);
+            channel.segmenter.observe(stream_seconds(), FRAME_SECONDS, species, confidence, features.data(), emit);
+            channel.pending_analyzed++;
+            timer.lap(PerfStage::Metrics);
+        }, [&](std::span<const Real> frame) { return channel.gate.admit(frame); });
+        channel.segmenter.advance(stream_seconds(), emit);  // Gated or quiet frames end calls too
+        channel.pending_frames += frames;
+        return found;
+    }
+    
+    // Count a closed event and publish it, or append it to sink when given
+    void record_channel_event(ChannelState& channel, const SegmentedEvent& event, uint32_t channel_id,
+                              double timestamp, std::vector<DetectionEvent>* sink = nullptr) {
+        channel.pending_counts[static_cast<size_t>(event.species)]++;
+        channel.total_detections++;
+        if (sink) {
+            sink->push_back(make_detection_event(event, channel_id, timestamp));
+        } else {
+            publish_event(event, channel_id, timestamp);
+        }
+    }
+    
+    // Planar (channels x length) samples of one file, starting on the hop grid, and
+    // once scored, the classification of each of its frames
+    struct ScanBlock {
+        size_t file = 0;
+        size_t sequence = 0;     // Position among the file's blocks
+        size_t first_frame = 0;  // Hop index of the first frame within the file
+        size_t channels = 0;
+        size_t length = 0;
+        std::vector<Real> samples;
+        
+        size_t frames = 0;              // Complete frames per channel
+        std::vector<Real> features;     // (channels x frames) rows of INPUT_DIM
+        std::vector<int> species;       // (channels x frames)
+        std::vector<Real> confidences;  // (channels x frames)
+    };
+    
+    // Segmentation state of one file in an archive scan. Blocks are scored in any
+    // order; each waits in pending until all earlier blocks of its file are segmented.
+    struct FileScanState {
+        std::mutex mutex;  // Guards the fields below and the summary's counts
+        std::vector<EventSegmenter> segmenters;  // One per channel
+        std::unordered_map<size_t, std::unique_ptr<ScanBlock>> pending;  // By sequence
+        size_t next_sequence = 0;
+        size_t num_blocks = SIZE_MAX;  // Known once the reader is done with the file
+        bool flushed = false;
+    };
+    
+    // Features and classification for every complete frame of every channel in one
+    // classifier batch
+    void score_block(ScanBlock& block, Processor& processor) {
+        constexpr size_t num_features = Classifier::INPUT_DIM;
+        block.frames = block.length < Processor::FFT_SIZE
+                     ? 0 : (block.length - Processor::FFT_SIZE) / Processor::HOP_SIZE + 1;
+        size_t rows = block.channels * block.frames;
+        block.features.resize(rows * num_features);
+        block.species.resize(rows);
+        block.confidences.resize(rows);
+        
+        for (size_t c = 0; c < block.channels; ++c) {
+            const Real* row = block.samples.data() + c * block.length;
+            for (size_t k = 0; k < block.frames; ++k) {
+                processor.extract_features(std::span<const Real>(row + k * Processor::HOP_SIZE, Processor::FFT_SIZE),
+                                           block.features.data() + (c * block.frames + k) * num_features);
             }
         }
-        metrics_.conservation_score = conservation_sum / total;
+        StageTimer timer(&perf_);
+        typename Classifier::BatchOutputs outputs;
+        outputs.species_ids = block.species.data();
+        outputs.confidences = block.confidences.data();
+        classifier_.classify_batch(block.features.data(), rows, outputs);
+        timer.lap(PerfStage::Inference);
+    }
+    
+    // Queue a scored block behind its file's earlier blocks and segment every block
+    // that is now next in order; recycle(std::unique_ptr<ScanBlock>) takes each one back
+    template <typename Recycle>
+    void complete_scan_block(std::unique_ptr<ScanBlock> block, FileScanState& file, FileScanSummary& summary,
+                             Recycle&& recycle) {
+        std::lock_guard<std::mutex> lock(file.mutex);
+        file.pending.emplace(block->sequence, std::move(block));
+        for (auto it = file.pending.find(file.next_sequence); it != file.pending.end();
+             it = file.pending.find(file.next_sequence)) {
+            segment_scan_block(*it->second, file, summary);
+            recycle(std::move(it->second));
+            file.pending.erase(it);
+            file.next_sequence++;
+        }
+        finish_scan_file(file, summary);
+    }
+    
+    static auto scan_event_counter(FileScanSummary& summary) {
+        return [&summary](const SegmentedEvent& event) {
+            summary.species_counts[static_cast<size_t>(event.species)]++;
+            summary.detections++;
+        };
+    }
+    
+    // Needs file.mutex
+    void segment_scan_block(const ScanBlock& block, FileScanState& file, FileScanSummary& summary) {
+        auto count = scan_event_counter(summary);
+        for (size_t c = 0; c < block.channels; ++c) {
+            EventSegmenter& segmenter = file.segmenters[c];
+            for (size_t k = 0; k < block.frames; ++k) {
+                size_t row = c * block.frames + k;
+                double time = static_cast<double>((block.first_frame + k) * Processor::HOP_SIZE) / Processor::SAMPLE_RATE;
+                segmenter.observe(time, FRAME_SECONDS, static_cast<AustralianSpecies>(block.species[row]),
+                                  block.confidences[row], block.features.data() + row * Classifier::INPUT_DIM, count);
+            }
+        }
+        summary.frames_analyzed += block.frames * block.channels;
+    }
+    
+    // Close the calls still sounding once the file's last block is segmented; needs file.mutex
+    void finish_scan_file(FileScanState& file, FileScanSummary& summary) {
+        if (file.flushed || file.next_sequence != file.num_blocks) {
+            return;
+        }
+        for (auto& segmenter : file.segmenters) {
+            segmenter.flush(scan_event_counter(summary));
+        }
+        file.flushed = true;
+    }
+    
+    void merge_channel_metrics(ChannelState& channel) {
+        count_frames(channel.pending_analyzed, channel.pending_frames - channel.pending_analyzed);
+        channel.pending_frames = 0;
+        channel.pending_analyzed = 0;
+        
+        for (size_t id = 0; id < NUM_SPECIES; ++id) {
+            if (channel.pending_counts[id] != 0) {
+                add_detections(static_cast<AustralianSpecies>(id), channel.pending_counts[id]);
+                channel.pending_counts[id] = 0;
+            }
+        }
+    }
+    
+    void update_ecosystem_metrics(AustralianSpecies species) {
+        add_detections(species, 1);
+    }
+    
+    void count_frames(size_t analyzed, size_t skipped) {
+        metrics_.frames_analyzed += analyzed;
+        metrics_.frames_skipped += skipped;
+        window_.add_frames(wall_clock_seconds(), analyzed, skipped);
+    }
+    
+    void add_detections(AustralianSpecies species, size_t detections) {
+        size_t id = static_cast<size_t>(species);
+        window_.add_detections(wall_clock_seconds(), id, detections);
+        metrics_.last_detection = std::chrono::steady_clock::now();
+        size_t& count = metrics_.species_counts[id];
+        
+        metrics_.count_log_count_sum += count_log_count(count + detections) - count_log_count(count);
+        metrics_.conservation_sum += detections * species_profile(species).conservation_weight;
+        count += detections;
+        metrics_.total_detections += detections;
+        
+        // Shannon biodiversity index and conservation score (weighted by species importance)
+        double total = static_cast<double>(metrics_.total_detections);
+        metrics_.biodiversity_index = std::max(0.0, std::log(total) - metrics_.count_log_count_sum / total);
+        metrics_.conservation_score = metrics_.conservation_sum / total;
     }
     
     double get_ecosystem_health_score() {
@@ -552,141 +2420,1026 @@ private:
     }
 };
 
+using EcosystemMonitor = EcosystemMonitorT<double>;
+using EcosystemMonitorF32 = EcosystemMonitorT<float>;
+
+// Synthetic call for a profiled species: a 5 Hz sweep around the centre of its band
+// with a 0.1 s attack and 0.3 s release
+inline FmVoice species_call_voice(AustralianSpecies species, size_t start_sample, double duration,
+                                  double gain, double sample_rate) {
+    const SpeciesProfile& profile = species_profile(species);
+    FmVoice voice;
+    voice.start = start_sample;
+    voice.length = static_cast<size_t>(duration * sample_rate);
+    voice.carrier = (profile.min_frequency + profile.max_frequency) / 2.0 / sample_rate;
+    voice.deviation = 0.3 * (profile.max_frequency - profile.min_frequency) / sample_rate;
+    voice.rate = 5.0 / sample_rate;
+    voice.attack = 0.1 * sample_rate;
+    voice.release = 0.3 * sample_rate;
+    voice.gain = gain;
+    return voice;
+}
+
 // Synthetic audio generator for testing and demos
 class AudioSimulator {
+public:
+    static constexpr double CALL_GAIN = 0.3;       // Mix level of each call in a mix
+    static constexpr double NOISE_AMPLITUDE = 0.01;
+    
 private:
-    static constexpr double SAMPLE_RATE = 44100.0;
+    static constexpr size_t RENDER_CHUNK = 16384;  // Output samples per pool task
+    static constexpr double CALL_DURATION = 2.0;   // Seconds, in ecosystem mixes
+    
+    double sample_rate_;
     
 public:
-    // Generate synthetic bird call with specific characteristics
+    explicit AudioSimulator(double sample_rate = AudioProcessor::SAMPLE_RATE) : sample_rate_(sample_rate) {}
+    
+    // Generate synthetic bird call with specific characteristics (silence for species
+    // without a profile)
     py::array_t<double> generate_bird_call(AustralianSpecies species, double duration = 2.0) {
-        size_t samples = static_cast<size_t>(duration * SAMPLE_RATE);
-        auto result = py::array_t<double>(samples);
-        auto buf = result.request();
-        auto* data = static_cast<double*>(buf.ptr);
-        
-        // Get species profile for call characteristics
-        WildlifeClassifier classifier;
-        auto species_info = classifier.get_species_info(species);
-        
-        if (!species_info) {
-            // Generate silence for unknown species
-            std::fill(data, data + samples, 0.0);
-            return result;
+        size_t samples = static_cast<size_t>(duration * sample_rate_);
+        py::array_t<double> result(samples);
+        double* data = result.mutable_data();
+        
+        py::gil_scoped_release release;
+        std::vector<FmVoice> voices;
+        if (has_species_profile(species)) {
+            voices.push_back(species_call_voice(species, 0, duration, 1.0, sample_rate_));
         }
-        
-        // Generate synthetic call based on species characteristics
-        double freq_center = (species_info->min_frequency + species_info->max_frequency) / 2.0;
-        double freq_range = species_info->max_frequency - species_info->min_frequency;
-        
-        // Generate audio samples
-        for (size_t i = 0; i < samples; ++i) {
-            double t = static_cast<double>(i) / SAMPLE_RATE;
-            
-            // Frequency modulation for natural sound
-            double freq_mod = freq_center + 
-                            freq_range * 0.3 * std::sin(2.0 * M_PI * 5.0 * t);
-            
-            // Amplitude envelope (attack-decay-sustain-release)
-            double envelope = compute_envelope(t, duration);
-            
-            // Generate waveform
-            data[i] = envelope * std::sin(2.0 * M_PI * freq_mod * t);
+        render(voices, std::nullopt, data, samples);
+        return result;
+    }
+    
+    // Generate ambient bush sounds with multiple species: one call per entry at a
+    // random time, over uniform background noise. The same seed gives the same audio.
+    py::array_t<double> generate_ecosystem_audio(const std::vector<int>& species_list,
+                                                  double duration = 10.0,
+                                                  std::optional<uint64_t> seed = std::nullopt) {
+        size_t samples = static_cast<size_t>(duration * sample_rate_);
+        py::array_t<double> result(samples);
+        double* data = result.mutable_data();
+        
+        py::gil_scoped_release release;
+        std::mt19937_64 gen(seed ? *seed : (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}());
+        uint64_t noise_seed = gen();
+        std::uniform_real_distribution<double> time_dist(0.0, std::max(duration - CALL_DURATION, 0.0));
+        
+        std::vector<FmVoice> voices;
+        for (int species_int : species_list) {
+            auto species = static_cast<AustralianSpecies>(species_int);
+            size_t start_sample = static_cast<size_t>(time_dist(gen) * sample_rate_);
+            if (has_species_profile(species)) {
+                voices.push_back(species_call_voice(species, start_sample, CALL_DURATION, CALL_GAIN, sample_rate_));
+            }
         }
-        
+        render(voices, noise_seed, data, samples);
         return result;
     }
     
-    // Generate ambient bush sounds with multiple species
-    py::array_t<double> generate_ecosystem_audio(const std::vector<int>& species_list, 
-                                                  double duration = 10.0) {
-        size_t samples = static_cast<size_t>(duration * SAMPLE_RATE);
-        std::vector<double> mixed_audio(samples, 0.0);
+private:
+    // Write the mix straight into out, chunk by chunk on the shared pool; every chunk
+    // renders the voices overlapping it and its own slice of the noise
+    void render(const std::vector<FmVoice>& voices, std::optional<uint64_t> noise_seed,
+                double* out, size_t samples) const {
+        size_t num_chunks = (samples + RENDER_CHUNK - 1) / RENDER_CHUNK;
+        auto render_chunk = [&](size_t chunk, size_t) {
+            size_t first = chunk * RENDER_CHUNK;
+            size_t count = std::min(RENDER_CHUNK, samples - first);
+            std::fill(out + first, out + first + count, 0.0);
+            for (const FmVoice& voice : voices) {
+                render_voice(voice, first, count, out + first);
+            }
+            if (noise_seed) {
+                add_uniform_noise(*noise_seed, NOISE_AMPLITUDE, first, count, out + first);
+            }
+        };
         
-        // Generate calls for each species at random times
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<double> time_dist(0.0, duration - 2.0);
+        if (num_chunks <= 1) {
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+                render_chunk(chunk, 0);
+            }
+            return;
+        }
+        SharedThreadPool::acquire()->parallel_for(num_chunks, render_chunk);
+    }
+};
+
+// Outcome of one SyntheticLoadGenerator::run
+struct LoadTestReport {
+    size_t chunks_generated = 0;
+    size_t chunks_processed = 0;
+    size_t chunks_dropped = 0;   // Generated while the queue was full, as a real sensor would lose them
+    size_t detections = 0;       // Monitor targets
+    size_t frames = 0;           // Streaming extractor targets
+    double audio_seconds = 0.0;  // Per channel, processed chunks only
+    double wall_seconds = 0.0;
+};
+
+// Endless multi-channel synthetic source for soak tests. Every channel starts calls
+// from the species mix at Poisson-distributed times over its own noise stream, all
+// derived from one seed, so the audio is reproducible chunk for chunk.
+class SyntheticLoadGenerator {
+public:
+    struct Config {
+        size_t num_channels = 1;
+        std::vector<int> species;       // Empty means every profiled species
+        size_t chunk_size = 4410;
+        double calls_per_minute = 6.0;  // Per channel
+        uint64_t seed = 0;
+    };
+    
+    static constexpr double SAMPLE_RATE = AudioProcessor::SAMPLE_RATE;
+    
+private:
+    struct ChannelStream {
+        std::mt19937_64 gen;
+        std::exponential_distribution<double> call_gap;  // Samples between calls
+        std::uniform_int_distribution<size_t> pick_species;
+        uint64_t noise_seed = 0;
+        size_t next_call = 0;         // Sample index of the next call to schedule
+        std::vector<FmVoice> voices;  // Calls still sounding
+    };
+    
+    Config config_;
+    std::vector<AustralianSpecies> species_;
+    std::vector<ChannelStream> streams_;
+    size_t position_ = 0;  // Samples generated per channel
+    
+public:
+    explicit SyntheticLoadGenerator(Config config) : config_(std::move(config)) {
+        if (config_.num_channels == 0 || config_.chunk_size == 0) {
+            throw std::invalid_argument("Load generator needs at least one channel and a non-empty chunk");
+        }
+        if (config_.calls_per_minute < 0.0) {
+            throw std::invalid_argument("calls_per_minute must be non-negative");
+        }
+        for (int id : config_.species) {
+            auto species = static_cast<AustralianSpecies>(id);
+            if (id < 0 || static_cast<size_t>(id) >= NUM_SPECIES || !has_species_profile(species)) {
+                throw std::invalid_argument("No call profile for species id " + std::to_string(id));
+            }
+            species_.push_back(species);
+        }
+        if (species_.empty()) {
+            for (size_t id = 1; id < NUM_SPECIES; ++id) {
+                if (has_species_profile(static_cast<AustralianSpecies>(id))) {
+                    species_.push_back(static_cast<AustralianSpecies>(id));
+                }
+            }
+        }
         
-        for (int species_int : species_list) {
-            auto species = static_cast<AustralianSpecies>(species_int);
-            double start_time = time_dist(gen);
-            auto call_audio = generate_bird_call(species, 2.0);
-            
-            // Mix into main audio
-            auto call_buf = call_audio.request();
-            auto* call_data = static_cast<double*>(call_buf.ptr);
-            size_t call_samples = call_buf.shape[0];
-            size_t start_sample = static_cast<size_t>(start_time * SAMPLE_RATE);
+        streams_.resize(config_.num_channels);
+        for (size_t c = 0; c < streams_.size(); ++c) {
+            ChannelStream& stream = streams_[c];
+            stream.gen.seed(config_.seed ^ (0x9E3779B97F4A7C15ull * (c + 1)));
+            stream.call_gap = std::exponential_distribution<double>(
+                std::max(config_.calls_per_minute, 1e-9) / (60.0 * SAMPLE_RATE));
+            stream.pick_species = std::uniform_int_distribution<size_t>(0, species_.size() - 1);
+            stream.noise_seed = stream.gen();
+            stream.next_call = next_call_after(stream, 0);
+        }
+    }
+    
+    size_t num_channels() const { return config_.num_channels; }
+    size_t chunk_size() const { return config_.chunk_size; }
+    size_t position() const { return position_; }
+    
+    // Render the next chunk of every channel as planar (channels x chunk_size) rows;
+    // channels are rendered in parallel on the shared pool
+    void next_chunk(double* out) {
+        size_t first = position_;
+        size_t count = config_.chunk_size;
+        auto render_channel = [&](size_t c, size_t) {
+            ChannelStream& stream = streams_[c];
+            while (stream.next_call < first + count) {
+                auto species = species_[stream.pick_species(stream.gen)];
+                double duration = species_profile(species).typical_duration;
+                stream.voices.push_back(species_call_voice(species, stream.next_call, duration,
+                                                           AudioSimulator::CALL_GAIN, SAMPLE_RATE));
+                stream.next_call = next_call_after(stream, stream.next_call);
+            }
             
-            for (size_t i = 0; i < call_samples && start_sample + i < samples; ++i) {
-                mixed_audio[start_sample + i] += call_data[i] * 0.3; // Mix at reduced volume
+            double* row = out + c * count;
+            std::fill(row, row + count, 0.0);
+            for (const FmVoice& voice : stream.voices) {
+                render_voice(voice, first, count, row);
             }
+            add_uniform_noise(stream.noise_seed, AudioSimulator::NOISE_AMPLITUDE, first, count, row);
+            std::erase_if(stream.voices, [&](const FmVoice& voice) {
+                return voice.start + voice.length <= first + count;
+            });
+        };
+        
+        if (streams_.size() == 1) {
+            render_channel(0, 0);
+        } else {
+            SharedThreadPool::acquire()->parallel_for(streams_.size(), render_channel);
         }
+        position_ += count;
+    }
+    
+    // Feed chunks to consume(chunk, report) for duration_seconds of wall time. A
+    // producer thread paces generation at rate x real time (0 = as fast as the
+    // consumer keeps up) into a queue of queue_depth chunks; when the consumer falls
+    // behind, chunks that find the queue full are dropped and counted.
+    template <typename Consume>
+    LoadTestReport run(double duration_seconds, double rate, size_t queue_depth, Consume&& consume) {
+        using Clock = std::chrono::steady_clock;
+        using Chunk = std::unique_ptr<std::vector<double>>;
+        if (rate < 0.0) {
+            throw std::invalid_argument("rate must be a positive multiple of real time, or 0 for max");
+        }
+        queue_depth = std::max<size_t>(queue_depth, 1);
         
-        // Add ambient noise
-        std::uniform_real_distribution<double> noise_dist(-0.01, 0.01);
-        for (auto& sample : mixed_audio) {
-            sample += noise_dist(gen);
+        // queue_depth chunks in flight plus one each held by the producer and consumer
+        BoundedBlockingQueue<Chunk> free_chunks(queue_depth + 2);
+        BoundedBlockingQueue<Chunk> full_chunks(queue_depth);
+        for (size_t i = 0; i < queue_depth + 2; ++i) {
+            free_chunks.push(std::make_unique<std::vector<double>>(config_.num_channels * config_.chunk_size));
         }
         
-        auto result = py::array_t<double>(samples);
-        auto buf = result.request();
-        std::copy(mixed_audio.begin(), mixed_audio.end(), static_cast<double*>(buf.ptr));
+        LoadTestReport report;
+        auto start = Clock::now();
+        auto stop_at = start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(duration_seconds));
+        auto chunk_period = std::chrono::duration<double>(config_.chunk_size / SAMPLE_RATE / std::max(rate, 1e-9));
+        std::exception_ptr producer_error;
         
-        return result;
+        std::thread producer([&] {
+            try {
+                for (size_t n = 0;; ++n) {
+                    // A producer running behind schedule skips no chunks, but still stops on time
+                    if (rate > 0.0) {
+                        auto due = start + std::chrono::duration_cast<Clock::duration>(chunk_period * n);
+                        if (due >= stop_at) {
+                            break;
+                        }
+                        std::this_thread::sleep_until(due);
+                    }
+                    if (Clock::now() >= stop_at) {
+                        break;
+                    }
+                    auto chunk = free_chunks.pop();
+                    if (!chunk) {
+                        break;
+                    }
+                    next_chunk((*chunk)->data());
+                    report.chunks_generated++;
+                    bool queued = rate > 0.0 ? full_chunks.try_push(*chunk) : full_chunks.push(std::move(*chunk));
+                    if (!queued) {
+                        report.chunks_dropped++;
+                        free_chunks.push(std::move(*chunk));
+                    }
+                }
+            } catch (...) {
+                producer_error = std::current_exception();
+            }
+            full_chunks.close();
+        });
+        
+        try {
+            while (auto chunk = full_chunks.pop()) {
+                consume((*chunk)->data(), report);
+                report.chunks_processed++;
+                free_chunks.push(std::move(*chunk));
+            }
+        } catch (...) {
+            free_chunks.close();
+            full_chunks.close();
+            producer.join();
+            throw;
+        }
+        producer.join();
+        if (producer_error) {
+            std::rethrow_exception(producer_error);
+        }
+        
+        report.wall_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report.audio_seconds = report.chunks_processed * config_.chunk_size / SAMPLE_RATE;
+        return report;
     }
-
+    
+    // Soak-test a monitor: every chunk goes through its multi-channel ingestion
+    template <typename Monitor>
+    LoadTestReport run_monitor(Monitor& monitor, double duration_seconds, double rate, size_t queue_depth) {
+        return run(duration_seconds, rate, queue_depth, [&](const double* chunk, LoadTestReport& report) {
+            report.detections += monitor.ingest_channels(chunk, config_.num_channels, config_.chunk_size, false);
+        });
+    }
+    
+    // Soak-test a streaming extractor with channel 0
+    template <typename Extractor>
+    LoadTestReport run_extractor(Extractor& extractor, double duration_seconds, double rate, size_t queue_depth) {
+        if (config_.num_channels != 1) {
+            throw std::invalid_argument("A streaming extractor takes one channel; use a monitor for more");
+        }
+        return run(duration_seconds, rate, queue_depth, [&](const double* chunk, LoadTestReport& report) {
+            report.frames += extractor.push(std::span<const double>(chunk, config_.chunk_size),
+                                            [](const auto&) {});
+        });
+    }
+    
 private:
-    double compute_envelope(double t, double duration) {
-        double attack_time = 0.1;
-        double release_time = 0.3;
-        
-        if (t < attack_time) {
-            return t / attack_time; // Linear attack
-        } else if (t > duration - release_time) {
-            return (duration - t) / release_time; // Linear release
-        } else {
-            return 1.0; // Sustain
+    size_t next_call_after(ChannelStream& stream, size_t sample) const {
+        if (config_.calls_per_minute == 0.0) {
+            return std::numeric_limits<size_t>::max();
         }
+        return sample + static_cast<size_t>(stream.call_gap(stream.gen));
     }
 };
 
-// Performance benchmarking utilities
+// Quick throughput check behind benchmark_performance(); bench/benchmarks.cpp is the
+// reference suite for regression tracking
 class PerformanceBenchmark {
 public:
+    // Extract features from every frame of num_samples of tone-plus-noise audio,
+    // num_iterations times. The checksum consumes every result so the loop cannot
+    // be optimised away.
     static py::dict compare_cpp_vs_python(size_t num_samples, size_t num_iterations) {
-        // C++ processing
         AudioProcessor processor;
-        std::vector<double> test_audio(num_samples);
-        std::iota(test_audio.begin(), test_audio.end(), 0.0);
+        std::vector<double> test_audio(std::max(num_samples, AudioProcessor::FFT_SIZE));
+        std::mt19937 gen(42);
+        std::normal_distribution<double> noise(0.0, 0.05);
+        for (size_t i = 0; i < test_audio.size(); ++i) {
+            test_audio[i] = 0.5 * std::sin(2.0 * M_PI * 2000.0 * i / AudioProcessor::SAMPLE_RATE) + noise(gen);
+        }
         
-        auto start_time = std::chrono::high_resolution_clock::now();
+        std::span<const double> audio(test_audio);
+        size_t frames_per_iteration = AudioProcessor::frame_count(audio.size());
+        double checksum = 0.0;
+        std::array<double, AudioProcessor::NUM_FEATURES> features;
         
+        auto start_time = std::chrono::steady_clock::now();
         for (size_t i = 0; i < num_iterations; ++i) {
-            try {
-                auto features = processor.extract_features(test_audio);
-            } catch (const std::exception&) {
-                // Ignore errors in benchmark
+            for (size_t frame = 0; frame < frames_per_iteration; ++frame) {
+                processor.extract_features(audio.subspan(frame * AudioProcessor::HOP_SIZE, AudioProcessor::FFT_SIZE),
+                                           features.data());
+                checksum += features[0];
             }
         }
-        
-        auto end_time = std::chrono::high_resolution_clock::now();
+        auto end_time = std::chrono::steady_clock::now();
         auto cpp_duration = std::chrono::duration<double>(end_time - start_time).count();
         
+        size_t frames = frames_per_iteration * num_iterations;
         py::dict results;
         results["cpp_time"] = cpp_duration;
-        results["samples_processed"] = num_samples * num_iterations;
-        results["samples_per_second"] = (num_samples * num_iterations) / cpp_duration;
+        results["samples_processed"] = audio.size() * num_iterations;
+        results["samples_per_second"] = (audio.size() * num_iterations) / cpp_duration;
+        results["frames_processed"] = frames;
+        results["frames_per_second"] = frames / cpp_duration;
+        results["ns_per_frame"] = cpp_duration * 1e9 / std::max<size_t>(frames, 1);
+        results["checksum"] = checksum;
         
         return results;
     }
 };
 
+// C-contiguous NumPy buffer; already-contiguous arrays of the right dtype bind without a copy
+template <typename T>
+using contiguous_array = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// Borrow a 1-D NumPy buffer as a span (valid while the array is alive)
+template <typename T>
+std::span<const T> as_span(const contiguous_array<T>& array) {
+    if (array.ndim() != 1) {
+        throw py::value_error("Expected a 1-D array, got " + std::to_string(array.ndim()) + " dimensions");
+    }
+    return {array.data(), static_cast<size_t>(array.size())};
+}
+
+// Row count of a C-contiguous (rows x cols) matrix, validating its shape
+template <typename T>
+size_t matrix_rows(const contiguous_array<T>& array, size_t cols) {
+    if (array.ndim() != 2 || static_cast<size_t>(array.shape(1)) != cols) {
+        throw py::value_error("Expected an (N x " + std::to_string(cols) + ") array");
+    }
+    return static_cast<size_t>(array.shape(0));
+}
+
+// (channels, samples) of a multi-channel block; interleaved blocks are (samples x channels)
+template <typename T>
+std::pair<size_t, size_t> channel_layout(const contiguous_array<T>& array, bool interleaved) {
+    if (array.ndim() != 2) {
+        throw py::value_error("Expected a 2-D multi-channel array, got " + std::to_string(array.ndim()) + " dimensions");
+    }
+    auto rows = static_cast<size_t>(array.shape(0));
+    auto cols = static_cast<size_t>(array.shape(1));
+    return interleaved ? std::pair{cols, rows} : std::pair{rows, cols};
+}
+
+// Destination for a native result: a fresh (rows) or (rows x cols) array for None,
+// otherwise the caller's preallocated array, written in place. That must already have
+// the result's dtype and shape and be C-contiguous and writeable, since converting it
+// would silently write into a copy.
+template <typename T>
+py::array_t<T> output_array(const py::object& out, size_t rows, size_t cols, const char* name) {
+    if (out.is_none()) {
+        return cols == 0 ? py::array_t<T>(rows) : py::array_t<T>({rows, cols});
+    }
+    if (!py::array_t<T, py::array::c_style>::check_(out)) {
+        throw py::value_error(std::string(name) + " must be a C-contiguous array of the result dtype");
+    }
+    auto array = py::reinterpret_borrow<py::array_t<T>>(out);
+    bool shape_ok = cols == 0
+        ? array.ndim() == 1 && static_cast<size_t>(array.shape(0)) == rows
+        : array.ndim() == 2 && static_cast<size_t>(array.shape(0)) == rows && static_cast<size_t>(array.shape(1)) == cols;
+    if (!shape_ok) {
+        throw py::value_error(std::string(name) + " must have shape (" + std::to_string(rows) +
+                              (cols == 0 ? "" : ", " + std::to_string(cols)) + ")");
+    }
+    if (!array.writeable()) {
+        throw py::value_error(std::string(name) + " is read-only");
+    }
+    return array;
+}
+
+// Zero-copy (rows x Columns) NumPy view of a columnar feature matrix, which the
+// array then owns. It is Fortran-ordered: features[:, i] is contiguous.
+template <typename Real, size_t Columns>
+py::array_t<Real> feature_matrix_array(FeatureMatrixT<Real, Columns>&& matrix) {
+    using Matrix = FeatureMatrixT<Real, Columns>;
+    auto* owned = new Matrix(std::move(matrix));
+    py::capsule base(owned, [](void* p) { delete static_cast<Matrix*>(p); });
+    auto rows = static_cast<py::ssize_t>(owned->rows());
+    auto column_stride = static_cast<py::ssize_t>(owned->stride() * sizeof(Real));
+    return py::array_t<Real>({rows, static_cast<py::ssize_t>(Columns)},
+                             {static_cast<py::ssize_t>(sizeof(Real)), column_stride}, owned->data(), base);
+}
+
+// Python object that native threads may hold: whichever thread drops the last
+// reference takes the GIL to release it
+inline std::shared_ptr<py::object> gil_safe_object(py::object object) {
+    return std::shared_ptr<py::object>(new py::object(std::move(object)), [](py::object* held) {
+        py::gil_scoped_acquire acquire;
+        delete held;
+    });
+}
+
+// Holder deleter for classes whose destructor joins a thread that takes the GIL
+template <typename T>
+struct ReleaseGilDelete {
+    void operator()(T* object) const {
+        py::gil_scoped_release release;
+        delete object;
+    }
+};
+
+// Borrow each segment of a batch as a span
+template <typename T>
+std::vector<std::span<const T>> as_spans(const std::vector<contiguous_array<T>>& arrays) {
+    std::vector<std::span<const T>> views;
+    views.reserve(arrays.size());
+    for (const auto& array : arrays) {
+        views.push_back(as_span(array));
+    }
+    return views;
+}
+
+// Invoke fn(Sample{}) for every sample dtype the bindings accept. float64 comes
+// first so dtypes without an exact overload are force-cast to double; int16 PCM
+// only matches exactly and is scaled to [-1, 1) natively.
+template <typename Fn>
+void for_each_sample_type(Fn&& fn) {
+    fn(double{});
+    fn(float{});
+    fn(int16_t{});
+}
+
+// Convert generated float64 audio to the requested sample dtype; int16 is clipped
+py::object as_sample_dtype(const py::array_t<double>& audio, const std::string& dtype) {
+    if (dtype == "float64") {
+        return py::cast(audio);
+    }
+    const double* src = audio.data();
+    auto count = static_cast<size_t>(audio.size());
+    std::vector<py::ssize_t> shape(audio.shape(), audio.shape() + audio.ndim());
+    if (dtype == "float32") {
+        py::array_t<float> result(shape);
+        std::transform(src, src + count, result.mutable_data(),
+                       [](double x) { return static_cast<float>(x); });
+        return py::cast(result);
+    }
+    if (dtype == "int16") {
+        py::array_t<int16_t> result(shape);
+        std::transform(src, src + count, result.mutable_data(), [](double x) {
+            return static_cast<int16_t>(std::lround(std::clamp(x * 32768.0, -32768.0, 32767.0)));
+        });
+        return py::cast(result);
+    }
+    throw py::value_error("dtype must be 'float64', 'float32' or 'int16'");
+}
+
+SpectrogramScale spectrogram_scale(const std::string& scale) {
+    if (scale == "magnitude") {
+        return SpectrogramScale::Magnitude;
+    }
+    if (scale == "power") {
+        return SpectrogramScale::Power;
+    }
+    if (scale == "db") {
+        return SpectrogramScale::Decibels;
+    }
+    throw py::value_error("scale must be 'magnitude', 'power' or 'db'");
+}
+
+// Spectrogram in the requested output dtype; None keeps the processor's precision
+template <typename Processor, typename Sample>
+py::object spectrogram_as(Processor& self, std::span<const Sample> audio, const SpectrogramConfig& config,
+                          size_t num_threads, const std::optional<std::string>& dtype) {
+    if (!dtype) {
+        return self.template compute_spectrogram<typename Processor::Real>(audio, config, num_threads);
+    }
+    if (*dtype == "float64") {
+        return self.template compute_spectrogram<double>(audio, config, num_threads);
+    }
+    if (*dtype == "float32") {
+        return self.template compute_spectrogram<float>(audio, config, num_threads);
+    }
+    if (*dtype == "uint8") {
+        return self.template compute_spectrogram<uint8_t>(audio, config, num_threads);
+    }
+    throw py::value_error("dtype must be 'float64', 'float32' or 'uint8'");
+}
+
+// Bind one compiled AudioProcessor variant under the given Python name
+template <typename Processor>
+void bind_audio_processor(py::module_& m, const char* name) {
+    py::class_<Processor> cls(m, name);
+    cls.def(py::init<>());
+    for_each_sample_type([&](auto sample) {
+        using Sample = decltype(sample);
+        cls.def("extract_features", [](Processor& self, contiguous_array<Sample> audio) {
+            return self.extract_features(as_span(audio));
+        })
+        .def("compute_spectrogram", [](Processor& self, contiguous_array<Sample> audio, size_t num_threads,
+                                       const std::string& scale, const std::optional<std::string>& dtype,
+                                       double min_hz, double max_hz, size_t time_decimation,
+                                       size_t freq_decimation, double min_db, double max_db) {
+            SpectrogramConfig config{spectrogram_scale(scale), min_hz, max_hz, time_decimation,
+                                     freq_decimation, min_db, max_db};
+            return spectrogram_as(self, as_span(audio), config, num_threads, dtype);
+        }, py::arg("audio"), py::arg("num_threads") = 1, py::kw_only(), py::arg("scale") = "magnitude",
+           py::arg("dtype") = py::none(), py::arg("min_hz") = 0.0, py::arg("max_hz") = 0.0,
+           py::arg("time_decimation") = 1, py::arg("freq_decimation") = 1,
+           py::arg("min_db") = -80.0, py::arg("max_db") = 0.0,
+           "Spectrogram (rows x columns): cropped to [min_hz, max_hz], mean-pooled over "
+           "time_decimation frames by freq_decimation bins, as magnitude, power or dBFS; "
+           "dtype='uint8' quantizes [min_db, max_db] dBFS for direct image output")
+        .def("compute_mel_spectrogram", [](Processor& self, contiguous_array<Sample> audio, size_t num_mels,
+                                           double min_hz, double max_hz) {
+            return self.compute_mel_spectrogram(as_span(audio), MelConfig{num_mels, 1, min_hz, max_hz});
+        }, py::arg("audio"), py::arg("num_mels") = 40, py::arg("min_hz") = 0.0, py::arg("max_hz") = 0.0)
+        .def("compute_mfcc", [](Processor& self, contiguous_array<Sample> audio, size_t num_coeffs,
+                                size_t num_mels, double min_hz, double max_hz) {
+            return self.compute_mfcc(as_span(audio), MelConfig{num_mels, num_coeffs, min_hz, max_hz});
+        }, py::arg("audio"), py::arg("num_coeffs") = 13, py::arg("num_mels") = 40,
+           py::arg("min_hz") = 0.0, py::arg("max_hz") = 0.0);
+    });
+    cls.def_property_readonly("sample_rate", [](const Processor&) { return Processor::SAMPLE_RATE; })
+        .def_property_readonly("fft_size", [](const Processor&) { return Processor::FFT_SIZE; })
+        .def_property_readonly("hop_size", [](const Processor&) { return Processor::HOP_SIZE; })
+        .def_property_readonly("dtype", [](const Processor&) {
+            return std::is_same_v<typename Processor::Real, float> ? "float32" : "float64";
+        });
+}
+
+// Bind the streaming extractor for one compiled AudioProcessor variant
+template <typename Processor>
+void bind_streaming_extractor(py::module_& m, const char* name) {
+    using Extractor = StreamingFeatureExtractorT<Processor>;
+    py::class_<Extractor> cls(m, name);
+    cls.def(py::init<>());
+    for_each_sample_type([&](auto sample) {
+        using Sample = decltype(sample);
+        cls.def("push", [](Extractor& self, contiguous_array<Sample> chunk) {
+            return self.push(as_span(chunk));
+        });
+    });
+    cls.def("pending_frames", &Extractor::pending_frames)
+        .def("reset", &Extractor::reset)
+        .def_property_readonly("next_frame_start", &Extractor::next_frame_start)
+        .def_property_readonly("samples_pushed", &Extractor::samples_pushed)
+        .def_property_readonly("frames_emitted", &Extractor::frames_emitted);
+}
+
+template <typename Classifier>
+void bind_classifier(py::module_& m, const char* name) {
+    using Real = typename Classifier::Real;
+    py::class_<Classifier>(m, name)
+        .def(py::init<>())
+        .def(py::init<const std::string&>(), py::arg("model_path"),
+             "Load a trained model file; weights stored in this precision are memory-mapped "
+             "and shared between processes")
+        .def("save_model", &Classifier::save_model, py::arg("path"))
+        .def("classify_audio_features", [](Classifier& self, contiguous_array<Real> features) {
+            auto result = self.classify_audio_features(as_span(features));
+            return static_cast<int>(result);
+        })
+        .def("classify_batch", [](const Classifier& self, contiguous_array<Real> features, py::object out) {
+            size_t num_rows = matrix_rows(features, Classifier::INPUT_DIM);
+            auto species_ids = output_array<int>(out, num_rows, 0, "out");
+            int* species_out = species_ids.mutable_data();
+            {
+                py::gil_scoped_release release;
+                self.classify_batch(features.data(), num_rows, species_out);
+            }
+            return species_ids;
+        }, py::arg("features"), py::arg("out") = py::none(),
+           "Classify an (N x 8) feature matrix, returning N species ids")
+        .def("predict_probabilities", [](const Classifier& self, contiguous_array<Real> features, py::object out) {
+            size_t num_rows = matrix_rows(features, Classifier::INPUT_DIM);
+            auto probabilities = output_array<Real>(out, num_rows, Classifier::OUTPUT_DIM, "out");
+            typename Classifier::BatchOutputs outputs;
+            outputs.probabilities = probabilities.mutable_data();
+            {
+                py::gil_scoped_release release;
+                self.classify_batch(features.data(), num_rows, outputs);
+            }
+            return probabilities;
+        }, py::arg("features"), py::arg("out") = py::none(),
+           "(N x 12) softmax probabilities; column o is species output_species[o]")
+        .def("top_k", [](const Classifier& self, contiguous_array<Real> features, size_t k,
+                         py::object species_out, py::object scores_out) {
+            size_t num_rows = matrix_rows(features, Classifier::INPUT_DIM);
+            if (k == 0 || k > Classifier::OUTPUT_DIM) {
+                throw py::value_error("k must be in [1, " + std::to_string(Classifier::OUTPUT_DIM) + "]");
+            }
+            auto species = output_array<int>(species_out, num_rows, k, "species_out");
+            auto scores = output_array<Real>(scores_out, num_rows, k, "scores_out");
+            typename Classifier::BatchOutputs outputs;
+            outputs.top_k = k;
+            outputs.top_species = species.mutable_data();
+            outputs.top_scores = scores.mutable_data();
+            {
+                py::gil_scoped_release release;
+                self.classify_batch(features.data(), num_rows, outputs);
+            }
+            return py::make_tuple(species, scores);
+        }, py::arg("features"), py::arg("k") = 3, py::arg("species_out") = py::none(),
+           py::arg("scores_out") = py::none(),
+           "(species ids, probabilities), each (N x k), most probable first")
+        .def("classify_scored", [](const Classifier& self, contiguous_array<Real> features, size_t k,
+                                   bool with_probabilities, py::object species_out, py::object confidence_out,
+                                   py::object probabilities_out, py::object top_species_out,
+                                   py::object top_scores_out) {
+            size_t num_rows = matrix_rows(features, Classifier::INPUT_DIM);
+            if (k > Classifier::OUTPUT_DIM) {
+                throw py::value_error("k must be at most " + std::to_string(Classifier::OUTPUT_DIM));
+            }
+            py::dict result;
+            auto species = output_array<int>(species_out, num_rows, 0, "species_out");
+            auto confidence = output_array<Real>(confidence_out, num_rows, 0, "confidence_out");
+            typename Classifier::BatchOutputs outputs;
+            outputs.species_ids = species.mutable_data();
+            outputs.confidences = confidence.mutable_data();
+            result["species_ids"] = species;
+            result["confidence"] = confidence;
+            if (with_probabilities || !probabilities_out.is_none()) {
+                auto probabilities = output_array<Real>(probabilities_out, num_rows, Classifier::OUTPUT_DIM,
+                                                        "probabilities_out");
+                outputs.probabilities = probabilities.mutable_data();
+                result["probabilities"] = probabilities;
+            }
+            if (k != 0) {
+                auto top_species = output_array<int>(top_species_out, num_rows, k, "top_species_out");
+                auto top_scores = output_array<Real>(top_scores_out, num_rows, k, "top_scores_out");
+                outputs.top_k = k;
+                outputs.top_species = top_species.mutable_data();
+                outputs.top_scores = top_scores.mutable_data();
+                result["top_species"] = top_species;
+                result["top_scores"] = top_scores;
+            }
+            {
+                py::gil_scoped_release release;
+                self.classify_batch(features.data(), num_rows, outputs);
+            }
+            return result;
+        }, py::arg("features"), py::arg("k") = 0, py::arg("probabilities") = false,
+           py::arg("species_out") = py::none(), py::arg("confidence_out") = py::none(),
+           py::arg("probabilities_out") = py::none(), py::arg("top_species_out") = py::none(),
+           py::arg("top_scores_out") = py::none(),
+           "Species ids and confidences, plus optionally the probability matrix and top-k, "
+           "from one forward pass; *_out arrays are filled in place")
+        .def_property("unknown_threshold", &Classifier::unknown_threshold, &Classifier::set_unknown_threshold,
+                      "Winning probability below which a classification is Unknown")
+        .def_property_readonly("output_species", [](const Classifier& self) {
+            py::array_t<int> species(Classifier::OUTPUT_DIM);
+            for (size_t o = 0; o < Classifier::OUTPUT_DIM; ++o) {
+                species.mutable_data()[o] = static_cast<int>(self.output_species(o));
+            }
+            return species;
+        }, "Species id of each probability column");
+}
+
+py::dict scan_summary_dict(const FileScanSummary& summary) {
+    py::dict result;
+    result["path"] = summary.path;
+    if (!summary.error.empty()) {
+        result["error"] = summary.error;
+    }
+    result["sample_rate"] = summary.sample_rate;
+    result["channels"] = summary.channels;
+    result["duration_seconds"] = summary.duration_seconds;
+    result["frames_analyzed"] = summary.frames_analyzed;
+    result["detections"] = summary.detections;
+    py::dict species_counts;
+    for (size_t id = 1; id < NUM_SPECIES; ++id) {
+        const SpeciesProfile& profile = species_profile(static_cast<AustralianSpecies>(id));
+        if (summary.species_counts[id] != 0 && !profile.common_name.empty()) {
+            species_counts[std::string(profile.common_name).c_str()] = summary.species_counts[id];
+        }
+    }
+    result["species_counts"] = species_counts;
+    return result;
+}
+
+// Stage latencies in microseconds plus the real-time factor: seconds of audio per
+// second spent in streaming calls (below 1 the node is falling behind)
+py::dict perf_stats_dict(const PerfStats& stats) {
+    py::dict result;
+    result["enabled"] = PerfStats::compiled_in();
+    py::dict stages;
+    for (size_t stage = 0; stage < NUM_PERF_STAGES; ++stage) {
+        LatencySummary summary = stats.summary(static_cast<PerfStage>(stage));
+        py::dict entry;
+        entry["count"] = summary.count;
+        entry["mean_us"] = summary.mean / 1e3;
+        entry["p50_us"] = summary.p50 / 1e3;
+        entry["p99_us"] = summary.p99 / 1e3;
+        entry["p999_us"] = summary.p999 / 1e3;
+        entry["max_us"] = summary.max / 1e3;
+        stages[PERF_STAGE_NAMES[stage]] = entry;
+    }
+    result["stages"] = stages;
+    
+    LatencySummary chunk = stats.summary(PerfStage::Chunk);
+    double busy_seconds = chunk.mean * chunk.count / 1e9;
+    double audio_seconds = stats.audio_ns() / 1e9;
+    result["chunks"] = chunk.count;
+    result["audio_seconds"] = audio_seconds;
+    result["busy_seconds"] = busy_seconds;
+    result["realtime_factor"] = busy_seconds > 0.0 ? audio_seconds / busy_seconds : 0.0;
+    return result;
+}
+
+// One CSV row per file, with a count column per profiled species
+void write_scan_summary_csv(const std::string& path, const std::vector<FileScanSummary>& summaries) {
+    auto quoted = [](const std::string& text) {
+        std::string out = "\"";
+        for (char ch : text) {
+            out += ch == '"' ? "\"\"" : std::string(1, ch);
+        }
+        return out + "\"";
+    };
+    
+    std::ofstream out(path, std::ios::trunc);
+    out << "path,error,sample_rate,channels,duration_seconds,frames_analyzed,detections";
+    for (size_t id = 1; id < NUM_SPECIES; ++id) {
+        if (has_species_profile(static_cast<AustralianSpecies>(id))) {
+            out << ',' << quoted(std::string(species_profile(static_cast<AustralianSpecies>(id)).common_name));
+        }
+    }
+    out << '\n';
+    for (const auto& summary : summaries) {
+        out << quoted(summary.path) << ',' << quoted(summary.error) << ',' << summary.sample_rate << ','
+            << summary.channels << ',' << summary.duration_seconds << ',' << summary.frames_analyzed << ','
+            << summary.detections;
+        for (size_t id = 1; id < NUM_SPECIES; ++id) {
+            if (has_species_profile(static_cast<AustralianSpecies>(id))) {
+                out << ',' << summary.species_counts[id];
+            }
+        }
+        out << '\n';
+    }
+    if (!out) {
+        throw std::runtime_error("Cannot write scan summary " + path);
+    }
+}
+
+// Sustained throughput of a load test: realtime_factor is audio seconds per wall
+// second, channel_realtime_factor the same over all channels
+py::dict load_report_dict(const LoadTestReport& report, size_t num_channels, double rate) {
+    py::dict result;
+    result["target_rate"] = rate;
+    result["channels"] = num_channels;
+    result["chunks_generated"] = report.chunks_generated;
+    result["chunks_processed"] = report.chunks_processed;
+    result["chunks_dropped"] = report.chunks_dropped;
+    result["audio_seconds"] = report.audio_seconds;
+    result["wall_seconds"] = report.wall_seconds;
+    double factor = report.wall_seconds > 0.0 ? report.audio_seconds / report.wall_seconds : 0.0;
+    result["realtime_factor"] = factor;
+    result["channel_realtime_factor"] = factor * num_channels;
+    result["detections"] = report.detections;
+    result["frames"] = report.frames;
+    return result;
+}
+
+template <typename Monitor>
+void bind_ecosystem_monitor(py::module_& m, const char* name) {
+    // Destroying a monitor finishes its submissions, whose callbacks need the GIL
+    py::class_<Monitor, std::unique_ptr<Monitor, ReleaseGilDelete<Monitor>>> cls(m, name);
+    cls.def(py::init<>())
+        .def(py::init<const std::string&>(), py::arg("model_path"));
+    for_each_sample_type([&](auto sample) {
+        using Sample = decltype(sample);
+        cls.def("process_audio_stream", [](Monitor& self, contiguous_array<Sample> audio_chunk) {
+            return self.process_audio_stream(as_span(audio_chunk));
+        })
+        .def("classify_audio_batch", [](Monitor& self, const std::vector<contiguous_array<Sample>>& segments,
+                                        bool return_features) -> py::object {
+            auto views = as_spans(segments);
+            std::span<const std::span<const Sample>> batch(views);
+            if (!return_features) {
+                return self.classify_audio_batch(batch);
+            }
+            typename Monitor::FeatureMatrix features;
+            auto species_ids = self.classify_audio_batch(batch, &features);
+            return py::make_tuple(species_ids, feature_matrix_array(std::move(features)));
+        }, py::arg("segments"), py::kw_only(), py::arg("return_features") = false)
+        .def("ingest_audio", [](Monitor& self, contiguous_array<Sample> audio_chunk, uint32_t channel) {
+            return self.ingest_audio(as_span(audio_chunk), channel);
+        }, py::arg("audio_chunk"), py::arg("channel") = 0)
+        .def("submit", [](Monitor& self, contiguous_array<Sample> audio_chunk, uint32_t channel) {
+            py::object future = py::module_::import("concurrent.futures").attr("Future")();
+            auto pending = gil_safe_object(future);
+            typename Monitor::SubmitCallback done = [pending](typename Monitor::StreamResult& result) {
+                try {
+                    if (!pending->attr("done")().cast<bool>()) {  // Not cancelled meanwhile
+                        pending->attr("set_result")(Monitor::stream_result_dict(result));
+                    }
+                } catch (py::error_already_set& error) {
+                    error.discard_as_unraisable("EcosystemMonitor.submit");
+                }
+            };
+            bool queued;
+            {
+                // configure_submissions holds the submit lock while callbacks take the GIL
+                py::gil_scoped_release release;
+                queued = self.submit(as_span(audio_chunk), channel, std::move(done));
+            }
+            if (!queued) {
+                throw std::runtime_error("Submission queue is full; wait for pending results or raise max_pending");
+            }
+            return future;
+        }, py::arg("audio_chunk"), py::arg("channel") = 0,
+           "Queue a chunk without blocking; returns a concurrent.futures.Future of the "
+           "process_audio_stream result (channel 0 is that stream). Pending chunks are batched natively.")
+        .def("process_channels", [](Monitor& self, contiguous_array<Sample> audio, bool interleaved) {
+            auto [channels, samples] = channel_layout(audio, interleaved);
+            return self.process_channels(audio.data(), channels, samples, interleaved);
+        }, py::arg("audio"), py::arg("interleaved") = false,
+           "Stream a (channels x samples) block, or (samples x channels) if interleaved");
+    });
+    cls.def_property_readonly("num_channels", [](Monitor& self) {
+            py::gil_scoped_release release;
+            return self.num_channels();
+        })
+        .def("configure_submissions", [](Monitor& self, size_t max_batch, size_t max_pending, double max_wait_ms) {
+            if (!(max_wait_ms >= 0.0)) {
+                throw py::value_error("max_wait_ms must be non-negative");
+            }
+            typename Monitor::SubmitConfig config{max_batch, max_pending,
+                                                  std::chrono::microseconds(std::llround(max_wait_ms * 1000.0))};
+            py::gil_scoped_release release;
+            self.configure_submissions(config);
+        }, py::arg("max_batch") = 64, py::arg("max_pending") = 4096, py::arg("max_wait_ms") = 0.0,
+           "Batching for submit(): chunks per batch, chunks allowed to wait, and how long a short "
+           "batch may wait to fill (0 = dispatch at once)")
+        .def("wait_submissions", [](Monitor& self) {
+            py::gil_scoped_release release;
+            self.wait_submissions();
+        }, "Block until every submitted chunk's future is resolved")
+        .def_property_readonly("pending_submissions", [](Monitor& self) {
+            py::gil_scoped_release release;
+            return self.pending_submissions();
+        })
+        .def("set_activity_gate", [](Monitor& self, bool enabled, double threshold_db,
+                                     double max_zero_crossing_rate, double adaptation) {
+            if (adaptation <= 0.0 || adaptation > 1.0) {
+                throw py::value_error("adaptation must be in (0, 1]");
+            }
+            py::gil_scoped_release release;
+            self.set_activity_gate({enabled, threshold_db, max_zero_crossing_rate, adaptation});
+        }, py::arg("enabled") = true, py::arg("threshold_db") = 6.0,
+           py::arg("max_zero_crossing_rate") = 0.4, py::arg("adaptation") = 0.05,
+           "Skip frames below an adaptive noise floor before feature extraction")
+        .def("process_file", &Monitor::process_file, py::arg("path"),
+             "Analyse a WAV or FLAC recording natively; returns its detections, timestamped in file seconds")
+        .def("scan_archive", [](Monitor& self, const std::vector<std::string>& paths, size_t num_readers,
+                                size_t queue_depth, const std::string& summary_path) {
+            auto summaries = self.scan_archive(paths, num_readers, queue_depth);
+            if (!summary_path.empty()) {
+                write_scan_summary_csv(summary_path, summaries);
+            }
+            py::list result;
+            for (const auto& summary : summaries) {
+                result.append(scan_summary_dict(summary));
+            }
+            return result;
+        }, py::arg("paths"), py::arg("num_readers") = 2, py::arg("queue_depth") = 0,
+           py::arg("summary_path") = "",
+           "Score many WAV/FLAC recordings with overlapped reads and compute; one summary per path, "
+           "optionally also written as CSV")
+        .def("drain_detections", &Monitor::drain_detections, py::arg("max_events") = 0,
+             "Queued detection events as a structured array "
+             "(timestamp, features, confidence, duration, channel, species_id)")
+        .def("set_event_segmentation", [](Monitor& self, bool enabled) {
+            py::gil_scoped_release release;
+            self.update_event_segmenter([&](EventSegmenterConfig& config) { config.enabled = enabled; });
+        }, py::arg("enabled") = true,
+           "Merge consecutive frame detections into one event per call (default), or report every frame")
+        .def("set_event_hysteresis", [](Monitor& self, AustralianSpecies species, double onset_confidence,
+                                        double offset_confidence, std::optional<double> onset_seconds,
+                                        std::optional<double> hold_seconds, std::optional<double> max_seconds) {
+            if (offset_confidence > onset_confidence) {
+                throw py::value_error("offset_confidence must not exceed onset_confidence");
+            }
+            auto prior = SpeciesHysteresis::for_call_duration(species_profile(species).typical_duration);
+            SpeciesHysteresis hysteresis{onset_confidence, offset_confidence,
+                                         onset_seconds.value_or(prior.onset_seconds),
+                                         hold_seconds.value_or(prior.hold_seconds),
+                                         max_seconds.value_or(prior.max_seconds)};
+            if (hysteresis.onset_seconds < 0.0 || hysteresis.hold_seconds < 0.0 || hysteresis.max_seconds <= 0.0) {
+                throw py::value_error("onset and hold must be non-negative and max_seconds positive");
+            }
+            py::gil_scoped_release release;
+            self.update_event_segmenter([&](EventSegmenterConfig& config) {
+                config.species[static_cast<size_t>(species)] = hysteresis;
+            });
+        }, py::arg("species"), py::arg("onset_confidence") = 0.4, py::arg("offset_confidence") = 0.3,
+           py::arg("onset_seconds") = py::none(), py::arg("hold_seconds") = py::none(),
+           py::arg("max_seconds") = py::none(),
+           "Per-species hysteresis; omitted timings follow the species' typical call duration")
+        .def("flush_events", [](Monitor& self) {
+            py::gil_scoped_release release;
+            return self.flush_events();
+        }, "Close every open event now; returns how many")
+        .def("close_stream", [](Monitor& self, uint32_t channel) {
+            py::gil_scoped_release release;
+            return self.close_stream(channel);
+        }, py::arg("channel"),
+           "End an ingest_audio / submit channel: flush its open event and free its state")
+        .def_property("unknown_threshold", &Monitor::unknown_threshold, &Monitor::set_unknown_threshold,
+                      "Winning probability below which frames classify as Unknown (default 0.3)")
+        .def_property_readonly("dropped_detections", &Monitor::dropped_detections)
+        .def("get_ecosystem_report", &Monitor::get_ecosystem_report, py::arg("window_seconds") = 3600.0,
+             "Lifetime health metrics, plus the same indices over the last window_seconds under 'window'")
+        .def("get_window_metrics", &Monitor::get_window_metrics, py::arg("window_seconds") = 3600.0,
+             "Biodiversity and conservation indices over the newest window_seconds of the sliding window")
+        .def("configure_metrics_window", [](Monitor& self, double bucket_seconds, size_t num_buckets) {
+            py::gil_scoped_release release;
+            self.configure_metrics_window(bucket_seconds, num_buckets);
+        }, py::arg("bucket_seconds") = 60.0, py::arg("num_buckets") = 1440,
+           "Resize the sliding window (default: per-minute buckets over 24 h); clears it")
+        .def("export_metrics_window", [](Monitor& self) {
+            constexpr size_t columns = SlidingWindowMetrics::COLUMNS;
+            constexpr py::ssize_t row_stride = columns * sizeof(uint32_t);
+            auto* snapshot = new WindowExport;
+            py::capsule cells(snapshot, [](void* p) { delete static_cast<WindowExport*>(p); });
+            {
+                py::gil_scoped_release release;
+                *snapshot = self.export_metrics_window();
+            }
+            
+            // Column views over the one copy, which the capsule owns
+            py::ssize_t rows = static_cast<py::ssize_t>(snapshot->num_buckets);
+            uint32_t* base = snapshot->cells.data();
+            py::dict result;
+            result["start_time"] = snapshot->start_time;
+            result["bucket_seconds"] = snapshot->bucket_seconds;
+            result["species_counts"] = py::array_t<uint32_t>(
+                {rows, static_cast<py::ssize_t>(NUM_SPECIES)}, {row_stride, py::ssize_t(sizeof(uint32_t))},
+                base, cells);
+            result["frames_analyzed"] = py::array_t<uint32_t>(
+                {rows}, {row_stride}, base + SlidingWindowMetrics::FRAMES_ANALYZED, cells);
+            result["frames_skipped"] = py::array_t<uint32_t>(
+                {rows}, {row_stride}, base + SlidingWindowMetrics::FRAMES_SKIPPED, cells);
+            py::array_t<double> weights(NUM_SPECIES);
+            for (size_t id = 0; id < NUM_SPECIES; ++id) {
+                weights.mutable_data()[id] = SPECIES_TABLE[id].conservation_weight;
+            }
+            result["conservation_weights"] = weights;
+            return result;
+        }, "Sliding-window buckets oldest first: species_counts is (buckets x species id), "
+           "start_time is the oldest bucket's start in Unix seconds, conservation_weights is by species id")
+        .def("get_perf_stats", [](const Monitor& self) { return perf_stats_dict(self.perf_stats()); },
+             "Per-stage latency percentiles (window, fft, features, inference, metrics, chunk) "
+             "and the real-time factor")
+        .def("reset_perf_stats", &Monitor::reset_perf_stats)
+        .def("reset_metrics", [](Monitor& self) {
+            py::gil_scoped_release release;
+            self.reset_metrics();
+        });
+}
+
 // Python module definition
 PYBIND11_MODULE(_core, m) {
     m.doc() = "Bush Ears - High-performance wildlife audio identification";
     
+    PYBIND11_NUMPY_DTYPE(DetectionEvent, timestamp, features, confidence, duration, channel, species_id);
+    
     // Enums
     py::enum_<AustralianSpecies>(m, "AustralianSpecies")
         .value("Unknown", AustralianSpecies::Unknown)
@@ -699,37 +3452,184 @@ PYBIND11_MODULE(_core, m) {
         .value("Dingo", AustralianSpecies::Dingo);
     
     // Classes
-    py::class_<AudioProcessor>(m, "AudioProcessor")
-        .def(py::init<>())
-        .def("extract_features", [](AudioProcessor& self, py::array_t<double> audio) {
-            auto buf = audio.request();
-            std::vector<double> audio_vec(static_cast<double*>(buf.ptr), 
-                                         static_cast<double*>(buf.ptr) + buf.shape[0]);
-            return self.extract_features(audio_vec);
-        })
-        .def("compute_spectrogram", &AudioProcessor::compute_spectrogram);
+    bind_audio_processor<AudioProcessor>(m, "AudioProcessor");
+    bind_audio_processor<AudioProcessor22k>(m, "AudioProcessor22k");
+    bind_audio_processor<AudioProcessor48k>(m, "AudioProcessor48k");
+    bind_audio_processor<AudioProcessor96k>(m, "AudioProcessor96k");
+    bind_audio_processor<AudioProcessorBat>(m, "AudioProcessorBat");
+    bind_audio_processor<AudioProcessorF32>(m, "AudioProcessorF32");
+    bind_audio_processor<AudioProcessor22kF32>(m, "AudioProcessor22kF32");
+    bind_audio_processor<AudioProcessor48kF32>(m, "AudioProcessor48kF32");
+    bind_audio_processor<AudioProcessor96kF32>(m, "AudioProcessor96kF32");
+    bind_audio_processor<AudioProcessorBatF32>(m, "AudioProcessorBatF32");
     
-    py::class_<WildlifeClassifier>(m, "WildlifeClassifier")
-        .def(py::init<>())
-        .def("classify_audio_features", [](WildlifeClassifier& self, const std::vector<double>& features) {
-            auto result = self.classify_audio_features(features);
-            return static_cast<int>(result);
-        })
-        .def("classify_batch", &WildlifeClassifier::classify_batch);
+    bind_streaming_extractor<AudioProcessor>(m, "StreamingFeatureExtractor");
+    bind_streaming_extractor<AudioProcessor22k>(m, "StreamingFeatureExtractor22k");
+    bind_streaming_extractor<AudioProcessor48k>(m, "StreamingFeatureExtractor48k");
+    bind_streaming_extractor<AudioProcessor96k>(m, "StreamingFeatureExtractor96k");
+    bind_streaming_extractor<AudioProcessorBat>(m, "StreamingFeatureExtractorBat");
+    bind_streaming_extractor<AudioProcessorF32>(m, "StreamingFeatureExtractorF32");
     
-    py::class_<EcosystemMonitor>(m, "EcosystemMonitor")
-        .def(py::init<>())
-        .def("process_audio_stream", &EcosystemMonitor::process_audio_stream)
-        .def("classify_audio_batch", &EcosystemMonitor::classify_audio_batch)
-        .def("get_ecosystem_report", &EcosystemMonitor::get_ecosystem_report)
-        .def("reset_metrics", &EcosystemMonitor::reset_metrics);
+    m.def("create_audio_processor", [](size_t sample_rate, size_t fft_size, size_t hop_size,
+                                       const std::string& dtype) {
+        if (dtype == "float64") {
+            return create_audio_processor<AudioProcessor, AudioProcessor22k, AudioProcessor48k,
+                                          AudioProcessor96k, AudioProcessorBat>(sample_rate, fft_size, hop_size);
+        }
+        if (dtype == "float32") {
+            return create_audio_processor<AudioProcessorF32, AudioProcessor22kF32, AudioProcessor48kF32,
+                                          AudioProcessor96kF32, AudioProcessorBatF32>(sample_rate, fft_size, hop_size);
+        }
+        throw py::value_error("dtype must be 'float64' or 'float32'");
+    }, py::arg("sample_rate") = AudioProcessor::SAMPLE_RATE,
+       py::arg("fft_size") = AudioProcessor::FFT_SIZE,
+       py::arg("hop_size") = AudioProcessor::HOP_SIZE,
+       py::arg("dtype") = "float64",
+       "Create the compiled AudioProcessor variant matching a recorder configuration");
+    
+    bind_classifier<WildlifeClassifier>(m, "WildlifeClassifier");
+    bind_classifier<WildlifeClassifierF32>(m, "WildlifeClassifierF32");
+    
+    bind_ecosystem_monitor<EcosystemMonitor>(m, "EcosystemMonitor");
+    bind_ecosystem_monitor<EcosystemMonitorF32>(m, "EcosystemMonitorF32");
     
     py::class_<AudioSimulator>(m, "AudioSimulator")
-        .def(py::init<>())
-        .def("generate_bird_call", &AudioSimulator::generate_bird_call)
-        .def("generate_ecosystem_audio", &AudioSimulator::generate_ecosystem_audio);
+        .def(py::init<double>(), py::arg("sample_rate") = AudioProcessor::SAMPLE_RATE)
+        .def("generate_bird_call", [](AudioSimulator& self, AustralianSpecies species, double duration,
+                                      const std::string& dtype) {
+            return as_sample_dtype(self.generate_bird_call(species, duration), dtype);
+        }, py::arg("species"), py::arg("duration") = 2.0, py::arg("dtype") = "float64")
+        .def("generate_ecosystem_audio", [](AudioSimulator& self, const std::vector<int>& species_list,
+                                            double duration, const std::string& dtype,
+                                            std::optional<uint64_t> seed) {
+            return as_sample_dtype(self.generate_ecosystem_audio(species_list, duration, seed), dtype);
+        }, py::arg("species_list"), py::arg("duration") = 10.0, py::arg("dtype") = "float64",
+           py::arg("seed") = py::none(),
+           "Mix one call per species at random times over background noise; a seed makes it reproducible");
+    
+    auto load_generator = py::class_<SyntheticLoadGenerator>(m, "LoadGenerator")
+        .def(py::init([](size_t num_channels, const std::vector<int>& species, size_t chunk_size,
+                         double calls_per_minute, std::optional<uint64_t> seed) {
+            SyntheticLoadGenerator::Config config;
+            config.num_channels = num_channels;
+            config.species = species;
+            config.chunk_size = chunk_size;
+            config.calls_per_minute = calls_per_minute;
+            config.seed = seed ? *seed : (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+            return std::make_unique<SyntheticLoadGenerator>(std::move(config));
+        }), py::arg("num_channels") = 1, py::arg("species") = std::vector<int>{},
+            py::arg("chunk_size") = 4410, py::arg("calls_per_minute") = 6.0, py::arg("seed") = py::none(),
+            "Endless synthetic 44.1 kHz source: Poisson-timed calls from the species mix over noise")
+        .def_property_readonly("num_channels", &SyntheticLoadGenerator::num_channels)
+        .def_property_readonly("chunk_size", &SyntheticLoadGenerator::chunk_size)
+        .def_property_readonly("position", &SyntheticLoadGenerator::position,
+                               "Samples generated so far per channel")
+        .def("next_chunk", [](SyntheticLoadGenerator& self, const std::string& dtype) {
+            py::array_t<double> chunk({self.num_channels(), self.chunk_size()});
+            {
+                py::gil_scoped_release release;
+                self.next_chunk(chunk.mutable_data());
+            }
+            return as_sample_dtype(chunk, dtype);
+        }, py::arg("dtype") = "float64", "Next (channels x chunk_size) block");
+    auto bind_load_target = [&](auto target, auto run) {
+        using Target = std::remove_pointer_t<decltype(target)>;
+        load_generator.def("run", [run](SyntheticLoadGenerator& self, Target& sink, double duration,
+                                        double rate, size_t queue_depth) {
+            LoadTestReport report;
+            {
+                py::gil_scoped_release release;
+                report = run(self, sink, duration, rate, queue_depth);
+            }
+            return load_report_dict(report, self.num_channels(), rate);
+        }, py::arg("target"), py::arg("duration") = 10.0, py::arg("rate") = 1.0, py::arg("queue_depth") = 4,
+           "Feed the target natively for duration wall seconds at rate x real time (0 = max); "
+           "reports sustained throughput and dropped chunks");
+    };
+    auto run_monitor = [](SyntheticLoadGenerator& self, auto& monitor, double duration, double rate, size_t depth) {
+        return self.run_monitor(monitor, duration, rate, depth);
+    };
+    auto run_extractor = [](SyntheticLoadGenerator& self, auto& extractor, double duration, double rate,
+                            size_t depth) {
+        return self.run_extractor(extractor, duration, rate, depth);
+    };
+    bind_load_target(static_cast<EcosystemMonitor*>(nullptr), run_monitor);
+    bind_load_target(static_cast<EcosystemMonitorF32*>(nullptr), run_monitor);
+    bind_load_target(static_cast<StreamingFeatureExtractor*>(nullptr), run_extractor);
+    bind_load_target(static_cast<StreamingFeatureExtractorF32*>(nullptr), run_extractor);
+    
+    py::class_<AudioFile>(m, "AudioFile")
+        .def(py::init<const std::string&>(), py::arg("path"),
+             "Memory-map a WAV (PCM or float, RIFF or RF64) or FLAC recording for sequential reads")
+        .def_property_readonly("format", [](const AudioFile& self) {
+            return self.format() == AudioFile::Format::Wav ? "wav" : "flac";
+        })
+        .def_property_readonly("sample_rate", &AudioFile::sample_rate)
+        .def_property_readonly("num_channels", &AudioFile::num_channels)
+        .def_property_readonly("bits_per_sample", &AudioFile::bits_per_sample)
+        .def_property_readonly("num_frames", &AudioFile::num_frames)
+        .def_property_readonly("frames_read", &AudioFile::frames_read)
+        .def("read", [](AudioFile& self, size_t max_frames, const std::string& dtype) -> py::object {
+            auto read_block = [&](auto zero) {
+                using Real = decltype(zero);
+                size_t channels = self.num_channels();
+                py::array_t<Real> block({channels, max_frames});
+                size_t frames;
+                {
+                    py::gil_scoped_release release;
+                    frames = self.read(block.mutable_data(), max_frames);
+                }
+                if (frames == max_frames) {
+                    return block;
+                }
+                py::array_t<Real> packed({channels, frames});
+                std::copy(block.data(), block.data() + channels * frames, packed.mutable_data());
+                return packed;
+            };
+            if (dtype == "float64") {
+                return py::cast(read_block(double{}));
+            }
+            if (dtype == "float32") {
+                return py::cast(read_block(float{}));
+            }
+            throw py::value_error("dtype must be 'float64' or 'float32'");
+        }, py::arg("max_frames"), py::arg("dtype") = "float64",
+           "Next block as a (channels x frames) array scaled to [-1, 1); empty at end of file");
     
     // Utility functions
+    m.def("set_num_threads", &SharedThreadPool::resize, py::arg("num_threads"),
+          "Resize the worker pool used by batch APIs (0 = one thread per core)");
+    m.def("get_num_threads", &SharedThreadPool::size,
+          "Number of threads in the batch worker pool");
+    m.def("write_model_file", [](const std::string& path,
+                                 contiguous_array<double> hidden_weights,
+                                 contiguous_array<double> output_weights,
+                                 contiguous_array<uint8_t> species_ids,
+                                 const std::string& dtype) {
+        constexpr size_t input_dim = WildlifeClassifier::INPUT_DIM;
+        constexpr size_t hidden_dim = WildlifeClassifier::HIDDEN_DIM;
+        constexpr size_t output_dim = WildlifeClassifier::OUTPUT_DIM;
+        if (matrix_rows(hidden_weights, hidden_dim) != input_dim ||
+            matrix_rows(output_weights, output_dim) != hidden_dim ||
+            as_span(species_ids).size() != output_dim) {
+            throw py::value_error("Expected hidden (8 x 16), output (16 x 12) weights and 12 species ids");
+        }
+        if (dtype == "float64") {
+            write_model_file(path, input_dim, hidden_dim, output_dim, species_ids.data(),
+                             hidden_weights.data(), output_weights.data());
+        } else if (dtype == "float32") {
+            std::vector<float> hidden(hidden_weights.data(), hidden_weights.data() + hidden_weights.size());
+            std::vector<float> output(output_weights.data(), output_weights.data() + output_weights.size());
+            write_model_file(path, input_dim, hidden_dim, output_dim, species_ids.data(),
+                             hidden.data(), output.data());
+        } else {
+            throw py::value_error("dtype must be 'float64' or 'float32'");
+        }
+    }, py::arg("path"), py::arg("hidden_weights"), py::arg("output_weights"), py::arg("species_ids"),
+       py::arg("dtype") = "float64",
+       "Write trained classifier weights as a Bush Ears model file, stored as float64 or float32");
+    m.def("simd_backend", &simd_backend,
+          "Name of the spectral feature kernel selected for this CPU");
     m.def("benchmark_performance", &PerformanceBenchmark::compare_cpp_vs_python,
           "Compare C++ vs Python audio processing performance");
 }
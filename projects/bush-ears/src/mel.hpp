@@ -0,0 +1,177 @@
+/*
+ * Bush Ears - Mel filterbank and MFCC engine
+ * Filter weights are precomputed as sparse rows over the FFT bins and the DCT is a
+ * cached table, so a frame costs one short dot product per filter and coefficient
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// HTK mel scale
+inline double hz_to_mel(double hz) { return 2595.0 * std::log10(1.0 + hz / 700.0); }
+inline double mel_to_hz(double mel) { return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0); }
+
+// Triangular filters evenly spaced in mel between min_hz and max_hz. Each filter only
+// touches the bins under its triangle, stored as (start, length, offset into weights_).
+class MelFilterbank {
+private:
+    struct Row {
+        uint32_t start;   // First FFT bin
+        uint32_t length;  // Bins covered
+        uint32_t offset;  // Index of the first weight in weights_
+    };
+
+    std::vector<Row> rows_;
+    std::vector<double> weights_;
+
+public:
+    MelFilterbank(double sample_rate, size_t fft_size, size_t num_mels, double min_hz, double max_hz) {
+        size_t num_bins = fft_size / 2 + 1;
+        double bin_hz = sample_rate / fft_size;
+
+        // num_mels + 2 edges: filter m rises from edge m to m + 1 and falls to m + 2
+        std::vector<double> edges(num_mels + 2);
+        double min_mel = hz_to_mel(min_hz);
+        double mel_step = (hz_to_mel(max_hz) - min_mel) / (num_mels + 1);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            edges[i] = mel_to_hz(min_mel + i * mel_step);
+        }
+
+        rows_.reserve(num_mels);
+        for (size_t m = 0; m < num_mels; ++m) {
+            double left = edges[m], centre = edges[m + 1], right = edges[m + 2];
+            Row row{0, 0, static_cast<uint32_t>(weights_.size())};
+            for (size_t bin = 0; bin < num_bins; ++bin) {
+                double hz = bin * bin_hz;
+                double weight = hz <= centre ? (hz - left) / (centre - left) : (right - hz) / (right - centre);
+                if (weight <= 0.0) {
+                    if (row.length != 0) {
+                        break;  // Past the triangle
+                    }
+                    continue;
+                }
+                if (row.length == 0) {
+                    row.start = static_cast<uint32_t>(bin);
+                }
+                weights_.push_back(weight);
+                ++row.length;
+            }
+            rows_.push_back(row);
+        }
+    }
+
+    size_t num_mels() const { return rows_.size(); }
+
+    // mel[m] = sum of the filter's weights times the power spectrum under it
+    void apply(const double* power, double* mel) const {
+        for (size_t m = 0; m < rows_.size(); ++m) {
+            const Row& row = rows_[m];
+            const double* weights = weights_.data() + row.offset;
+            const double* bins = power + row.start;
+            double sum = 0.0;
+            for (size_t k = 0; k < row.length; ++k) {
+                sum += weights[k] * bins[k];
+            }
+            mel[m] = sum;
+        }
+    }
+};
+
+// Orthonormal DCT-II, num_coeffs x num_inputs, row-major
+class DctTable {
+private:
+    size_t num_inputs_;
+    size_t num_coeffs_;
+    std::vector<double> table_;
+
+public:
+    DctTable(size_t num_inputs, size_t num_coeffs)
+        : num_inputs_(num_inputs), num_coeffs_(num_coeffs), table_(num_inputs * num_coeffs) {
+        for (size_t k = 0; k < num_coeffs; ++k) {
+            double scale = std::sqrt((k == 0 ? 1.0 : 2.0) / num_inputs);
+            for (size_t n = 0; n < num_inputs; ++n) {
+                table_[k * num_inputs + n] = scale * std::cos(M_PI * k * (2.0 * n + 1.0) / (2.0 * num_inputs));
+            }
+        }
+    }
+
+    size_t num_coeffs() const { return num_coeffs_; }
+
+    void apply(const double* input, float* output) const {
+        for (size_t k = 0; k < num_coeffs_; ++k) {
+            const double* row = table_.data() + k * num_inputs_;
+            double sum = 0.0;
+            for (size_t n = 0; n < num_inputs_; ++n) {
+                sum += row[n] * input[n];
+            }
+            output[k] = static_cast<float>(sum);
+        }
+    }
+};
+
+// Parameters of a mel / MFCC front end
+struct MelConfig {
+    size_t num_mels = 40;
+    size_t num_coeffs = 13;
+    double min_hz = 0.0;
+    double max_hz = 0.0;  // 0 means Nyquist
+
+    bool operator==(const MelConfig&) const = default;
+};
+
+// Filterbank plus DCT for one (sample rate, FFT size, MelConfig); immutable once built
+class MelFeatureEngine {
+private:
+    static constexpr double LOG_FLOOR = 1e-10;  // Keeps log() finite on silent frames
+
+    MelConfig config_;
+    MelFilterbank filterbank_;
+    DctTable dct_;
+
+public:
+    MelFeatureEngine(double sample_rate, size_t fft_size, const MelConfig& config)
+        : config_(validated(config, sample_rate)),
+          filterbank_(sample_rate, fft_size, config_.num_mels, config_.min_hz, config_.max_hz),
+          dct_(config_.num_mels, config_.num_coeffs) {}
+
+    const MelConfig& config() const { return config_; }
+
+    // Log-mel energies of a float64 or float32 magnitude spectrum;
+    // power_scratch holds FFT_SIZE / 2 + 1 values
+    template <typename Real>
+    void log_mel(const Real* magnitude, size_t num_bins, double* power_scratch, double* mel) const {
+        for (size_t i = 0; i < num_bins; ++i) {
+            double m = magnitude[i];
+            power_scratch[i] = m * m;
+        }
+        filterbank_.apply(power_scratch, mel);
+        for (size_t m = 0; m < config_.num_mels; ++m) {
+            mel[m] = std::log(std::max(mel[m], LOG_FLOOR));
+        }
+    }
+
+    void mfcc(const double* log_mel, float* coeffs) const {
+        dct_.apply(log_mel, coeffs);
+    }
+
+private:
+    static MelConfig validated(MelConfig config, double sample_rate) {
+        double nyquist = sample_rate / 2.0;
+        if (config.max_hz == 0.0) {
+            config.max_hz = nyquist;
+        }
+        if (config.num_mels == 0 || config.num_coeffs == 0 || config.num_coeffs > config.num_mels) {
+            throw std::invalid_argument("MFCC needs 0 < num_coeffs <= num_mels");
+        }
+        if (config.min_hz < 0.0 || config.max_hz > nyquist || config.min_hz >= config.max_hz) {
+            throw std::invalid_argument("Mel range must satisfy 0 <= min_hz < max_hz <= Nyquist");
+        }
+        return config;
+    }
+};
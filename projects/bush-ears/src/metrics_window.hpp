@@ -0,0 +1,204 @@
+/*
+ * Bush Ears - Sliding-window ecosystem metrics
+ * Fixed-memory ring of time buckets (per-minute counts over the last day by
+ * default), so windowed scores stay meaningful on monitors that run for months
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "species.hpp"
+
+// Health indices over the buckets of one window
+struct WindowScores {
+    double window_seconds = 0.0;  // Span of the buckets included; the newest is still filling
+    size_t total_detections = 0;
+    size_t species_richness = 0;
+    double biodiversity_index = 0.0;  // Shannon H over the window's counts
+    double conservation_score = 0.0;  // Mean conservation weight per detection
+    size_t frames_analyzed = 0;
+    size_t frames_skipped = 0;
+    std::array<size_t, NUM_SPECIES> species_counts{};
+};
+
+// A copy of every bucket as of one instant, oldest first
+struct WindowExport {
+    double start_time = 0.0;  // Start of the oldest bucket
+    double bucket_seconds = 0.0;
+    size_t num_buckets = 0;
+    std::vector<uint32_t> cells;  // num_buckets x SlidingWindowMetrics::COLUMNS
+};
+
+// Each bucket is one row of counts: species by id, then frames analyzed and skipped.
+// Buckets are keyed by absolute index floor(time / bucket_seconds) and live in slot
+// index % num_buckets; moving into a new bucket subtracts the expired rows from the
+// running totals, so rollover is O(1) per elapsed bucket and whole-ring scores never
+// rescan the ring. Not thread-safe; the monitor updates it from the calling thread.
+class SlidingWindowMetrics {
+public:
+    static constexpr size_t FRAMES_ANALYZED = NUM_SPECIES;
+    static constexpr size_t FRAMES_SKIPPED = NUM_SPECIES + 1;
+    static constexpr size_t COLUMNS = NUM_SPECIES + 2;
+
+    explicit SlidingWindowMetrics(double bucket_seconds = 60.0, size_t num_buckets = 1440)
+        : bucket_seconds_(bucket_seconds), num_buckets_(num_buckets) {
+        if (!(bucket_seconds > 0.0) || num_buckets == 0) {
+            throw std::invalid_argument("Metrics window needs a positive bucket width and at least one bucket");
+        }
+        cells_.assign(num_buckets_ * COLUMNS, 0);
+    }
+
+    double bucket_seconds() const { return bucket_seconds_; }
+    size_t num_buckets() const { return num_buckets_; }
+
+    void add_detections(double time, size_t species_id, size_t count) {
+        add_to_bucket(bucket_of(time), species_id, count);
+    }
+
+    void add_frames(double time, size_t analyzed, size_t skipped) {
+        int64_t bucket = bucket_of(time);
+        add_to_bucket(bucket, FRAMES_ANALYZED, analyzed);
+        add_to_bucket(bucket, FRAMES_SKIPPED, skipped);
+    }
+
+    // Expire buckets older than the ring as of time, even if nothing was recorded since
+    void advance(double time) { advance_to(bucket_of(time)); }
+
+    // Scores over the newest ceil(window_seconds / bucket_seconds) buckets as of now
+    // (0 = the whole ring)
+    WindowScores scores(double now, double window_seconds = 0.0) {
+        advance(now);
+        size_t buckets = num_buckets_;
+        if (window_seconds > 0.0) {
+            buckets = std::min(num_buckets_, std::max<size_t>(
+                1, static_cast<size_t>(std::ceil(window_seconds / bucket_seconds_))));
+        }
+
+        std::array<uint64_t, COLUMNS> sums{};
+        if (buckets == num_buckets_) {
+            sums = totals_;
+        } else {
+            for (size_t k = 0; k < buckets; ++k) {
+                const uint32_t* row = row_of(head_ - static_cast<int64_t>(k));
+                for (size_t column = 0; column < COLUMNS; ++column) {
+                    sums[column] += row[column];
+                }
+            }
+        }
+
+        WindowScores result;
+        result.window_seconds = buckets * bucket_seconds_;
+        result.frames_analyzed = sums[FRAMES_ANALYZED];
+        result.frames_skipped = sums[FRAMES_SKIPPED];
+
+        double count_log_count_sum = 0.0;
+        double conservation_sum = 0.0;
+        for (size_t id = 0; id < NUM_SPECIES; ++id) {
+            uint64_t count = sums[id];
+            result.species_counts[id] = count;
+            if (count == 0) {
+                continue;
+            }
+            result.total_detections += count;
+            result.species_richness++;
+            count_log_count_sum += count * std::log(static_cast<double>(count));
+            conservation_sum += count * SPECIES_TABLE[id].conservation_weight;
+        }
+        if (result.total_detections != 0) {
+            double total = static_cast<double>(result.total_detections);
+            result.biodiversity_index = std::max(0.0, std::log(total) - count_log_count_sum / total);
+            result.conservation_score = conservation_sum / total;
+        }
+        return result;
+    }
+
+    // Copy the ring oldest bucket first as of now into out (num_buckets x COLUMNS);
+    // returns the start time of the oldest bucket
+    double export_rows(double now, uint32_t* out) {
+        advance(now);
+        int64_t oldest = head_ - static_cast<int64_t>(num_buckets_) + 1;
+        for (size_t k = 0; k < num_buckets_; ++k) {
+            const uint32_t* row = row_of(oldest + static_cast<int64_t>(k));
+            std::copy(row, row + COLUMNS, out + k * COLUMNS);
+        }
+        return oldest * bucket_seconds_;
+    }
+
+    // The same rows with their shape, sized and filled in one call
+    WindowExport export_window(double now) {
+        WindowExport snapshot;
+        snapshot.bucket_seconds = bucket_seconds_;
+        snapshot.num_buckets = num_buckets_;
+        snapshot.cells.resize(num_buckets_ * COLUMNS);
+        snapshot.start_time = export_rows(now, snapshot.cells.data());
+        return snapshot;
+    }
+
+    void reset() {
+        std::fill(cells_.begin(), cells_.end(), 0);
+        totals_.fill(0);
+        head_ = NO_BUCKET;
+    }
+
+private:
+    static constexpr int64_t NO_BUCKET = std::numeric_limits<int64_t>::min();
+
+    double bucket_seconds_;
+    size_t num_buckets_;
+    std::vector<uint32_t> cells_;             // num_buckets x COLUMNS
+    std::array<uint64_t, COLUMNS> totals_{};  // Column sums over the live buckets
+    int64_t head_ = NO_BUCKET;                // Absolute index of the newest bucket
+
+    int64_t bucket_of(double time) const {
+        return static_cast<int64_t>(std::floor(time / bucket_seconds_));
+    }
+
+    uint32_t* row_of(int64_t bucket) {
+        int64_t n = static_cast<int64_t>(num_buckets_);
+        return cells_.data() + static_cast<size_t>(((bucket % n) + n) % n) * COLUMNS;
+    }
+
+    void advance_to(int64_t bucket) {
+        if (head_ == NO_BUCKET) {
+            head_ = bucket;
+            return;
+        }
+        if (bucket <= head_) {
+            return;
+        }
+        if (static_cast<uint64_t>(bucket - head_) >= num_buckets_) {
+            std::fill(cells_.begin(), cells_.end(), 0);
+            totals_.fill(0);
+        } else {
+            for (int64_t expired = head_ + 1; expired <= bucket; ++expired) {
+                uint32_t* row = row_of(expired);
+                for (size_t column = 0; column < COLUMNS; ++column) {
+                    totals_[column] -= row[column];
+                }
+                std::fill(row, row + COLUMNS, 0);
+            }
+        }
+        head_ = bucket;
+    }
+
+    // Late samples (clock stepped back) land in their own bucket while it is still in the ring
+    void add_to_bucket(int64_t bucket, size_t column, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        advance_to(bucket);
+        if (head_ - bucket >= static_cast<int64_t>(num_buckets_)) {
+            return;
+        }
+        row_of(bucket)[column] += static_cast<uint32_t>(count);
+        totals_[column] += count;
+    }
+};
@@ -0,0 +1,133 @@
+/*
+ * Bush Ears - Micro-batching dispatcher
+ * One native thread takes whatever requests have queued up (up to a batch limit)
+ * and hands them to a handler together, so many small concurrent submissions share
+ * one batched pass instead of each running at batch size 1
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Requests are handled in submission order. While a batch is being handled new
+// requests queue up and form the next batch, so batches grow with the load on
+// their own; max_wait additionally lets a short batch linger for more requests
+// (0 = dispatch immediately, lowest latency). At most capacity requests wait.
+template <typename Request>
+class MicroBatcher {
+public:
+    using Handler = std::function<void(std::vector<Request>&)>;
+
+    MicroBatcher(size_t max_batch, size_t capacity, std::chrono::microseconds max_wait, Handler handler)
+        : max_batch_(max_batch), capacity_(capacity), max_wait_(max_wait), handler_(std::move(handler)) {
+        if (max_batch == 0 || capacity == 0) {
+            throw std::invalid_argument("Batch size and queue capacity must be at least 1");
+        }
+        worker_ = std::thread([this] { run(); });
+    }
+
+    MicroBatcher(const MicroBatcher&) = delete;
+    MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+    ~MicroBatcher() { close(); }
+
+    size_t max_batch() const { return max_batch_; }
+    size_t capacity() const { return capacity_; }
+    std::chrono::microseconds max_wait() const { return max_wait_; }
+
+    // Queue a request without blocking; false (request left with the caller) when
+    // the queue is full or closed
+    bool try_submit(Request& request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_ || queue_.size() >= capacity_) {
+                return false;
+            }
+            queue_.push_back(std::move(request));
+        }
+        work_ready_.notify_one();
+        return true;
+    }
+
+    // Requests queued or being handled
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size() + in_flight_;
+    }
+
+    // Block until every request submitted so far has been handled
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [&] { return queue_.empty() && in_flight_ == 0; });
+    }
+
+    // Stop accepting requests, handle the ones already queued, and join the thread
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_ && !worker_.joinable()) {
+                return;
+            }
+            closed_ = true;
+        }
+        work_ready_.notify_one();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+private:
+    size_t max_batch_;
+    size_t capacity_;
+    std::chrono::microseconds max_wait_;
+    Handler handler_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable idle_;
+    std::deque<Request> queue_;
+    size_t in_flight_ = 0;  // Requests taken by the handler and not yet finished
+    bool closed_ = false;
+    std::thread worker_;
+
+    void run() {
+        std::vector<Request> batch;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            work_ready_.wait(lock, [&] { return closed_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;  // Closed and drained
+            }
+            if (max_wait_.count() > 0 && queue_.size() < max_batch_ && !closed_) {
+                auto deadline = std::chrono::steady_clock::now() + max_wait_;
+                work_ready_.wait_until(lock, deadline, [&] { return closed_ || queue_.size() >= max_batch_; });
+            }
+
+            size_t count = std::min(max_batch_, queue_.size());
+            batch.clear();
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+            in_flight_ = count;
+            lock.unlock();
+
+            handler_(batch);  // Must not throw: requests carry their own completion
+            batch.clear();
+
+            lock.lock();
+            in_flight_ = 0;
+            if (queue_.empty()) {
+                idle_.notify_all();
+            }
+        }
+    }
+};
@@ -0,0 +1,192 @@
+/*
+ * Bush Ears - Trained classifier model files
+ * Versioned binary format whose weights are memory-mapped and used in place, so
+ * loading is O(1) and every process on a host shares one page-cached copy
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::endian::native == std::endian::little, "Model files are little-endian");
+
+// File layout (all sections start on a 64-byte boundary):
+//   ModelFileHeader
+//   species map    uint8_t[output_dim]            AustralianSpecies id of each output unit
+//   hidden weights dtype[input_dim * hidden_dim]  row-major [input][hidden]
+//   output weights dtype[hidden_dim * output_dim] row-major [hidden][output]
+struct ModelFileHeader {
+    static constexpr std::array<char, 8> MAGIC = {'B', 'U', 'S', 'H', 'E', 'A', 'R', 'S'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t DTYPE_FLOAT64 = 0;
+    static constexpr uint32_t DTYPE_FLOAT32 = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t dtype;
+    uint32_t input_dim;
+    uint32_t hidden_dim;
+    uint32_t output_dim;
+    uint32_t reserved;
+    uint64_t species_offset;
+    uint64_t hidden_offset;
+    uint64_t output_offset;
+    uint64_t file_size;
+};
+
+static_assert(sizeof(ModelFileHeader) == 64, "Header must stay exactly one cache line");
+
+// Header dtype code of a weight type
+template <typename Weight>
+constexpr uint32_t model_dtype() {
+    static_assert(std::is_same_v<Weight, double> || std::is_same_v<Weight, float>,
+                  "Model weights are float64 or float32");
+    return std::is_same_v<Weight, double> ? ModelFileHeader::DTYPE_FLOAT64 : ModelFileHeader::DTYPE_FLOAT32;
+}
+
+inline size_t model_dtype_size(uint32_t dtype) {
+    return dtype == ModelFileHeader::DTYPE_FLOAT32 ? sizeof(float) : sizeof(double);
+}
+
+// Read-only mapping of a validated model file
+class MappedModelFile {
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    explicit MappedModelFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open model file " + path + ": " + std::strerror(errno));
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(ModelFileHeader))) {
+            ::close(fd);
+            throw std::runtime_error("Model file " + path + " is truncated");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // The mapping keeps the file referenced
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Cannot map model file " + path + ": " + std::strerror(errno));
+        }
+        data_ = static_cast<const unsigned char*>(mapping);
+
+        try {
+            validate(path);
+        } catch (...) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+            throw;
+        }
+    }
+
+    MappedModelFile(const MappedModelFile&) = delete;
+    MappedModelFile& operator=(const MappedModelFile&) = delete;
+
+    ~MappedModelFile() {
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+    }
+
+    const ModelFileHeader& header() const {
+        return *reinterpret_cast<const ModelFileHeader*>(data_);
+    }
+
+    const uint8_t* species_map() const { return data_ + header().species_offset; }
+
+    // Weights as stored; Weight must match header().dtype
+    template <typename Weight>
+    const Weight* hidden_weights() const {
+        return reinterpret_cast<const Weight*>(data_ + header().hidden_offset);
+    }
+
+    template <typename Weight>
+    const Weight* output_weights() const {
+        return reinterpret_cast<const Weight*>(data_ + header().output_offset);
+    }
+
+private:
+    void validate(const std::string& path) const {
+        const ModelFileHeader& h = header();
+        if (h.magic != ModelFileHeader::MAGIC) {
+            throw std::runtime_error(path + " is not a Bush Ears model file");
+        }
+        if (h.version != ModelFileHeader::VERSION) {
+            throw std::runtime_error("Unsupported model file version " + std::to_string(h.version));
+        }
+        if (h.dtype != ModelFileHeader::DTYPE_FLOAT64 && h.dtype != ModelFileHeader::DTYPE_FLOAT32) {
+            throw std::runtime_error("Unsupported model weight dtype " + std::to_string(h.dtype));
+        }
+        if (h.file_size != size_) {
+            throw std::runtime_error("Model file " + path + " is truncated");
+        }
+
+        // count elements of element_size bytes at offset; written so that no header
+        // value, however large, can wrap the bounds arithmetic
+        auto check_section = [&](uint64_t offset, uint64_t count, uint64_t element_size) {
+            if (offset % 64 != 0 || offset < sizeof(ModelFileHeader) || offset > size_ ||
+                count > (size_ - offset) / element_size) {
+                throw std::runtime_error("Model file " + path + " has a corrupt section table");
+            }
+        };
+        check_section(h.species_offset, h.output_dim, 1);
+        uint64_t weight_size = model_dtype_size(h.dtype);
+        check_section(h.hidden_offset, uint64_t{h.input_dim} * h.hidden_dim, weight_size);
+        check_section(h.output_offset, uint64_t{h.hidden_dim} * h.output_dim, weight_size);
+    }
+};
+
+// Write a model file; weights are row-major as in the section table above and
+// their type (double or float) sets the file dtype
+template <typename Weight>
+void write_model_file(const std::string& path,
+                      uint32_t input_dim, uint32_t hidden_dim, uint32_t output_dim,
+                      const uint8_t* species_map,
+                      const Weight* hidden_weights,
+                      const Weight* output_weights) {
+    auto align = [](uint64_t offset) { return (offset + 63) & ~uint64_t{63}; };
+
+    ModelFileHeader header{};
+    header.magic = ModelFileHeader::MAGIC;
+    header.version = ModelFileHeader::VERSION;
+    header.dtype = model_dtype<Weight>();
+    header.input_dim = input_dim;
+    header.hidden_dim = hidden_dim;
+    header.output_dim = output_dim;
+    header.species_offset = sizeof(ModelFileHeader);
+    header.hidden_offset = align(header.species_offset + output_dim);
+    header.output_offset = align(header.hidden_offset + uint64_t{input_dim} * hidden_dim * sizeof(Weight));
+    header.file_size = header.output_offset + uint64_t{hidden_dim} * output_dim * sizeof(Weight);
+
+    std::vector<unsigned char> image(header.file_size, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + header.species_offset, species_map, output_dim);
+    std::memcpy(image.data() + header.hidden_offset, hidden_weights,
+                size_t{input_dim} * hidden_dim * sizeof(Weight));
+    std::memcpy(image.data() + header.output_offset, output_weights,
+                size_t{hidden_dim} * output_dim * sizeof(Weight));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write model file " + path);
+    }
+}
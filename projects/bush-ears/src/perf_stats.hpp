@@ -0,0 +1,280 @@
+/*
+ * Bush Ears - Hot-path instrumentation
+ * Per-stage latency histograms sharded per thread, so recording a sample is a few
+ * relaxed atomic adds on a cache line no other thread writes. Build with
+ * BUSH_EARS_PERF_STATS=0 to compile every timer out.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifndef BUSH_EARS_PERF_STATS
+#define BUSH_EARS_PERF_STATS 1
+#endif
+
+// Pipeline stages; Chunk is one whole streaming call (or submitted batch), end to
+// end, and Submit one submitted chunk from submission until its result is ready
+enum class PerfStage : uint8_t {
+    Window,
+    Fft,
+    Features,
+    Inference,
+    Metrics,
+    Chunk,
+    Submit,
+};
+
+inline constexpr size_t NUM_PERF_STAGES = 7;
+inline constexpr std::array<const char*, NUM_PERF_STAGES> PERF_STAGE_NAMES = {
+    "window", "fft", "features", "inference", "metrics", "chunk", "submit"};
+
+// HDR-style log-linear buckets over nanoseconds: exact below 2 * SUB_BUCKETS, then
+// SUB_BUCKETS per power of two (at most ~3% relative error) up to 2^MAX_EXPONENT ns
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BITS;
+    static constexpr unsigned MAX_EXPONENT = 40;  // About 18 minutes
+    static constexpr size_t NUM_BUCKETS = (MAX_EXPONENT - SUB_BITS + 1) * SUB_BUCKETS;
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_EXPONENT) - 1;
+
+    static constexpr size_t bucket_index(uint64_t ns) {
+        ns = std::min(ns, MAX_VALUE);
+        unsigned msb = 63u - static_cast<unsigned>(std::countl_zero(ns | 1));
+        unsigned shift = msb > SUB_BITS ? msb - SUB_BITS : 0;
+        return shift * SUB_BUCKETS + (ns >> shift);
+    }
+
+    // Largest value that lands in the bucket
+    static constexpr uint64_t bucket_upper(size_t index) {
+        unsigned shift = index < 2 * SUB_BUCKETS ? 0 : static_cast<unsigned>(index / SUB_BUCKETS - 1);
+        uint64_t lower = (index - shift * SUB_BUCKETS) << shift;
+        return lower + (uint64_t(1) << shift) - 1;
+    }
+
+    void record(uint64_t ns) {
+        counts_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Add this histogram's counts into a plain one
+    void merge_into(std::vector<uint64_t>& counts, uint64_t& sum, uint64_t& max) const {
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            counts[i] += counts_[i].load(std::memory_order_relaxed);
+        }
+        sum += sum_.load(std::memory_order_relaxed);
+        max = std::max(max, max_.load(std::memory_order_relaxed));
+    }
+
+    void reset() {
+        for (auto& count : counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts_{};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+// Merged view of one stage, in nanoseconds
+struct LatencySummary {
+    uint64_t count = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+};
+
+// Stage histograms plus throughput counters for one monitor. Each thread records
+// into its own shard (created on first use); readers merge the shards, so values
+// recorded during a snapshot may or may not be included.
+class PerfStats {
+private:
+    static constexpr size_t MAX_SHARDS = 32;  // Threads beyond this share shards
+
+    struct alignas(64) Shard {
+        std::array<LatencyHistogram, NUM_PERF_STAGES> stages;
+        std::atomic<uint64_t> audio_ns{0};  // Duration of the audio the chunks carried
+    };
+
+    std::array<std::atomic<Shard*>, MAX_SHARDS> shards_{};
+
+public:
+    PerfStats() = default;
+    PerfStats(const PerfStats&) = delete;
+    PerfStats& operator=(const PerfStats&) = delete;
+
+    ~PerfStats() {
+        for (auto& shard : shards_) {
+            delete shard.load(std::memory_order_relaxed);
+        }
+    }
+
+    static constexpr bool compiled_in() { return BUSH_EARS_PERF_STATS != 0; }
+
+    void record(PerfStage stage, uint64_t ns) {
+        local_shard().stages[static_cast<size_t>(stage)].record(ns);
+    }
+
+    // One streaming call that carried audio_ns of audio took elapsed_ns
+    void record_chunk(uint64_t elapsed_ns, uint64_t audio_ns) {
+        Shard& shard = local_shard();
+        shard.stages[static_cast<size_t>(PerfStage::Chunk)].record(elapsed_ns);
+        shard.audio_ns.fetch_add(audio_ns, std::memory_order_relaxed);
+    }
+
+    LatencySummary summary(PerfStage stage) const {
+        std::vector<uint64_t> counts(LatencyHistogram::NUM_BUCKETS, 0);
+        LatencySummary result;
+        uint64_t sum = 0;
+        for_each_shard([&](const Shard& shard) {
+            shard.stages[static_cast<size_t>(stage)].merge_into(counts, sum, result.max);
+        });
+        for (uint64_t count : counts) {
+            result.count += count;
+        }
+        if (result.count == 0) {
+            return result;
+        }
+        result.mean = static_cast<double>(sum) / result.count;
+        result.p50 = percentile(counts, result.count, 0.5, result.max);
+        result.p99 = percentile(counts, result.count, 0.99, result.max);
+        result.p999 = percentile(counts, result.count, 0.999, result.max);
+        return result;
+    }
+
+    uint64_t audio_ns() const {
+        uint64_t total = 0;
+        for_each_shard([&](const Shard& shard) { total += shard.audio_ns.load(std::memory_order_relaxed); });
+        return total;
+    }
+
+    void reset() {
+        for (auto& slot : shards_) {
+            if (Shard* shard = slot.load(std::memory_order_acquire)) {
+                for (auto& stage : shard->stages) {
+                    stage.reset();
+                }
+                shard->audio_ns.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    template <typename Fn>
+    void for_each_shard(Fn&& fn) const {
+        for (const auto& slot : shards_) {
+            if (const Shard* shard = slot.load(std::memory_order_acquire)) {
+                fn(*shard);
+            }
+        }
+    }
+
+    // Threads are numbered once per process, so a thread uses the same slot in every monitor
+    Shard& local_shard() {
+        static std::atomic<size_t> next_slot{0};
+        thread_local size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed) % MAX_SHARDS;
+
+        Shard* shard = shards_[slot].load(std::memory_order_acquire);
+        if (!shard) {
+            auto fresh = std::make_unique<Shard>();
+            if (shards_[slot].compare_exchange_strong(shard, fresh.get(), std::memory_order_acq_rel)) {
+                shard = fresh.release();
+            }
+        }
+        return *shard;
+    }
+
+    // Upper edge of the bucket holding the rank-th value, never above the true max
+    static uint64_t percentile(const std::vector<uint64_t>& counts, uint64_t total, double quantile,
+                               uint64_t max) {
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * total)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(LatencyHistogram::bucket_upper(i), max);
+            }
+        }
+        return max;
+    }
+};
+
+// A start time taken in one place and charged in another (e.g. from submission to
+// result); empty when instrumentation is compiled out
+struct PerfStamp {
+#if BUSH_EARS_PERF_STATS
+    std::chrono::steady_clock::time_point time;
+
+    static PerfStamp now() { return {std::chrono::steady_clock::now()}; }
+#else
+    static PerfStamp now() { return {}; }
+#endif
+};
+
+// Laps successive pipeline stages of one frame or call. Does nothing without a
+// PerfStats, and nothing at all when instrumentation is compiled out.
+class StageTimer {
+#if BUSH_EARS_PERF_STATS
+private:
+    PerfStats* stats_;
+    std::chrono::steady_clock::time_point last_;
+
+public:
+    explicit StageTimer(PerfStats* stats) : stats_(stats) {
+        if (stats_) {
+            last_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    // First lap measured from start instead of construction
+    StageTimer(PerfStats* stats, PerfStamp start) : stats_(stats), last_(start.time) {}
+
+    // Time since construction or the previous lap, charged to stage
+    void lap(PerfStage stage) {
+        if (stats_) {
+            auto now = std::chrono::steady_clock::now();
+            stats_->record(stage, elapsed_ns(now));
+            last_ = now;
+        }
+    }
+
+    // Time since construction or the previous lap, as one chunk carrying audio_ns of audio
+    void lap_chunk(uint64_t audio_ns) {
+        if (stats_) {
+            auto now = std::chrono::steady_clock::now();
+            stats_->record_chunk(elapsed_ns(now), audio_ns);
+            last_ = now;
+        }
+    }
+
+private:
+    uint64_t elapsed_ns(std::chrono::steady_clock::time_point now) const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count());
+    }
+#else
+public:
+    explicit StageTimer(PerfStats*) {}
+    StageTimer(PerfStats*, PerfStamp) {}
+    void lap(PerfStage) {}
+    void lap_chunk(uint64_t) {}
+#endif
+};
@@ -0,0 +1,254 @@
+/*
+ * Bush Ears - Vectorized spectral feature kernels
+ * AVX2 (x86-64) and NEON (AArch64) implementations chosen once at load time, so one
+ * portable build runs the widest kernel the host supports
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BUSH_EARS_HAVE_AVX2_KERNELS 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define BUSH_EARS_HAVE_NEON_KERNELS 1
+#endif
+
+// Build AVX2 and baseline clones of an auto-vectorized hot loop; the loader
+// picks one per host through an ELF ifunc
+#if defined(BUSH_EARS_HAVE_AVX2_KERNELS) && defined(__linux__)
+#define BUSH_EARS_MULTIVERSION __attribute__((target_clones("avx2", "default")))
+#else
+#define BUSH_EARS_MULTIVERSION
+#endif
+
+// Magnitude-weighted frequency moments of a spectrum; accumulated range by range
+// so band energies fall out of the same pass as differences of magnitude_sum
+struct SpectralMoments {
+    double magnitude_sum = 0.0;
+    double weighted_freq_sum = 0.0;     // sum(f * m)
+    double weighted_freq_sq_sum = 0.0;  // sum(f^2 * m)
+};
+
+using SpectralMomentsKernel = void (*)(const double* magnitude, const double* freq,
+                                       size_t first, size_t last, SpectralMoments& acc);
+using SpectralMomentsKernelF32 = void (*)(const float* magnitude, const float* freq,
+                                          size_t first, size_t last, SpectralMoments& acc);
+
+inline void accumulate_spectral_moments_scalar(const double* magnitude, const double* freq,
+                                               size_t first, size_t last, SpectralMoments& acc) {
+    double m_sum = 0.0, fm_sum = 0.0, ffm_sum = 0.0;
+    for (size_t i = first; i < last; ++i) {
+        double fm = freq[i] * magnitude[i];
+        m_sum += magnitude[i];
+        fm_sum += fm;
+        ffm_sum += freq[i] * fm;
+    }
+    acc.magnitude_sum += m_sum;
+    acc.weighted_freq_sum += fm_sum;
+    acc.weighted_freq_sq_sum += ffm_sum;
+}
+
+// float32 spectra accumulate in float within a band range and in double across ranges
+inline void accumulate_spectral_moments_scalar_f32(const float* magnitude, const float* freq,
+                                                   size_t first, size_t last, SpectralMoments& acc) {
+    float m_sum = 0.0f, fm_sum = 0.0f, ffm_sum = 0.0f;
+    for (size_t i = first; i < last; ++i) {
+        float fm = freq[i] * magnitude[i];
+        m_sum += magnitude[i];
+        fm_sum += fm;
+        ffm_sum += freq[i] * fm;
+    }
+    acc.magnitude_sum += m_sum;
+    acc.weighted_freq_sum += fm_sum;
+    acc.weighted_freq_sq_sum += ffm_sum;
+}
+
+#if defined(BUSH_EARS_HAVE_AVX2_KERNELS)
+__attribute__((target("avx2,fma")))
+inline double horizontal_sum_avx2(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    __m128d pair = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2,fma")))
+inline void accumulate_spectral_moments_avx2(const double* magnitude, const double* freq,
+                                             size_t first, size_t last, SpectralMoments& acc) {
+    // Two independent accumulator sets hide the add latency
+    __m256d m_a = _mm256_setzero_pd(), m_b = _mm256_setzero_pd();
+    __m256d fm_a = _mm256_setzero_pd(), fm_b = _mm256_setzero_pd();
+    __m256d ffm_a = _mm256_setzero_pd(), ffm_b = _mm256_setzero_pd();
+
+    size_t i = first;
+    for (; i + 8 <= last; i += 8) {
+        __m256d m0 = _mm256_loadu_pd(magnitude + i);
+        __m256d m1 = _mm256_loadu_pd(magnitude + i + 4);
+        __m256d f0 = _mm256_loadu_pd(freq + i);
+        __m256d f1 = _mm256_loadu_pd(freq + i + 4);
+        __m256d fm0 = _mm256_mul_pd(f0, m0);
+        __m256d fm1 = _mm256_mul_pd(f1, m1);
+        m_a = _mm256_add_pd(m_a, m0);
+        m_b = _mm256_add_pd(m_b, m1);
+        fm_a = _mm256_add_pd(fm_a, fm0);
+        fm_b = _mm256_add_pd(fm_b, fm1);
+        ffm_a = _mm256_fmadd_pd(f0, fm0, ffm_a);
+        ffm_b = _mm256_fmadd_pd(f1, fm1, ffm_b);
+    }
+
+    acc.magnitude_sum += horizontal_sum_avx2(_mm256_add_pd(m_a, m_b));
+    acc.weighted_freq_sum += horizontal_sum_avx2(_mm256_add_pd(fm_a, fm_b));
+    acc.weighted_freq_sq_sum += horizontal_sum_avx2(_mm256_add_pd(ffm_a, ffm_b));
+
+    accumulate_spectral_moments_scalar(magnitude, freq, i, last, acc);
+}
+
+__attribute__((target("avx2,fma")))
+inline double horizontal_sum_avx2(__m256 v) {
+    __m128 pair = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    pair = _mm_add_ps(pair, _mm_movehl_ps(pair, pair));
+    return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+}
+
+__attribute__((target("avx2,fma")))
+inline void accumulate_spectral_moments_avx2_f32(const float* magnitude, const float* freq,
+                                                 size_t first, size_t last, SpectralMoments& acc) {
+    __m256 m_a = _mm256_setzero_ps(), m_b = _mm256_setzero_ps();
+    __m256 fm_a = _mm256_setzero_ps(), fm_b = _mm256_setzero_ps();
+    __m256 ffm_a = _mm256_setzero_ps(), ffm_b = _mm256_setzero_ps();
+
+    size_t i = first;
+    for (; i + 16 <= last; i += 16) {
+        __m256 m0 = _mm256_loadu_ps(magnitude + i);
+        __m256 m1 = _mm256_loadu_ps(magnitude + i + 8);
+        __m256 f0 = _mm256_loadu_ps(freq + i);
+        __m256 f1 = _mm256_loadu_ps(freq + i + 8);
+        __m256 fm0 = _mm256_mul_ps(f0, m0);
+        __m256 fm1 = _mm256_mul_ps(f1, m1);
+        m_a = _mm256_add_ps(m_a, m0);
+        m_b = _mm256_add_ps(m_b, m1);
+        fm_a = _mm256_add_ps(fm_a, fm0);
+        fm_b = _mm256_add_ps(fm_b, fm1);
+        ffm_a = _mm256_fmadd_ps(f0, fm0, ffm_a);
+        ffm_b = _mm256_fmadd_ps(f1, fm1, ffm_b);
+    }
+
+    acc.magnitude_sum += horizontal_sum_avx2(_mm256_add_ps(m_a, m_b));
+    acc.weighted_freq_sum += horizontal_sum_avx2(_mm256_add_ps(fm_a, fm_b));
+    acc.weighted_freq_sq_sum += horizontal_sum_avx2(_mm256_add_ps(ffm_a, ffm_b));
+
+    accumulate_spectral_moments_scalar_f32(magnitude, freq, i, last, acc);
+}
+#endif
+
+#if defined(BUSH_EARS_HAVE_NEON_KERNELS)
+inline void accumulate_spectral_moments_neon(const double* magnitude, const double* freq,
+                                             size_t first, size_t last, SpectralMoments& acc) {
+    float64x2_t m_a = vdupq_n_f64(0.0), m_b = vdupq_n_f64(0.0);
+    float64x2_t fm_a = vdupq_n_f64(0.0), fm_b = vdupq_n_f64(0.0);
+    float64x2_t ffm_a = vdupq_n_f64(0.0), ffm_b = vdupq_n_f64(0.0);
+
+    size_t i = first;
+    for (; i + 4 <= last; i += 4) {
+        float64x2_t m0 = vld1q_f64(magnitude + i);
+        float64x2_t m1 = vld1q_f64(magnitude + i + 2);
+        float64x2_t f0 = vld1q_f64(freq + i);
+        float64x2_t f1 = vld1q_f64(freq + i + 2);
+        float64x2_t fm0 = vmulq_f64(f0, m0);
+        float64x2_t fm1 = vmulq_f64(f1, m1);
+        m_a = vaddq_f64(m_a, m0);
+        m_b = vaddq_f64(m_b, m1);
+        fm_a = vaddq_f64(fm_a, fm0);
+        fm_b = vaddq_f64(fm_b, fm1);
+        ffm_a = vfmaq_f64(ffm_a, f0, fm0);
+        ffm_b = vfmaq_f64(ffm_b, f1, fm1);
+    }
+
+    acc.magnitude_sum += vaddvq_f64(vaddq_f64(m_a, m_b));
+    acc.weighted_freq_sum += vaddvq_f64(vaddq_f64(fm_a, fm_b));
+    acc.weighted_freq_sq_sum += vaddvq_f64(vaddq_f64(ffm_a, ffm_b));
+
+    accumulate_spectral_moments_scalar(magnitude, freq, i, last, acc);
+}
+
+inline void accumulate_spectral_moments_neon_f32(const float* magnitude, const float* freq,
+                                                 size_t first, size_t last, SpectralMoments& acc) {
+    float32x4_t m_a = vdupq_n_f32(0.0f), m_b = vdupq_n_f32(0.0f);
+    float32x4_t fm_a = vdupq_n_f32(0.0f), fm_b = vdupq_n_f32(0.0f);
+    float32x4_t ffm_a = vdupq_n_f32(0.0f), ffm_b = vdupq_n_f32(0.0f);
+
+    size_t i = first;
+    for (; i + 8 <= last; i += 8) {
+        float32x4_t m0 = vld1q_f32(magnitude + i);
+        float32x4_t m1 = vld1q_f32(magnitude + i + 4);
+        float32x4_t f0 = vld1q_f32(freq + i);
+        float32x4_t f1 = vld1q_f32(freq + i + 4);
+        float32x4_t fm0 = vmulq_f32(f0, m0);
+        float32x4_t fm1 = vmulq_f32(f1, m1);
+        m_a = vaddq_f32(m_a, m0);
+        m_b = vaddq_f32(m_b, m1);
+        fm_a = vaddq_f32(fm_a, fm0);
+        fm_b = vaddq_f32(fm_b, fm1);
+        ffm_a = vfmaq_f32(ffm_a, f0, fm0);
+        ffm_b = vfmaq_f32(ffm_b, f1, fm1);
+    }
+
+    acc.magnitude_sum += vaddvq_f32(vaddq_f32(m_a, m_b));
+    acc.weighted_freq_sum += vaddvq_f32(vaddq_f32(fm_a, fm_b));
+    acc.weighted_freq_sq_sum += vaddvq_f32(vaddq_f32(ffm_a, ffm_b));
+
+    accumulate_spectral_moments_scalar_f32(magnitude, freq, i, last, acc);
+}
+#endif
+
+// Name of the kernel selected for this host
+inline const char* simd_backend() {
+#if defined(BUSH_EARS_HAVE_AVX2_KERNELS)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return "avx2";
+    }
+#elif defined(BUSH_EARS_HAVE_NEON_KERNELS)
+    return "neon";
+#endif
+    return "scalar";
+}
+
+inline SpectralMomentsKernel select_spectral_moments_kernel() {
+#if defined(BUSH_EARS_HAVE_AVX2_KERNELS)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return accumulate_spectral_moments_avx2;
+    }
+#elif defined(BUSH_EARS_HAVE_NEON_KERNELS)
+    return accumulate_spectral_moments_neon;
+#endif
+    return accumulate_spectral_moments_scalar;
+}
+
+inline SpectralMomentsKernelF32 select_spectral_moments_kernel_f32() {
+#if defined(BUSH_EARS_HAVE_AVX2_KERNELS)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return accumulate_spectral_moments_avx2_f32;
+    }
+#elif defined(BUSH_EARS_HAVE_NEON_KERNELS)
+    return accumulate_spectral_moments_neon_f32;
+#endif
+    return accumulate_spectral_moments_scalar_f32;
+}
+
+// Resolved once when the module loads
+inline const SpectralMomentsKernel accumulate_spectral_moments_f64 = select_spectral_moments_kernel();
+inline const SpectralMomentsKernelF32 accumulate_spectral_moments_f32 = select_spectral_moments_kernel_f32();
+
+// Precision-dispatching entry point used by the feature extractors
+inline void accumulate_spectral_moments(const double* magnitude, const double* freq,
+                                        size_t first, size_t last, SpectralMoments& acc) {
+    accumulate_spectral_moments_f64(magnitude, freq, first, last, acc);
+}
+
+inline void accumulate_spectral_moments(const float* magnitude, const float* freq,
+                                        size_t first, size_t last, SpectralMoments& acc) {
+    accumulate_spectral_moments_f32(magnitude, freq, first, last, acc);
+}
@@ -0,0 +1,141 @@
+/*
+ * Bush Ears - Spectrogram output modes
+ * Cropping, time / frequency pooling and scaling to magnitude, power, dB or uint8,
+ * applied per frame so long recordings come back as a small, display-ready array
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+enum class SpectrogramScale { Magnitude, Power, Decibels };
+
+// Parameters of one spectrogram output. Pooling averages power over
+// time_decimation frames by freq_decimation bins; decibels are relative to a
+// full-scale sine (dBFS), and uint8 output maps [min_db, max_db] onto [0, 255].
+struct SpectrogramConfig {
+    SpectrogramScale scale = SpectrogramScale::Magnitude;
+    double min_hz = 0.0;
+    double max_hz = 0.0;  // 0 means Nyquist
+    size_t time_decimation = 1;
+    size_t freq_decimation = 1;
+    double min_db = -80.0;
+    double max_db = 0.0;
+
+    bool operator==(const SpectrogramConfig&) const = default;
+};
+
+// Output geometry of a SpectrogramConfig for one (sample rate, FFT size), plus the
+// per-row conversion from pooled power sums to the output type
+class SpectrogramLayout {
+private:
+    static constexpr double POWER_FLOOR = 1e-20;  // -200 dB, keeps log10() finite on silence
+
+    SpectrogramConfig config_;
+    size_t first_bin_ = 0;
+    size_t last_bin_ = 0;  // Exclusive
+    size_t columns_ = 0;
+    double reference_power_ = 1.0;
+
+public:
+    // reference_power: power of a full-scale sine's peak bin, i.e. 0 dBFS
+    SpectrogramLayout(double sample_rate, size_t fft_size, const SpectrogramConfig& config,
+                      double reference_power)
+        : config_(config), reference_power_(reference_power) {
+        double nyquist = sample_rate / 2.0;
+        if (config_.max_hz == 0.0) {
+            config_.max_hz = nyquist;
+        }
+        if (config_.min_hz < 0.0 || config_.max_hz > nyquist || config_.min_hz >= config_.max_hz) {
+            throw std::invalid_argument("Spectrogram range must satisfy 0 <= min_hz < max_hz <= Nyquist");
+        }
+        if (config_.time_decimation == 0 || config_.freq_decimation == 0) {
+            throw std::invalid_argument("Spectrogram decimation factors must be at least 1");
+        }
+        if (!(config_.min_db < config_.max_db)) {
+            throw std::invalid_argument("Spectrogram dB range must satisfy min_db < max_db");
+        }
+
+        // Bins whose centre frequency lies in [min_hz, max_hz]
+        double bin_hz = sample_rate / fft_size;
+        size_t num_bins = fft_size / 2 + 1;
+        first_bin_ = std::min(num_bins, static_cast<size_t>(std::ceil(config_.min_hz / bin_hz)));
+        last_bin_ = std::min(num_bins, static_cast<size_t>(std::floor(config_.max_hz / bin_hz)) + 1);
+        if (first_bin_ >= last_bin_) {
+            throw std::invalid_argument("Spectrogram range contains no frequency bins");
+        }
+        columns_ = (last_bin_ - first_bin_ + config_.freq_decimation - 1) / config_.freq_decimation;
+    }
+
+    const SpectrogramConfig& config() const { return config_; }
+    size_t first_bin() const { return first_bin_; }
+    size_t last_bin() const { return last_bin_; }
+    size_t columns() const { return columns_; }
+
+    // Output rows for num_frames analysis frames; a partial last block still gets a row
+    size_t rows(size_t num_frames) const {
+        return (num_frames + config_.time_decimation - 1) / config_.time_decimation;
+    }
+
+    // Add one frame's power spectrum (indexed by FFT bin) into the row's column sums
+    template <typename Real>
+    void accumulate(const Real* power, double* sums) const {
+        size_t decimation = config_.freq_decimation;
+        for (size_t column = 0; column < columns_; ++column) {
+            size_t first = first_bin_ + column * decimation;
+            size_t last = std::min(first + decimation, last_bin_);
+            double sum = 0.0;
+            for (size_t bin = first; bin < last; ++bin) {
+                sum += power[bin];
+            }
+            sums[column] += sum;
+        }
+    }
+
+    // Mean power of each column over frames pooled frames, in the configured scale.
+    // uint8 output quantizes decibels and requires SpectrogramScale::Decibels.
+    template <typename Out>
+    void write_row(const double* sums, size_t frames, Out* row) const {
+        if constexpr (std::is_same_v<Out, uint8_t>) {
+            double scale = 1.0 / (config_.max_db - config_.min_db);
+            for_each_mean(sums, frames, row, [&](double power) {
+                double position = (decibels(power) - config_.min_db) * scale;
+                return static_cast<uint8_t>(std::lround(std::clamp(position, 0.0, 1.0) * 255.0));
+            });
+        } else {
+            switch (config_.scale) {
+                case SpectrogramScale::Magnitude:
+                    for_each_mean(sums, frames, row, [](double power) { return static_cast<Out>(std::sqrt(power)); });
+                    break;
+                case SpectrogramScale::Power:
+                    for_each_mean(sums, frames, row, [](double power) { return static_cast<Out>(power); });
+                    break;
+                case SpectrogramScale::Decibels:
+                    for_each_mean(sums, frames, row, [&](double power) { return static_cast<Out>(decibels(power)); });
+                    break;
+            }
+        }
+    }
+
+private:
+    // row[column] = convert(mean power of the column), dispatched once per row
+    template <typename Out, typename Convert>
+    void for_each_mean(const double* sums, size_t frames, Out* row, Convert convert) const {
+        size_t decimation = config_.freq_decimation;
+        size_t num_bins = last_bin_ - first_bin_;
+        for (size_t column = 0; column < columns_; ++column) {
+            size_t bins = std::min(decimation, num_bins - column * decimation);
+            row[column] = convert(sums[column] / static_cast<double>(frames * bins));
+        }
+    }
+
+    double decibels(double power) const {
+        return 10.0 * std::log10(std::max(power / reference_power_, POWER_FLOOR));
+    }
+};
@@ -0,0 +1,130 @@
+/*
+ * Bush Ears - Synthetic audio engine
+ * Closed-form FM voices and counter-based noise: any range of output samples can be
+ * rendered on its own, so chunks run in parallel and match a serial render exactly
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "spectral_kernels.hpp"
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"): a
+// keyed bijection of a 128-bit counter, so the value for sample i is a pure function
+// of (key, i) with no generator state to carry between chunks
+struct Philox4x32 {
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static constexpr uint32_t M0 = 0xD2511F53;
+    static constexpr uint32_t M1 = 0xCD9E8D57;
+    static constexpr uint32_t W0 = 0x9E3779B9;  // Key schedule (golden ratio)
+    static constexpr uint32_t W1 = 0xBB67AE85;  // sqrt(3) - 1
+
+    static constexpr Counter generate(Counter counter, Key key) {
+        for (int round = 0; round < 10; ++round) {
+            uint64_t product0 = uint64_t(M0) * counter[0];
+            uint64_t product1 = uint64_t(M1) * counter[2];
+            counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                       static_cast<uint32_t>(product1),
+                       static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                       static_cast<uint32_t>(product0)};
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return counter;
+    }
+};
+
+// sin(2 pi x): reduce to [-1/4, 1/4] cycles (sin(pi - y) = sin(y) folds the outer
+// quarters), then an odd Taylor polynomial through y^13 (error below 1e-9).
+// Branch-free, so loops calling it vectorize.
+inline double sin_2pi(double x) {
+    x -= std::floor(x + 0.5);                                   // [-1/2, 1/2)
+    x = std::copysign(0.25 - std::abs(std::abs(x) - 0.25), x);  // [-1/4, 1/4]
+    double y = 2.0 * M_PI * x;
+    double y2 = y * y;
+    return y * (1.0 + y2 * (-1.0 / 6.0 + y2 * (1.0 / 120.0 + y2 * (-1.0 / 5040.0 +
+               y2 * (1.0 / 362880.0 + y2 * (-1.0 / 39916800.0 + y2 * (1.0 / 6227020800.0)))))));
+}
+
+// One call: frequency carrier + deviation * sin(2 pi rate n) (cycles per sample) under
+// a linear attack / release envelope. The phase is the closed-form integral of that
+// frequency rather than a running sum, so it is exact at every sample.
+struct FmVoice {
+    size_t start = 0;       // First output sample
+    size_t length = 0;      // Samples
+    double carrier = 0.0;
+    double deviation = 0.0;
+    double rate = 0.0;
+    double attack = 1.0;    // Samples
+    double release = 1.0;   // Samples
+    double gain = 1.0;
+};
+
+// Add the voice's samples that fall in output [first, first + count) to out[0, count)
+BUSH_EARS_MULTIVERSION
+inline void render_voice(const FmVoice& voice, size_t first, size_t count, double* out) {
+    constexpr size_t BLOCK = 4096;  // Keeps in-block offsets small and int-indexed
+    size_t begin = std::max(first, voice.start);
+    size_t end = std::min(first + count, voice.start + voice.length);
+    // Locals, since out could otherwise alias the voice's fields and block vectorization
+    const double carrier = voice.carrier, rate = voice.rate, gain = voice.gain;
+    const double inv_attack = 1.0 / voice.attack, inv_release = 1.0 / voice.release;
+    const double length = static_cast<double>(voice.length);
+    // Phase = carrier * n + depth * (1 - cos(2 pi rate n))
+    const double depth = rate > 0.0 ? voice.deviation / (2.0 * M_PI * rate) : 0.0;
+
+    for (size_t block = begin; block < end; block += BLOCK) {
+        size_t n0 = block - voice.start;
+        double carrier_base = carrier * n0;
+        carrier_base -= std::floor(carrier_base);
+        double rate_base = rate * n0 + 0.25;  // cos as a quarter-cycle-shifted sin
+        rate_base -= std::floor(rate_base);
+        double start = static_cast<double>(n0);
+
+        int samples = static_cast<int>(std::min(BLOCK, end - block));
+        double* dst = out + (block - first);
+        for (int k = 0; k < samples; ++k) {
+            double n = start + k;
+            double phase = carrier_base + carrier * k + depth * (1.0 - sin_2pi(rate_base + rate * k));
+            double envelope = std::min(std::min(1.0, n * inv_attack), (length - n) * inv_release);
+            dst[k] += gain * envelope * sin_2pi(phase);
+        }
+    }
+}
+
+// Add uniform noise in [-amplitude, amplitude) to output [first, first + count);
+// sample i takes lane i % 4 of the Philox block for counter i / 4
+BUSH_EARS_MULTIVERSION
+inline void add_uniform_noise(uint64_t seed, double amplitude, size_t first, size_t count, double* out) {
+    const Philox4x32::Key key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    const double scale = amplitude / 2147483648.0;  // int32 -> [-1, 1)
+    auto block_bits = [&](uint64_t block) {
+        return Philox4x32::generate({static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), 0, 0}, key);
+    };
+    size_t end = first + count;
+    size_t body_begin = std::min((first + 3) / 4 * 4, end);
+    size_t body_end = std::max(end / 4 * 4, body_begin);
+
+    // Partial blocks at either end, whole blocks in between
+    auto add_partial = [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            out[i - first] += scale * static_cast<int32_t>(block_bits(i / 4)[i % 4]);
+        }
+    };
+    add_partial(first, body_begin);
+    double* dst = out + (body_begin - first);
+    for (size_t block = body_begin / 4; block < body_end / 4; ++block, dst += 4) {
+        auto bits = block_bits(block);
+        for (size_t lane = 0; lane < 4; ++lane) {
+            dst[lane] += scale * static_cast<int32_t>(bits[lane]);
+        }
+    }
+    add_partial(body_end, end);
+}
@@ -0,0 +1,243 @@
+/*
+ * Bush Ears - Persistent work-stealing thread pool
+ * Shared by the batch APIs so worker threads (and their per-worker scratch) live
+ * for the whole process instead of being spawned per call
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of workers, each with its own task deque. Workers pop from the front of
+// their own deque and steal from the back of the others when it runs dry, so uneven
+// task costs (segments of very different lengths) still balance out.
+class WorkStealingPool {
+private:
+    // One blocking parallel_for call; lives on the caller's stack until it returns
+    struct Job {
+        void (*invoke)(void* body, size_t index, size_t worker);
+        void* body;
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        Job* job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    size_t queued_ = 0;  // Tasks sitting in any deque; guarded by sleep_mutex_
+    bool stop_ = false;
+
+public:
+    explicit WorkStealingPool(size_t num_threads) {
+        num_threads = std::max<size_t>(num_threads, 1);
+        for (size_t w = 0; w < num_threads; ++w) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+        threads_.reserve(num_threads);
+        for (size_t w = 0; w < num_threads; ++w) {
+            threads_.emplace_back([this, w] { worker_loop(w); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    size_t num_threads() const { return threads_.size(); }
+
+    // Run body(index, worker) for every index in [0, count) and wait for all of them.
+    // worker < num_threads() identifies the thread, so callers can keep per-worker
+    // scratch indexed by it. Indices are dealt out in grain-sized tasks; the first
+    // exception thrown by body is rethrown here once the job has drained.
+    // Must not be called from inside a pool task (the caller only waits).
+    template <typename Body>
+    void parallel_for(size_t count, Body&& body, size_t grain = 1) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<size_t>(grain, 1);
+        size_t num_tasks = (count + grain - 1) / grain;
+
+        Job job;
+        job.invoke = [](void* fn, size_t index, size_t worker) {
+            (*static_cast<std::remove_reference_t<Body>*>(fn))(index, worker);
+        };
+        job.body = static_cast<void*>(&body);
+        job.remaining = num_tasks;
+
+        // Deal contiguous runs of tasks to each worker to keep neighbours together
+        size_t tasks_per_worker = (num_tasks + queues_.size() - 1) / queues_.size();
+        for (size_t w = 0, task = 0; w < queues_.size() && task < num_tasks; ++w) {
+            std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+            for (size_t n = 0; n < tasks_per_worker && task < num_tasks; ++n, ++task) {
+                size_t begin = task * grain;
+                queues_[w]->tasks.push_back({&job, begin, std::min(begin + grain, count)});
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            queued_ += num_tasks;
+        }
+        wake_.notify_all();
+
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait(lock, [&] { return job.remaining == 0; });
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+private:
+    bool try_pop(size_t worker, Task& task) {
+        // Own deque first (front), then steal from the back of the others
+        for (size_t offset = 0; offset < queues_.size(); ++offset) {
+            WorkerQueue& queue = *queues_[(worker + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            if (offset == 0) {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            } else {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void run(const Task& task, size_t worker) {
+        Job& job = *task.job;
+        try {
+            for (size_t i = task.begin; i < task.end; ++i) {
+                job.invoke(job.body, i, worker);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+
+        // Notify under the lock: the caller may destroy the job as soon as it sees zero
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (--job.remaining == 0) {
+            job.done.notify_all();
+        }
+    }
+
+    void worker_loop(size_t worker) {
+        while (true) {
+            Task task;
+            if (try_pop(worker, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    --queued_;
+                }
+                run(task, worker);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [&] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) {
+                return;
+            }
+        }
+    }
+};
+
+// Module-wide pool used by the batch APIs. Holding a lease keeps the pool from
+// being resized underneath a running job.
+class SharedThreadPool {
+private:
+    static std::shared_mutex& mutex() {
+        static std::shared_mutex instance;
+        return instance;
+    }
+
+    static std::unique_ptr<WorkStealingPool>& pool() {
+        static std::unique_ptr<WorkStealingPool> instance;
+        return instance;
+    }
+
+    static size_t default_size() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+public:
+    class Lease {
+    private:
+        std::shared_lock<std::shared_mutex> lock_;
+        WorkStealingPool* pool_;
+
+    public:
+        Lease(std::shared_lock<std::shared_mutex> lock, WorkStealingPool* pool)
+            : lock_(std::move(lock)), pool_(pool) {}
+
+        WorkStealingPool* operator->() const { return pool_; }
+    };
+
+    static Lease acquire() {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex());
+            if (pool()) {
+                return Lease(std::move(lock), pool().get());
+            }
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex());
+            if (!pool()) {
+                pool() = std::make_unique<WorkStealingPool>(default_size());
+            }
+        }
+        std::shared_lock<std::shared_mutex> lock(mutex());
+        return Lease(std::move(lock), pool().get());
+    }
+
+    // Replace the pool; waits for running jobs to finish. 0 means one thread per core.
+    static void resize(size_t num_threads) {
+        std::unique_lock<std::shared_mutex> lock(mutex());
+        pool().reset();
+        pool() = std::make_unique<WorkStealingPool>(num_threads == 0 ? default_size() : num_threads);
+    }
+
+    static size_t size() {
+        return acquire()->num_threads();
+    }
+};
@@ -0,0 +1,303 @@
+/*
+ * Bush Ears - Test recordings
+ * Writers for the WAV, RF64 and FLAC layouts AudioFile reads, so tests build their
+ * fixtures from known samples instead of shipping binaries
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fixtures {
+
+// A file under the test temp directory, removed when the fixture goes out of scope
+class TempFile {
+public:
+    explicit TempFile(const std::string& name) : path_(::testing::TempDir() + "bush_ears_" + name) {}
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+    ~TempFile() { std::remove(path_.c_str()); }
+
+    const std::string& path() const { return path_; }
+
+    void write(const std::vector<uint8_t>& bytes) const {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    std::string path_;
+};
+
+template <typename T>
+void append_le(std::vector<uint8_t>& bytes, T value, size_t width = sizeof(T)) {
+    uint8_t raw[sizeof(T)];
+    std::memcpy(raw, &value, sizeof(T));
+    bytes.insert(bytes.end(), raw, raw + width);
+}
+
+inline void append_tag(std::vector<uint8_t>& bytes, const char* tag) { bytes.insert(bytes.end(), tag, tag + 4); }
+
+struct WavFormat {
+    uint16_t format_tag;  // 1 = PCM, 3 = IEEE float
+    uint16_t channels;
+    uint32_t sample_rate;
+    uint16_t bits_per_sample;
+    bool extensible = false;  // WAVE_FORMAT_EXTENSIBLE fmt chunk carrying format_tag
+    bool rf64 = false;        // RF64 with a ds64 chunk and 0xFFFFFFFF placeholder sizes
+    std::vector<uint8_t> extra_chunk;  // Written as an "LIST" chunk before the data, padded if odd
+    uint32_t declared_data_bytes = 0;  // Overrides the data chunk size when non-zero
+
+    WavFormat(uint16_t format_tag, uint16_t channels, uint32_t sample_rate, uint16_t bits_per_sample)
+        : format_tag(format_tag), channels(channels), sample_rate(sample_rate), bits_per_sample(bits_per_sample) {}
+};
+
+// A WAV file around interleaved sample bytes
+inline std::vector<uint8_t> wav_bytes(const WavFormat& format, const std::vector<uint8_t>& data) {
+    uint16_t block_align = static_cast<uint16_t>(format.channels * format.bits_per_sample / 8);
+    std::vector<uint8_t> fmt;
+    append_le<uint16_t>(fmt, format.extensible ? 0xFFFE : format.format_tag);
+    append_le<uint16_t>(fmt, format.channels);
+    append_le<uint32_t>(fmt, format.sample_rate);
+    append_le<uint32_t>(fmt, format.sample_rate * block_align);
+    append_le<uint16_t>(fmt, block_align);
+    append_le<uint16_t>(fmt, format.bits_per_sample);
+    if (format.extensible) {
+        append_le<uint16_t>(fmt, 22);  // Extension size
+        append_le<uint16_t>(fmt, format.bits_per_sample);
+        append_le<uint32_t>(fmt, 0);   // Channel mask
+        append_le<uint16_t>(fmt, format.format_tag);
+        static const uint8_t GUID_TAIL[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                              0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+        fmt.insert(fmt.end(), GUID_TAIL, GUID_TAIL + sizeof(GUID_TAIL));
+    }
+
+    std::vector<uint8_t> body;
+    append_tag(body, "WAVE");
+    if (format.rf64) {
+        append_tag(body, "ds64");
+        append_le<uint32_t>(body, 28);
+        append_le<uint64_t>(body, 0);  // RIFF size, unused by the reader
+        append_le<uint64_t>(body, data.size());
+        append_le<uint64_t>(body, data.size() / block_align);
+        append_le<uint32_t>(body, 0);  // No table entries
+    }
+    append_tag(body, "fmt ");
+    append_le<uint32_t>(body, static_cast<uint32_t>(fmt.size()));
+    body.insert(body.end(), fmt.begin(), fmt.end());
+    if (!format.extra_chunk.empty()) {
+        append_tag(body, "LIST");
+        append_le<uint32_t>(body, static_cast<uint32_t>(format.extra_chunk.size()));
+        body.insert(body.end(), format.extra_chunk.begin(), format.extra_chunk.end());
+        if (format.extra_chunk.size() % 2 != 0) {
+            body.push_back(0);
+        }
+    }
+    append_tag(body, "data");
+    uint32_t data_size = format.declared_data_bytes != 0 ? format.declared_data_bytes
+                                                          : static_cast<uint32_t>(data.size());
+    append_le<uint32_t>(body, format.rf64 ? 0xFFFFFFFF : data_size);
+    body.insert(body.end(), data.begin(), data.end());
+
+    const char* riff = format.rf64 ? "RF64" : "RIFF";
+    std::vector<uint8_t> bytes(riff, riff + 4);
+    append_le<uint32_t>(bytes, format.rf64 ? 0xFFFFFFFF : static_cast<uint32_t>(body.size()));
+    bytes.insert(bytes.end(), body.begin(), body.end());
+    return bytes;
+}
+
+// MSB-first bit writer, as FLAC lays bits out
+class BitWriter {
+public:
+    void write(uint64_t value, unsigned bits) {
+        for (unsigned i = bits; i-- > 0;) {
+            push_bit((value >> i) & 1);
+        }
+    }
+
+    void write_signed(int64_t value, unsigned bits) { write(static_cast<uint64_t>(value) & mask(bits), bits); }
+
+    void write_unary(uint32_t zeros) {
+        for (uint32_t i = 0; i < zeros; ++i) {
+            push_bit(0);
+        }
+        push_bit(1);
+    }
+
+    void align() {
+        while (used_ != 0) {
+            push_bit(0);
+        }
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    unsigned used_ = 0;  // Bits filled in the last byte
+
+    static uint64_t mask(unsigned bits) { return bits == 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1; }
+
+    void push_bit(uint64_t bit) {
+        if (used_ == 0) {
+            bytes_.push_back(0);
+        }
+        bytes_.back() |= static_cast<uint8_t>(bit << (7 - used_));
+        used_ = (used_ + 1) % 8;
+    }
+};
+
+// How one FLAC frame codes its channels
+enum class FlacSubframe { Constant, Verbatim, Fixed2, Lpc2 };
+enum class FlacStereo { Independent, LeftSide, SideRight, MidSide };
+
+struct FlacFrame {
+    FlacSubframe subframe = FlacSubframe::Verbatim;
+    FlacStereo stereo = FlacStereo::Independent;
+    uint32_t wasted_bits = 0;  // Every sample of the frame must be a multiple of 2^wasted_bits
+};
+
+// A FLAC stream of channels (one int32 vector each, equal lengths) cut into
+// block_size frames, frame i coded per frames[i % frames.size()]. CRCs are left zero.
+inline std::vector<uint8_t> flac_bytes(const std::vector<std::vector<int32_t>>& channels, uint32_t sample_rate,
+                                       uint32_t bits_per_sample, size_t block_size,
+                                       const std::vector<FlacFrame>& frames) {
+    size_t total = channels.front().size();
+    BitWriter out;
+    out.write(0x664C6143, 32);  // "fLaC"
+    out.write(1, 1);            // Last metadata block
+    out.write(0, 7);            // STREAMINFO
+    out.write(34, 24);
+    out.write(block_size, 16);
+    out.write(block_size, 16);
+    out.write(0, 24);
+    out.write(0, 24);
+    out.write(sample_rate, 20);
+    out.write(channels.size() - 1, 3);
+    out.write(bits_per_sample - 1, 5);
+    out.write(total, 36);
+    out.write(0, 64);  // MD5
+    out.write(0, 64);
+
+    auto residual = [&](const std::vector<int64_t>& values) {
+        out.write(0, 2);  // Rice, 4-bit parameters
+        out.write(0, 4);  // One partition
+        uint64_t sum = 0;
+        for (int64_t value : values) {
+            sum += static_cast<uint64_t>(value < 0 ? -value : value);
+        }
+        unsigned param = 0;
+        while (param < 14 && (uint64_t{1} << param) * values.size() < sum) {
+            ++param;
+        }
+        out.write(param, 4);
+        for (int64_t value : values) {
+            uint64_t folded = value >= 0 ? static_cast<uint64_t>(value) << 1 : (static_cast<uint64_t>(-value) << 1) - 1;
+            out.write_unary(static_cast<uint32_t>(folded >> param));
+            out.write(folded & ((uint64_t{1} << param) - 1), param);
+        }
+    };
+
+    for (size_t start = 0, index = 0; start < total; start += block_size, ++index) {
+        const FlacFrame& frame = frames[index % frames.size()];
+        size_t n = std::min(block_size, total - start);
+        std::vector<std::vector<int64_t>> coded;
+        for (const auto& channel : channels) {
+            coded.emplace_back(channel.begin() + start, channel.begin() + start + n);
+        }
+        uint32_t assignment = static_cast<uint32_t>(channels.size() - 1);
+        std::vector<unsigned> extra_bits(channels.size(), 0);
+        if (frame.stereo != FlacStereo::Independent) {
+            std::vector<int64_t> left = coded[0];
+            std::vector<int64_t> right = coded[1];
+            std::vector<int64_t> side(n);
+            for (size_t i = 0; i < n; ++i) {
+                side[i] = left[i] - right[i];
+            }
+            if (frame.stereo == FlacStereo::LeftSide) {
+                assignment = 8;
+                coded = {left, side};
+                extra_bits = {0, 1};
+            } else if (frame.stereo == FlacStereo::SideRight) {
+                assignment = 9;
+                coded = {side, right};
+                extra_bits = {1, 0};
+            } else {
+                assignment = 10;
+                std::vector<int64_t> mid(n);
+                for (size_t i = 0; i < n; ++i) {
+                    mid[i] = (left[i] + right[i]) >> 1;
+                }
+                coded = {mid, side};
+                extra_bits = {0, 1};
+            }
+        }
+
+        out.write(0x3FFE, 14);
+        out.write(0, 2);           // Reserved, fixed blocking
+        out.write(7, 4);           // 16-bit block size at the end of the header
+        out.write(0, 4);           // Rate from STREAMINFO
+        out.write(assignment, 4);
+        out.write(0, 3);           // Depth from STREAMINFO
+        out.write(0, 1);
+        out.write(index, 8);       // Frame number (< 128 here)
+        out.write(n - 1, 16);
+        out.write(0, 8);           // CRC-8
+
+        for (size_t c = 0; c < coded.size(); ++c) {
+            unsigned depth = bits_per_sample + extra_bits[c] - frame.wasted_bits;
+            std::vector<int64_t> samples = coded[c];
+            for (int64_t& sample : samples) {
+                sample >>= frame.wasted_bits;
+            }
+            out.write(0, 1);
+            uint32_t type = frame.subframe == FlacSubframe::Constant ? 0
+                          : frame.subframe == FlacSubframe::Verbatim ? 1
+                          : frame.subframe == FlacSubframe::Fixed2   ? 8 + 2
+                                                                     : 32 + 1;
+            out.write(type, 6);
+            if (frame.wasted_bits != 0) {
+                out.write(1, 1);
+                out.write_unary(frame.wasted_bits - 1);
+            } else {
+                out.write(0, 1);
+            }
+
+            if (frame.subframe == FlacSubframe::Constant) {
+                out.write_signed(samples[0], depth);
+            } else if (frame.subframe == FlacSubframe::Verbatim) {
+                for (int64_t sample : samples) {
+                    out.write_signed(sample, depth);
+                }
+            } else {
+                // Order 2, predicting 2 * s[i - 1] - s[i - 2]: fixed, or LPC with those coefficients
+                out.write_signed(samples[0], depth);
+                out.write_signed(samples[1], depth);
+                if (frame.subframe == FlacSubframe::Lpc2) {
+                    out.write(4 - 1, 4);   // Coefficient precision
+                    out.write_signed(0, 5);  // Shift
+                    out.write_signed(2, 4);
+                    out.write_signed(-1, 4);
+                }
+                std::vector<int64_t> residuals;
+                for (size_t i = 2; i < n; ++i) {
+                    residuals.push_back(samples[i] - 2 * samples[i - 1] + samples[i - 2]);
+                }
+                residual(residuals);
+            }
+        }
+        out.align();
+        out.write(0, 16);  // CRC-16
+    }
+    return out.bytes();
+}
+
+}  // namespace fixtures
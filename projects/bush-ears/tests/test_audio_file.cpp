@@ -0,0 +1,261 @@
+/*
+ * Bush Ears - AudioFile tests
+ * Every WAV encoding, RF64 and each FLAC subframe and stereo mode decoded back to
+ * the samples they were written from
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../src/audio_file.hpp"
+#include "audio_fixtures.hpp"
+
+using fixtures::TempFile;
+using fixtures::WavFormat;
+
+namespace {
+
+// Read the whole file in blocks of max_frames; returns planar rows, one per channel
+std::vector<std::vector<double>> read_all(AudioFile& file, size_t max_frames) {
+    std::vector<std::vector<double>> channels(file.num_channels());
+    std::vector<double> block(file.num_channels() * max_frames);
+    while (size_t frames = file.read(block.data(), max_frames)) {
+        for (size_t c = 0; c < channels.size(); ++c) {
+            channels[c].insert(channels[c].end(), block.begin() + c * frames, block.begin() + (c + 1) * frames);
+        }
+    }
+    return channels;
+}
+
+// Interleaved little-endian PCM of width bytes per sample
+std::vector<uint8_t> interleave(const std::vector<std::vector<int32_t>>& channels, size_t width) {
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < channels.front().size(); ++i) {
+        for (const auto& channel : channels) {
+            fixtures::append_le<int32_t>(data, channel[i], width);
+        }
+    }
+    return data;
+}
+
+std::vector<int32_t> random_samples(size_t n, uint32_t bits, unsigned seed) {
+    std::mt19937 rng(seed);
+    int32_t limit = static_cast<int32_t>((int64_t{1} << (bits - 1)) - 1);
+    std::uniform_int_distribution<int32_t> uniform(-limit - 1, limit);
+    std::vector<int32_t> samples(n);
+    for (auto& sample : samples) {
+        sample = uniform(rng);
+    }
+    return samples;
+}
+
+void expect_samples(const std::vector<double>& decoded, const std::vector<int32_t>& expected, uint32_t bits) {
+    ASSERT_EQ(decoded.size(), expected.size());
+    double scale = std::ldexp(1.0, -static_cast<int>(bits - 1));
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(decoded[i], expected[i] * scale) << "sample " << i;
+    }
+}
+
+}  // namespace
+
+// -- WAV ---------------------------------------------------------------------
+
+TEST(AudioFileWav, Pcm16StereoIsPlanarAndScaled) {
+    std::vector<std::vector<int32_t>> channels = {{-32768, -1, 0, 1, 32767}, {100, -100, 16384, -16384, 7}};
+    TempFile file("pcm16.wav");
+    file.write(fixtures::wav_bytes(WavFormat{1, 2, 44100, 16}, interleave(channels, 2)));
+
+    AudioFile audio(file.path());
+    EXPECT_EQ(audio.format(), AudioFile::Format::Wav);
+    EXPECT_EQ(audio.sample_rate(), 44100u);
+    EXPECT_EQ(audio.num_channels(), 2u);
+    EXPECT_EQ(audio.num_frames(), 5u);
+    auto decoded = read_all(audio, 2);
+    expect_samples(decoded[0], channels[0], 16);
+    expect_samples(decoded[1], channels[1], 16);
+    EXPECT_EQ(audio.frames_read(), 5u);
+}
+
+TEST(AudioFileWav, Int24SignExtends) {
+    std::vector<int32_t> samples = {-8388608, -8388607, -65536, -256, -2, -1, 0, 1, 255, 65535, 8388607};
+    TempFile file("pcm24.wav");
+    file.write(fixtures::wav_bytes(WavFormat{1, 1, 48000, 24}, interleave({samples}, 3)));
+
+    AudioFile audio(file.path());
+    auto decoded = read_all(audio, 4);
+    expect_samples(decoded[0], samples, 24);
+    EXPECT_EQ(decoded[0].front(), -1.0);
+}
+
+TEST(AudioFileWav, UInt8IsOffsetBinary) {
+    std::vector<uint8_t> data = {0, 64, 128, 192, 255};
+    TempFile file("pcm8.wav");
+    file.write(fixtures::wav_bytes(WavFormat{1, 1, 22050, 8}, data));
+
+    AudioFile audio(file.path());
+    auto decoded = read_all(audio, 16);
+    EXPECT_EQ(decoded[0], (std::vector<double>{-1.0, -0.5, 0.0, 0.5, 127.0 / 128.0}));
+}
+
+TEST(AudioFileWav, Int32AndFloatEncodings) {
+    std::vector<int32_t> pcm = {INT32_MIN, -1, 0, 1 << 30, INT32_MAX};
+    TempFile pcm_file("pcm32.wav");
+    pcm_file.write(fixtures::wav_bytes(WavFormat{1, 1, 44100, 32}, interleave({pcm}, 4)));
+    AudioFile pcm_audio(pcm_file.path());
+    expect_samples(read_all(pcm_audio, 8)[0], pcm, 32);
+
+    std::vector<float> floats = {-1.0f, -0.25f, 0.0f, 0.5f, 0.999f};
+    std::vector<uint8_t> float_data;
+    for (float value : floats) {
+        fixtures::append_le(float_data, value);
+    }
+    TempFile float_file("float32.wav");
+    float_file.write(fixtures::wav_bytes(WavFormat{3, 1, 44100, 32}, float_data));
+    AudioFile float_audio(float_file.path());
+    EXPECT_EQ(read_all(float_audio, 8)[0], std::vector<double>(floats.begin(), floats.end()));
+
+    std::vector<double> doubles = {-0.125, 0.1, 0.75};
+    std::vector<uint8_t> double_data;
+    for (double value : doubles) {
+        fixtures::append_le(double_data, value);
+    }
+    TempFile double_file("float64.wav");
+    double_file.write(fixtures::wav_bytes(WavFormat{3, 1, 44100, 64}, double_data));
+    AudioFile double_audio(double_file.path());
+    EXPECT_EQ(read_all(double_audio, 8)[0], doubles);
+}
+
+TEST(AudioFileWav, Rf64UsesTheDs64DataSize) {
+    auto samples = random_samples(1000, 16, 3);
+    WavFormat format{1, 1, 44100, 16};
+    format.rf64 = true;
+    TempFile file("rf64.wav");
+    file.write(fixtures::wav_bytes(format, interleave({samples}, 2)));
+
+    AudioFile audio(file.path());
+    EXPECT_EQ(audio.num_frames(), samples.size());
+    expect_samples(read_all(audio, 333)[0], samples, 16);
+}
+
+TEST(AudioFileWav, ExtensibleFormatAndOddChunkPadding) {
+    auto left = random_samples(64, 24, 4);
+    auto right = random_samples(64, 24, 5);
+    WavFormat format{1, 2, 96000, 24};
+    format.extensible = true;
+    format.extra_chunk = {'I', 'N', 'F', 'O', 'x'};  // Odd length: a pad byte follows
+    TempFile file("extensible.wav");
+    file.write(fixtures::wav_bytes(format, interleave({left, right}, 3)));
+
+    AudioFile audio(file.path());
+    EXPECT_EQ(audio.sample_rate(), 96000u);
+    auto decoded = read_all(audio, 10);
+    expect_samples(decoded[0], left, 24);
+    expect_samples(decoded[1], right, 24);
+}
+
+TEST(AudioFileWav, DataSizePastTheEndIsClippedToWholeFrames) {
+    auto samples = random_samples(10, 16, 6);
+    auto data = interleave({samples, samples}, 2);
+    data.pop_back();  // The recorder stopped mid-frame
+    WavFormat format{1, 2, 44100, 16};
+    format.declared_data_bytes = 1 << 20;
+    TempFile file("truncated.wav");
+    file.write(fixtures::wav_bytes(format, data));
+
+    AudioFile audio(file.path());
+    EXPECT_EQ(audio.num_frames(), 9u);
+    auto decoded = read_all(audio, 4);
+    expect_samples(decoded[0], std::vector<int32_t>(samples.begin(), samples.begin() + 9), 16);
+}
+
+TEST(AudioFileWav, RejectsUnreadableFiles) {
+    TempFile junk("junk.wav");
+    junk.write(std::vector<uint8_t>(64, 'x'));
+    EXPECT_THROW(AudioFile{junk.path()}, std::runtime_error);
+
+    TempFile depth("pcm12.wav");
+    depth.write(fixtures::wav_bytes(WavFormat{1, 1, 44100, 12}, std::vector<uint8_t>(8)));
+    EXPECT_THROW(AudioFile{depth.path()}, std::runtime_error);
+
+    EXPECT_THROW(AudioFile{::testing::TempDir() + "bush_ears_missing.wav"}, std::runtime_error);
+}
+
+// -- FLAC --------------------------------------------------------------------
+
+TEST(AudioFileFlac, DecodesEverySubframeType) {
+    using fixtures::FlacFrame;
+    using fixtures::FlacStereo;
+    using fixtures::FlacSubframe;
+    constexpr size_t BLOCK = 256;
+
+    // A smooth tone keeps predictor residuals small; one block is constant, one has a wasted bit
+    std::vector<int32_t> samples(5 * BLOCK + 100);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<int32_t>(std::lround(20000.0 * std::sin(0.01 * static_cast<double>(i)))) + 7;
+    }
+    std::fill(samples.begin() + BLOCK, samples.begin() + 2 * BLOCK, -1234);
+    for (size_t i = 4 * BLOCK; i < 5 * BLOCK; ++i) {
+        samples[i] &= ~1;
+    }
+    std::vector<FlacFrame> frames = {
+        {FlacSubframe::Verbatim, FlacStereo::Independent, 0},
+        {FlacSubframe::Constant, FlacStereo::Independent, 0},
+        {FlacSubframe::Fixed2, FlacStereo::Independent, 0},
+        {FlacSubframe::Lpc2, FlacStereo::Independent, 0},
+        {FlacSubframe::Fixed2, FlacStereo::Independent, 1},
+        {FlacSubframe::Verbatim, FlacStereo::Independent, 0},
+    };
+    TempFile file("mono.flac");
+    file.write(fixtures::flac_bytes({samples}, 44100, 16, BLOCK, frames));
+
+    AudioFile audio(file.path());
+    EXPECT_EQ(audio.format(), AudioFile::Format::Flac);
+    EXPECT_EQ(audio.num_frames(), samples.size());
+    expect_samples(read_all(audio, 1000)[0], samples, 16);
+}
+
+TEST(AudioFileFlac, DecodesEveryStereoMode) {
+    using fixtures::FlacFrame;
+    using fixtures::FlacStereo;
+    using fixtures::FlacSubframe;
+    constexpr size_t BLOCK = 192;
+
+    std::vector<int32_t> left(4 * BLOCK);
+    std::vector<int32_t> right(4 * BLOCK);
+    for (size_t i = 0; i < left.size(); ++i) {
+        double t = static_cast<double>(i);
+        left[i] = static_cast<int32_t>(std::lround(3000000.0 * std::sin(0.02 * t)));
+        right[i] = static_cast<int32_t>(std::lround(2500000.0 * std::sin(0.013 * t + 1.0))) - 3;  // Odd sums too
+    }
+    std::vector<FlacFrame> frames = {
+        {FlacSubframe::Fixed2, FlacStereo::Independent, 0},
+        {FlacSubframe::Fixed2, FlacStereo::LeftSide, 0},
+        {FlacSubframe::Verbatim, FlacStereo::SideRight, 0},
+        {FlacSubframe::Lpc2, FlacStereo::MidSide, 0},
+    };
+    TempFile file("stereo.flac");
+    file.write(fixtures::flac_bytes({left, right}, 48000, 24, BLOCK, frames));
+
+    AudioFile audio(file.path());
+    EXPECT_EQ(audio.sample_rate(), 48000u);
+    EXPECT_EQ(audio.bits_per_sample(), 24u);
+    auto decoded = read_all(audio, 100);  // Reads straddle frame boundaries
+    expect_samples(decoded[0], left, 24);
+    expect_samples(decoded[1], right, 24);
+}
+
+TEST(AudioFileFlac, RejectsCorruptFrames) {
+    std::vector<int32_t> samples(300, 5);
+    auto bytes = fixtures::flac_bytes({samples}, 44100, 16, 256, {{}});
+    bytes[4 + 4 + 34] ^= 0xFF;  // First frame's sync code, after fLaC and STREAMINFO
+    TempFile file("corrupt.flac");
+    file.write(bytes);
+
+    AudioFile audio(file.path());
+    std::vector<double> block(300);
+    EXPECT_THROW(audio.read(block.data(), block.size()), std::runtime_error);
+}
@@ -0,0 +1,93 @@
+/*
+ * Bush Ears - BatchArena tests
+ * Alignment, zeroing, growth, and the steady state where batches stop allocating
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../src/batch_arena.hpp"
+
+namespace {
+
+// One batch's buffers: per-row features, ids and scratch of a few sizes
+void allocate_batch(BatchArena& arena, size_t rows) {
+    arena.allocate<double>(rows * 8);
+    arena.allocate<int>(rows);
+    arena.allocate<float>(rows * 12);
+    arena.allocate<uint8_t>(3);
+}
+
+}  // namespace
+
+TEST(BatchArena, SpansAreAlignedZeroedAndDisjoint) {
+    BatchArena arena;
+    auto first = arena.allocate<double>(5);
+    auto second = arena.allocate<uint8_t>(1);
+    auto third = arena.allocate<int>(100);
+    for (const void* data : {static_cast<const void*>(first.data()), static_cast<const void*>(second.data()),
+                             static_cast<const void*>(third.data())}) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % BatchArena::ALIGNMENT, 0u);
+    }
+    EXPECT_GE(reinterpret_cast<const std::byte*>(second.data()),
+              reinterpret_cast<const std::byte*>(first.data() + first.size()));
+    EXPECT_GE(reinterpret_cast<const std::byte*>(third.data()),
+              reinterpret_cast<const std::byte*>(second.data() + second.size()));
+    EXPECT_EQ(arena.used(), 64u + 64u + 448u);  // Each span padded to whole lines
+
+    std::fill(third.begin(), third.end(), -1);
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    auto reused = arena.allocate<int>(300);
+    for (int value : reused) {
+        ASSERT_EQ(value, 0);  // Value-initialised, even over the previous batch's data
+    }
+}
+
+TEST(BatchArena, GrowsWhenABatchOutgrowsItsBlock) {
+    BatchArena arena(256);
+    EXPECT_EQ(arena.capacity(), 256u);
+    arena.allocate<double>(16);   // 128 bytes
+    arena.allocate<double>(100);  // Does not fit: chains a block
+    EXPECT_GT(arena.capacity(), 256u);
+    EXPECT_EQ(arena.used(), 128u + 832u);
+}
+
+// After one batch of a size, reset consolidates its blocks, and every later batch
+// of that size is served from that one block: any new block would raise capacity
+TEST(BatchArena, SteadyStateBatchesDoNotAllocate) {
+    BatchArena arena;
+    allocate_batch(arena, 1000);
+    arena.reset();
+    size_t capacity = arena.capacity();
+    void* block = arena.allocate<double>(1).data();
+    arena.reset();
+
+    for (int batch = 0; batch < 100; ++batch) {
+        allocate_batch(arena, 1000);
+        ASSERT_EQ(arena.capacity(), capacity) << "batch " << batch;
+        arena.reset();
+    }
+    EXPECT_EQ(arena.allocate<double>(1).data(), block);
+
+    arena.reset();
+    allocate_batch(arena, 10);  // Smaller batches fit too
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(BatchArena, ResetMergesChainedBlocks) {
+    BatchArena arena(64);
+    for (size_t i = 0; i < 6; ++i) {
+        arena.allocate<uint8_t>(64 << i);
+    }
+    size_t total = arena.capacity();
+    size_t used = arena.used();
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), total);
+
+    arena.allocate<uint8_t>(used);  // The whole previous batch in one span
+    EXPECT_EQ(arena.capacity(), total);
+}
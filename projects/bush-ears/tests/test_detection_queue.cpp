@@ -0,0 +1,136 @@
+/*
+ * Bush Ears - BoundedMpscQueue tests
+ * Capacity, drop counting, wrap-around and concurrent producers against one consumer
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/detection_queue.hpp"
+
+namespace {
+
+// Producer id in the high bits, per-producer sequence number in the low ones
+constexpr uint64_t producer_value(uint64_t producer, uint64_t sequence) { return producer << 32 | sequence; }
+
+}  // namespace
+
+TEST(BoundedMpscQueue, RejectsCapacitiesThatAreNotPowersOfTwo) {
+    EXPECT_THROW(BoundedMpscQueue<int>(0), std::invalid_argument);
+    EXPECT_THROW(BoundedMpscQueue<int>(1), std::invalid_argument);
+    EXPECT_THROW(BoundedMpscQueue<int>(12), std::invalid_argument);
+    EXPECT_EQ(BoundedMpscQueue<int>(16).capacity(), 16u);
+}
+
+TEST(BoundedMpscQueue, FullRingDropsAndCountsNewEvents) {
+    BoundedMpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_FALSE(queue.try_push(5));
+    EXPECT_EQ(queue.dropped(), 2u);
+    EXPECT_EQ(queue.size(), 4u);
+
+    std::vector<int> out(8, -1);
+    ASSERT_EQ(queue.drain(out.data(), out.size()), 4u);
+    EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + 4), (std::vector<int>{0, 1, 2, 3}));  // The oldest survive
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_TRUE(queue.try_push(6));
+}
+
+TEST(BoundedMpscQueue, PartialDrainsKeepOrderAcrossWrapAround) {
+    BoundedMpscQueue<int> queue(8);
+    int next_push = 0, next_drain = 0;
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_TRUE(queue.try_push(next_push++));
+        }
+        int out[3];
+        size_t count = queue.drain(out, 3);
+        ASSERT_EQ(count, 3u);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out[i], next_drain++);
+        }
+        count = queue.drain(out, 2);
+        ASSERT_EQ(count, 2u);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(out[i], next_drain++);
+        }
+    }
+    EXPECT_EQ(queue.dropped(), 0u);
+}
+
+TEST(BoundedMpscQueue, DetectionEventsCopyWhole) {
+    DetectionQueue queue(2);
+    DetectionEvent event{};
+    event.timestamp = 12.5;
+    for (int i = 0; i < 8; ++i) {
+        event.features[i] = static_cast<float>(i) / 4.0f;
+    }
+    event.confidence = 0.75f;
+    event.duration = 1.5f;
+    event.channel = 3;
+    event.species_id = 9;
+    ASSERT_TRUE(queue.try_push(event));
+
+    DetectionEvent out{};
+    ASSERT_EQ(queue.drain(&out, 1), 1u);
+    EXPECT_EQ(out.timestamp, 12.5);
+    EXPECT_EQ(out.features[7], 1.75f);
+    EXPECT_EQ(out.confidence, 0.75f);
+    EXPECT_EQ(out.duration, 1.5f);
+    EXPECT_EQ(out.channel, 3u);
+    EXPECT_EQ(out.species_id, 9u);
+}
+
+// Every event is either drained exactly once or counted as dropped, and each
+// producer's events arrive in the order it pushed them
+TEST(BoundedMpscQueue, ConcurrentProducersLoseNothingUncounted) {
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t PER_PRODUCER = 20000;
+    BoundedMpscQueue<uint64_t> queue(256);
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<size_t> running{PRODUCERS};
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                if (queue.try_push(producer_value(p, i))) {
+                    accepted++;
+                }
+            }
+            running--;
+        });
+    }
+
+    std::vector<int64_t> last_seen(PRODUCERS, -1);
+    uint64_t drained = 0;
+    std::vector<uint64_t> out(64);
+    while (true) {
+        bool finished = running.load() == 0;  // Read before draining, so nothing is left behind
+        size_t count = queue.drain(out.data(), out.size());
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t producer = out[i] >> 32;
+            auto sequence = static_cast<int64_t>(out[i] & 0xFFFFFFFF);
+            ASSERT_LT(producer, PRODUCERS);
+            EXPECT_GT(sequence, last_seen[producer]);
+            last_seen[producer] = sequence;
+        }
+        drained += count;
+        if (finished && count == 0) {
+            break;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(drained, accepted.load());
+    EXPECT_EQ(drained + queue.dropped(), PRODUCERS * PER_PRODUCER);
+    EXPECT_EQ(queue.size(), 0u);
+}
@@ -0,0 +1,218 @@
+/*
+ * Bush Ears - EventSegmenter tests
+ * Onset, hysteresis band, hold and split boundaries of the per-stream state machine
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "../src/event_segmenter.hpp"
+
+namespace {
+
+// Dyadic timings so every boundary below is exact in floating point
+constexpr double FRAME = 0.0625;
+constexpr AustralianSpecies KOOKABURRA = AustralianSpecies::Kookaburra;
+constexpr AustralianSpecies MAGPIE = AustralianSpecies::Magpie;
+
+// Onset at 0.6 for two frames, held open down to 0.3 across gaps of up to four
+// frames, split every sixteen frames
+EventSegmenterConfig test_config() {
+    EventSegmenterConfig config;
+    config.species.fill(SpeciesHysteresis{0.6, 0.3, 2 * FRAME, 4 * FRAME, 16 * FRAME});
+    return config;
+}
+
+class Segmenter {
+public:
+    explicit Segmenter(const EventSegmenterConfig& config = test_config()) { segmenter_.configure(config); }
+
+    // Frame k of the stream, with its confidence as every feature
+    void frame(size_t k, AustralianSpecies species, double confidence) {
+        std::array<float, EVENT_FEATURES> features;
+        features.fill(static_cast<float>(confidence));
+        segmenter_.observe(k * FRAME, FRAME, species, confidence, features.data(), sink());
+    }
+
+    void advance(size_t k) { segmenter_.advance(k * FRAME, sink()); }
+    void flush() { segmenter_.flush(sink()); }
+
+    bool open() const { return segmenter_.has_open_event(); }
+    const std::vector<SegmentedEvent>& events() const { return events_; }
+
+private:
+    EventSegmenter segmenter_;
+    std::vector<SegmentedEvent> events_;
+
+    struct Sink {
+        std::vector<SegmentedEvent>* events;
+        void operator()(const SegmentedEvent& event) const { events->push_back(event); }
+    };
+
+    Sink sink() { return {&events_}; }
+};
+
+void expect_event(const SegmentedEvent& event, AustralianSpecies species, size_t first, size_t last, size_t frames) {
+    EXPECT_EQ(event.species, species);
+    EXPECT_EQ(event.start, first * FRAME);
+    EXPECT_EQ(event.end, (last + 1) * FRAME);
+    EXPECT_EQ(event.frames, frames);
+}
+
+}  // namespace
+
+TEST(EventSegmenter, OnsetNeedsOnsetSecondsAtOnsetConfidence) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.6);
+    EXPECT_FALSE(segmenter.open());
+    segmenter.frame(1, KOOKABURRA, 0.9);
+    EXPECT_TRUE(segmenter.open());
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 1u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 1, 2);
+}
+
+TEST(EventSegmenter, LoneFramesNeverOpen) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, KOOKABURRA, 0.59);  // In the band: the candidate survives but does not grow
+    segmenter.frame(10, KOOKABURRA, 0.9);  // Past the hold: a new candidate
+    segmenter.flush();
+    EXPECT_TRUE(segmenter.events().empty());
+}
+
+TEST(EventSegmenter, BandFramesKeepTheCandidate) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, KOOKABURRA, 0.3);
+    segmenter.frame(2, KOOKABURRA, 0.9);  // Spans frames 0-2, so the onset is met
+    EXPECT_TRUE(segmenter.open());
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 1u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 2, 2);
+}
+
+TEST(EventSegmenter, FramesBelowOffsetDropTheCandidate) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, KOOKABURRA, 0.29);
+    segmenter.frame(2, KOOKABURRA, 0.9);
+    EXPECT_FALSE(segmenter.open());
+    segmenter.frame(3, KOOKABURRA, 0.9);
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 1u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 2, 3, 2);
+}
+
+TEST(EventSegmenter, UnknownFramesDropTheCandidate) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, AustralianSpecies::Unknown, 0.0);
+    segmenter.frame(2, KOOKABURRA, 0.9);
+    EXPECT_FALSE(segmenter.open());
+}
+
+TEST(EventSegmenter, BandFramesExtendAnOpenEvent) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, KOOKABURRA, 0.9);
+    for (size_t k = 2; k < 6; ++k) {
+        segmenter.frame(k, KOOKABURRA, 0.3);
+    }
+    segmenter.frame(6, KOOKABURRA, 0.29);  // Below the offset: a gap, not an extension
+    segmenter.frame(7, AustralianSpecies::Unknown, 0.0);
+    EXPECT_TRUE(segmenter.open());
+    ASSERT_TRUE(segmenter.events().empty());
+
+    segmenter.advance(10);  // Exactly hold_seconds after the event's end: still held
+    EXPECT_TRUE(segmenter.open());
+    segmenter.advance(11);
+    EXPECT_FALSE(segmenter.open());
+    ASSERT_EQ(segmenter.events().size(), 1u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 5, 6);
+}
+
+TEST(EventSegmenter, HoldBridgesGapsUpToHoldSeconds) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, KOOKABURRA, 0.9);
+    segmenter.frame(6, KOOKABURRA, 0.4);  // Four silent frames: bridged
+    segmenter.frame(13, KOOKABURRA, 0.9);  // Six: the event closes, a candidate starts
+    segmenter.frame(14, KOOKABURRA, 0.9);
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 2u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 6, 3);
+    expect_event(segmenter.events()[1], KOOKABURRA, 13, 14, 2);
+}
+
+TEST(EventSegmenter, MaxSecondsSplitsLongEvents) {
+    Segmenter segmenter;
+    for (size_t k = 0; k < 40; ++k) {
+        segmenter.frame(k, KOOKABURRA, 0.9);
+    }
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 3u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 15, 16);
+    expect_event(segmenter.events()[1], KOOKABURRA, 16, 31, 16);  // Reopens without a new onset
+    expect_event(segmenter.events()[2], KOOKABURRA, 32, 39, 8);
+}
+
+TEST(EventSegmenter, AnotherSpeciesTakesOverAfterItsOnset) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.frame(1, KOOKABURRA, 0.9);
+    segmenter.frame(2, MAGPIE, 0.9);
+    EXPECT_TRUE(segmenter.events().empty());
+    segmenter.frame(3, MAGPIE, 0.9);
+    ASSERT_EQ(segmenter.events().size(), 1u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 1, 2);
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 2u);
+    expect_event(segmenter.events()[1], MAGPIE, 2, 3, 2);
+}
+
+TEST(EventSegmenter, PeakFeaturesComeFromTheMostConfidentFrame) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.7);
+    segmenter.frame(1, KOOKABURRA, 0.95);
+    segmenter.frame(2, KOOKABURRA, 0.8);
+    segmenter.flush();
+    ASSERT_EQ(segmenter.events().size(), 1u);
+    EXPECT_EQ(segmenter.events()[0].peak_confidence, 0.95f);
+    EXPECT_EQ(segmenter.events()[0].peak_features[0], 0.95f);
+    EXPECT_EQ(segmenter.events()[0].peak_features[EVENT_FEATURES - 1], 0.95f);
+}
+
+TEST(EventSegmenter, DisabledEmitsEveryDetectedFrame) {
+    auto config = test_config();
+    config.enabled = false;
+    Segmenter segmenter(config);
+    segmenter.frame(0, KOOKABURRA, 0.1);
+    segmenter.frame(1, AustralianSpecies::Unknown, 0.0);
+    segmenter.frame(2, MAGPIE, 0.9);
+    EXPECT_FALSE(segmenter.open());
+    ASSERT_EQ(segmenter.events().size(), 2u);
+    expect_event(segmenter.events()[0], KOOKABURRA, 0, 0, 1);
+    expect_event(segmenter.events()[1], MAGPIE, 2, 2, 1);
+}
+
+TEST(EventSegmenter, FlushForgetsTheCandidate) {
+    Segmenter segmenter;
+    segmenter.frame(0, KOOKABURRA, 0.9);
+    segmenter.flush();
+    segmenter.frame(1, KOOKABURRA, 0.9);  // Would meet the onset with frame 0
+    EXPECT_FALSE(segmenter.open());
+    EXPECT_TRUE(segmenter.events().empty());
+}
+
+TEST(SpeciesHysteresis, TimingsScaleWithTheCallDuration) {
+    auto hysteresis = SpeciesHysteresis::for_call_duration(2.0);
+    EXPECT_DOUBLE_EQ(hysteresis.onset_seconds, 0.1);
+    EXPECT_DOUBLE_EQ(hysteresis.hold_seconds, 0.2);
+    EXPECT_DOUBLE_EQ(hysteresis.max_seconds, 4.0);
+
+    EXPECT_DOUBLE_EQ(SpeciesHysteresis::for_call_duration(0.1).hold_seconds, 0.05);  // Floor
+    EXPECT_DOUBLE_EQ(SpeciesHysteresis::for_call_duration(0.0).max_seconds, 2.0);   // No profile
+}
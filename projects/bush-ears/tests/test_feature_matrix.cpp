@@ -0,0 +1,119 @@
+/*
+ * Bush Ears - FeatureMatrix tests
+ * Column padding and alignment, row scatter and gather, views, and owned and borrowed storage
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../src/batch_arena.hpp"
+#include "../src/feature_matrix.hpp"
+
+namespace {
+
+constexpr size_t COLUMNS = 5;
+using Matrix = FeatureMatrixT<double, COLUMNS>;
+
+// A value that names its cell
+double cell(size_t row, size_t column) { return row * 100.0 + column; }
+
+void fill(Matrix& matrix) {
+    double values[COLUMNS];
+    for (size_t row = 0; row < matrix.rows(); ++row) {
+        for (size_t column = 0; column < COLUMNS; ++column) {
+            values[column] = cell(row, column);
+        }
+        matrix.set_row(row, values);
+    }
+}
+
+}  // namespace
+
+TEST(FeatureMatrix, ColumnsArePaddedToWholeCacheLines) {
+    EXPECT_EQ(Matrix::ROW_GROUP, 8u);
+    EXPECT_EQ((FeatureMatrixT<float, COLUMNS>::ROW_GROUP), 16u);
+    EXPECT_EQ(Matrix::column_stride(0), 0u);
+    EXPECT_EQ(Matrix::column_stride(1), 8u);
+    EXPECT_EQ(Matrix::column_stride(8), 8u);
+    EXPECT_EQ(Matrix::column_stride(9), 16u);
+    EXPECT_EQ(Matrix::storage_size(9), 16u * COLUMNS);
+
+    Matrix matrix(13);
+    EXPECT_EQ(matrix.rows(), 13u);
+    EXPECT_EQ(matrix.stride(), 16u);
+    for (size_t column = 0; column < COLUMNS; ++column) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(matrix.column(column)) % Matrix::ALIGNMENT, 0u) << "column " << column;
+    }
+}
+
+TEST(FeatureMatrix, OwnedStorageStartsZeroed) {
+    Matrix matrix(21);
+    for (size_t i = 0; i < Matrix::storage_size(21); ++i) {
+        ASSERT_EQ(matrix.data()[i], 0.0) << "value " << i;  // Padding included
+    }
+    Matrix empty(0);
+    EXPECT_NE(empty.data(), nullptr);
+    EXPECT_EQ(empty.view().rows, 0u);
+}
+
+// Rows go in one at a time, and each feature comes out as one contiguous array:
+// the layout the columnar export hands to NumPy
+TEST(FeatureMatrix, RowsScatterIntoContiguousColumns) {
+    Matrix matrix(19);
+    fill(matrix);
+    for (size_t column = 0; column < COLUMNS; ++column) {
+        const double* values = matrix.column(column);
+        EXPECT_EQ(values, matrix.data() + column * matrix.stride());
+        for (size_t row = 0; row < matrix.rows(); ++row) {
+            ASSERT_EQ(values[row], cell(row, column)) << "row " << row << ", column " << column;
+        }
+    }
+    for (size_t row = 0; row < matrix.rows(); ++row) {
+        double values[COLUMNS];
+        matrix.get_row(row, values);
+        for (size_t column = 0; column < COLUMNS; ++column) {
+            EXPECT_EQ(values[column], cell(row, column));
+        }
+    }
+    for (size_t row = matrix.rows(); row < matrix.stride(); ++row) {
+        EXPECT_EQ(matrix.column(COLUMNS - 1)[row], 0.0);  // set_row never touches padding
+    }
+}
+
+TEST(FeatureMatrix, ViewsIndexRowsInPlace) {
+    Matrix matrix(30);
+    fill(matrix);
+    auto view = matrix.view();
+    EXPECT_EQ(view.data, matrix.data());
+    EXPECT_EQ(view.rows, 30u);
+    EXPECT_EQ(view.stride, matrix.stride());
+    EXPECT_EQ(view(7, 3), cell(7, 3));
+
+    auto tail = view.subview(10, 15);
+    EXPECT_EQ(tail.rows, 15u);
+    EXPECT_EQ(tail.stride, view.stride);  // Still strided over the whole matrix
+    for (size_t row = 0; row < tail.rows; ++row) {
+        for (size_t column = 0; column < COLUMNS; ++column) {
+            ASSERT_EQ(tail(row, column), cell(10 + row, column));
+        }
+    }
+}
+
+TEST(FeatureMatrix, BorrowedStorageIsUsedInPlace) {
+    constexpr size_t ROWS = 11;
+    BatchArena arena;
+    auto storage = arena.allocate<double>(Matrix::storage_size(ROWS));
+    Matrix matrix(storage, ROWS);
+    EXPECT_EQ(matrix.data(), storage.data());
+    fill(matrix);
+    EXPECT_EQ(storage[2 * matrix.stride() + 4], cell(4, 2));
+
+    Matrix moved = std::move(matrix);
+    EXPECT_EQ(moved.data(), storage.data());  // Moving a borrowed matrix keeps pointing at the storage
+
+    EXPECT_THROW(Matrix(storage.first(Matrix::storage_size(ROWS) - 1), ROWS), std::invalid_argument);
+    EXPECT_THROW(Matrix(storage, 200), std::invalid_argument);
+}
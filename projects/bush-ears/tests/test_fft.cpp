@@ -0,0 +1,134 @@
+/*
+ * Bush Ears - RealFFT tests
+ * Every size and precision against a naive O(N^2) DFT of the same input
+ */
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "../src/fft.hpp"
+
+namespace {
+
+template <typename Real>
+std::vector<std::complex<double>> naive_dft(const std::vector<Real>& input) {
+    size_t n = input.size();
+    std::vector<std::complex<double>> bins(n / 2 + 1);
+    for (size_t k = 0; k < bins.size(); ++k) {
+        std::complex<double> sum;
+        for (size_t t = 0; t < n; ++t) {
+            double angle = -2.0 * M_PI * static_cast<double>(k * t % n) / static_cast<double>(n);
+            sum += static_cast<double>(input[t]) * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        bins[k] = sum;
+    }
+    return bins;
+}
+
+// Largest bin error relative to the signal's largest bin
+template <size_t N, typename Real>
+double max_relative_error(const std::vector<Real>& input) {
+    using FFT = RealFFT<N, Real>;
+    FFT fft;
+    std::vector<std::complex<Real>> output(FFT::BINS);
+    std::vector<std::complex<Real>> work(FFT::WORK_SIZE);
+    fft.forward(input.data(), output.data(), work.data());
+
+    auto expected = naive_dft(input);
+    double scale = 0.0;
+    for (const auto& bin : expected) {
+        scale = std::max(scale, std::abs(bin));
+    }
+    double error = 0.0;
+    for (size_t k = 0; k < FFT::BINS; ++k) {
+        std::complex<double> actual(output[k].real(), output[k].imag());
+        error = std::max(error, std::abs(actual - expected[k]));
+    }
+    return error / std::max(scale, 1e-300);
+}
+
+template <typename Real>
+std::vector<Real> noise(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<Real> samples(n);
+    for (auto& sample : samples) {
+        sample = static_cast<Real>(uniform(rng));
+    }
+    return samples;
+}
+
+template <size_t N>
+void expect_matches_dft() {
+    EXPECT_LT(max_relative_error<N>(noise<double>(N, N)), 1e-12) << "N = " << N << " (double)";
+    EXPECT_LT(max_relative_error<N>(noise<float>(N, N)), 1e-5) << "N = " << N << " (float)";
+}
+
+}  // namespace
+
+TEST(RealFFT, MatchesNaiveDftForEverySize) {
+    expect_matches_dft<4>();
+    expect_matches_dft<8>();
+    expect_matches_dft<16>();
+    expect_matches_dft<64>();
+    expect_matches_dft<256>();
+    expect_matches_dft<1024>();
+    expect_matches_dft<2048>();
+}
+
+TEST(RealFFT, PureToneLandsInItsBin) {
+    constexpr size_t N = 1024;
+    constexpr size_t BIN = 37;
+    std::vector<double> tone(N);
+    for (size_t t = 0; t < N; ++t) {
+        tone[t] = std::cos(2.0 * M_PI * BIN * t / N);
+    }
+    RealFFT<N> fft;
+    std::vector<std::complex<double>> output(RealFFT<N>::BINS);
+    std::vector<std::complex<double>> work(RealFFT<N>::WORK_SIZE);
+    fft.forward(tone.data(), output.data(), work.data());
+
+    for (size_t k = 0; k < output.size(); ++k) {
+        double expected = k == BIN ? N / 2.0 : 0.0;
+        EXPECT_NEAR(std::abs(output[k]), expected, 1e-9) << "bin " << k;
+    }
+}
+
+TEST(RealFFT, DcAndNyquistBinsAreReal) {
+    constexpr size_t N = 256;
+    auto input = noise<double>(N, 7);
+    RealFFT<N> fft;
+    std::vector<std::complex<double>> output(RealFFT<N>::BINS);
+    std::vector<std::complex<double>> work(RealFFT<N>::WORK_SIZE);
+    fft.forward(input.data(), output.data(), work.data());
+
+    double sum = 0.0;
+    double alternating = 0.0;
+    for (size_t t = 0; t < N; ++t) {
+        sum += input[t];
+        alternating += t % 2 == 0 ? input[t] : -input[t];
+    }
+    EXPECT_NEAR(output[0].real(), sum, 1e-12);
+    EXPECT_NEAR(output[0].imag(), 0.0, 1e-12);
+    EXPECT_NEAR(output[N / 2].real(), alternating, 1e-12);
+    EXPECT_NEAR(output[N / 2].imag(), 0.0, 1e-12);
+}
+
+TEST(RealFFT, RepeatedTransformsReuseScratch) {
+    constexpr size_t N = 512;
+    RealFFT<N> fft;
+    std::vector<std::complex<double>> first(RealFFT<N>::BINS);
+    std::vector<std::complex<double>> second(RealFFT<N>::BINS);
+    std::vector<std::complex<double>> work(RealFFT<N>::WORK_SIZE);
+    auto a = noise<double>(N, 1);
+    auto b = noise<double>(N, 2);
+    fft.forward(a.data(), first.data(), work.data());
+    fft.forward(b.data(), second.data(), work.data());
+    fft.forward(a.data(), second.data(), work.data());
+    for (size_t k = 0; k < first.size(); ++k) {
+        EXPECT_EQ(first[k], second[k]) << "bin " << k;
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * Bush Ears - Mel filterbank and MFCC tests
+ * Sparse filter rows against dense triangles, filter overlap, DCT orthonormality
+ * and the engine's validation and silent-frame floor
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../src/mel.hpp"
+
+namespace {
+
+constexpr double SAMPLE_RATE = 44100.0;
+constexpr size_t FFT_SIZE = 1024;
+constexpr size_t BINS = FFT_SIZE / 2 + 1;
+constexpr double BIN_HZ = SAMPLE_RATE / FFT_SIZE;
+
+// Weight of bin under filter m, evaluated densely from the mel-spaced edges
+double dense_weight(size_t m, size_t bin, size_t num_mels, double min_hz, double max_hz) {
+    double min_mel = hz_to_mel(min_hz);
+    double step = (hz_to_mel(max_hz) - min_mel) / (num_mels + 1);
+    double left = mel_to_hz(min_mel + m * step);
+    double centre = mel_to_hz(min_mel + (m + 1) * step);
+    double right = mel_to_hz(min_mel + (m + 2) * step);
+    double hz = bin * BIN_HZ;
+    return std::max(0.0, hz <= centre ? (hz - left) / (centre - left) : (right - hz) / (right - centre));
+}
+
+}  // namespace
+
+TEST(MelScale, HtkScaleRoundTrips) {
+    EXPECT_EQ(hz_to_mel(0.0), 0.0);
+    EXPECT_NEAR(hz_to_mel(1000.0), 1000.0, 0.1);  // The scale is anchored near 1 kHz = 1000 mel
+    for (double hz : {20.0, 440.0, 8000.0, 22050.0}) {
+        EXPECT_NEAR(mel_to_hz(hz_to_mel(hz)), hz, 1e-9 * hz);
+    }
+}
+
+TEST(MelFilterbank, SparseRowsMatchDenseTriangles) {
+    for (auto [min_hz, max_hz] : {std::pair{0.0, 22050.0}, std::pair{500.0, 12000.0}}) {
+        constexpr size_t MELS = 40;
+        MelFilterbank filterbank(SAMPLE_RATE, FFT_SIZE, MELS, min_hz, max_hz);
+        ASSERT_EQ(filterbank.num_mels(), MELS);
+
+        std::mt19937 rng(21);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<double> power(BINS);
+        for (auto& p : power) {
+            p = uniform(rng);
+        }
+        std::vector<double> mel(MELS);
+        filterbank.apply(power.data(), mel.data());
+        for (size_t m = 0; m < MELS; ++m) {
+            double expected = 0.0;
+            for (size_t bin = 0; bin < BINS; ++bin) {
+                expected += dense_weight(m, bin, MELS, min_hz, max_hz) * power[bin];
+            }
+            EXPECT_NEAR(mel[m], expected, 1e-12) << "filter " << m << " over " << min_hz << "-" << max_hz << " Hz";
+        }
+    }
+}
+
+// Neighbouring triangles cross at half height, so between the first and last
+// centre every bin's weights sum to one
+TEST(MelFilterbank, OverlappingFiltersSumToOne) {
+    constexpr size_t MELS = 20;
+    MelFilterbank filterbank(SAMPLE_RATE, FFT_SIZE, MELS, 0.0, 22050.0);
+    double step = hz_to_mel(22050.0) / (MELS + 1);
+    double first_centre = mel_to_hz(step), last_centre = mel_to_hz(MELS * step);
+
+    std::vector<double> unit(BINS, 0.0), mel(MELS);
+    for (size_t bin = 0; bin < BINS; ++bin) {
+        double hz = bin * BIN_HZ;
+        if (hz < first_centre || hz > last_centre) {
+            continue;
+        }
+        unit[bin] = 1.0;
+        filterbank.apply(unit.data(), mel.data());
+        unit[bin] = 0.0;
+        double total = 0.0;
+        for (double weight : mel) {
+            EXPECT_LE(weight, 1.0);
+            total += weight;
+        }
+        EXPECT_NEAR(total, 1.0, 1e-9) << "bin " << bin;
+    }
+}
+
+// Orthonormal: a full-size DCT keeps the input's energy and maps a constant to coefficient 0
+TEST(DctTable, IsOrthonormal) {
+    constexpr size_t N = 16;
+    DctTable dct(N, N);
+    std::mt19937 rng(4);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> input(N);
+    double energy = 0.0;
+    for (auto& x : input) {
+        x = normal(rng);
+        energy += x * x;
+    }
+    std::vector<float> coeffs(N);
+    dct.apply(input.data(), coeffs.data());
+    double coeff_energy = 0.0;
+    for (float c : coeffs) {
+        coeff_energy += static_cast<double>(c) * c;
+    }
+    EXPECT_NEAR(coeff_energy, energy, 1e-5 * energy);
+
+    std::vector<double> constant(N, 2.0);
+    dct.apply(constant.data(), coeffs.data());
+    EXPECT_NEAR(coeffs[0], 2.0 * std::sqrt(static_cast<double>(N)), 1e-5);
+    for (size_t k = 1; k < N; ++k) {
+        EXPECT_NEAR(coeffs[k], 0.0, 1e-5) << "coefficient " << k;
+    }
+}
+
+TEST(MelFeatureEngine, RejectsInvalidConfigs) {
+    auto make = [](MelConfig config) { return MelFeatureEngine(SAMPLE_RATE, FFT_SIZE, config); };
+    EXPECT_THROW(make({0, 0, 0.0, 0.0}), std::invalid_argument);
+    EXPECT_THROW(make({10, 11, 0.0, 0.0}), std::invalid_argument);        // More coefficients than mels
+    EXPECT_THROW(make({40, 13, 0.0, 30000.0}), std::invalid_argument);    // Above Nyquist
+    EXPECT_THROW(make({40, 13, 5000.0, 4000.0}), std::invalid_argument);  // Empty range
+    EXPECT_THROW(make({40, 13, -1.0, 0.0}), std::invalid_argument);
+    EXPECT_EQ(make({40, 13, 0.0, 0.0}).config().max_hz, SAMPLE_RATE / 2);  // 0 means Nyquist
+}
+
+// Silence hits the log floor in every filter: a constant log-mel, so only c0 is non-zero
+TEST(MelFeatureEngine, SilentFramesStayFinite) {
+    MelFeatureEngine engine(SAMPLE_RATE, FFT_SIZE, MelConfig{});
+    std::vector<float> magnitude(BINS, 0.0f);
+    std::vector<double> power(BINS), log_mel(engine.config().num_mels);
+    engine.log_mel(magnitude.data(), BINS, power.data(), log_mel.data());
+    for (double value : log_mel) {
+        EXPECT_EQ(value, std::log(1e-10));
+    }
+
+    std::vector<float> coeffs(engine.config().num_coeffs);
+    engine.mfcc(log_mel.data(), coeffs.data());
+    EXPECT_NEAR(coeffs[0], std::log(1e-10) * std::sqrt(static_cast<double>(engine.config().num_mels)), 1e-4);
+    for (size_t k = 1; k < coeffs.size(); ++k) {
+        EXPECT_NEAR(coeffs[k], 0.0, 1e-4) << "coefficient " << k;
+    }
+}
+
+// log_mel squares the magnitudes before filtering
+TEST(MelFeatureEngine, LogMelFiltersThePowerSpectrum) {
+    MelConfig config{24, 12, 0.0, 0.0};
+    MelFeatureEngine engine(SAMPLE_RATE, FFT_SIZE, config);
+    MelFilterbank filterbank(SAMPLE_RATE, FFT_SIZE, 24, 0.0, SAMPLE_RATE / 2);
+    std::vector<double> magnitude(BINS), power(BINS), scratch(BINS);
+    for (size_t bin = 0; bin < BINS; ++bin) {
+        magnitude[bin] = 1.0 + 0.01 * bin;
+        power[bin] = magnitude[bin] * magnitude[bin];
+    }
+    std::vector<double> log_mel(24), mel(24);
+    engine.log_mel(magnitude.data(), BINS, scratch.data(), log_mel.data());
+    filterbank.apply(power.data(), mel.data());
+    for (size_t m = 0; m < 24; ++m) {
+        EXPECT_NEAR(log_mel[m], std::log(mel[m]), 1e-12) << "filter " << m;
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * Bush Ears - SlidingWindowMetrics tests
+ * Bucket roll-over, expiry, late samples and exports of the fixed-memory ring
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../src/metrics_window.hpp"
+
+namespace {
+
+constexpr size_t COLUMNS = SlidingWindowMetrics::COLUMNS;
+
+// Ten-second buckets, four of them: the ring covers 40 seconds
+SlidingWindowMetrics small_window() { return SlidingWindowMetrics(10.0, 4); }
+
+}  // namespace
+
+TEST(SlidingWindowMetrics, RejectsInvalidConfiguration) {
+    EXPECT_THROW(SlidingWindowMetrics(0.0, 4), std::invalid_argument);
+    EXPECT_THROW(SlidingWindowMetrics(-1.0, 4), std::invalid_argument);
+    EXPECT_THROW(SlidingWindowMetrics(std::nan(""), 4), std::invalid_argument);
+    EXPECT_THROW(SlidingWindowMetrics(10.0, 0), std::invalid_argument);
+}
+
+TEST(SlidingWindowMetrics, CountsWithinOneBucket) {
+    auto window = small_window();
+    window.add_detections(1.0, 2, 3);
+    window.add_detections(9.5, 2, 1);
+    window.add_detections(5.0, 4, 2);
+    window.add_frames(2.0, 100, 20);
+
+    auto scores = window.scores(9.9);
+    EXPECT_EQ(scores.window_seconds, 40.0);
+    EXPECT_EQ(scores.total_detections, 6u);
+    EXPECT_EQ(scores.species_richness, 2u);
+    EXPECT_EQ(scores.species_counts[2], 4u);
+    EXPECT_EQ(scores.species_counts[4], 2u);
+    EXPECT_EQ(scores.frames_analyzed, 100u);
+    EXPECT_EQ(scores.frames_skipped, 20u);
+
+    double expected_h = -(4.0 / 6.0) * std::log(4.0 / 6.0) - (2.0 / 6.0) * std::log(2.0 / 6.0);
+    EXPECT_NEAR(scores.biodiversity_index, expected_h, 1e-12);
+    double expected_conservation =
+        (4 * SPECIES_TABLE[2].conservation_weight + 2 * SPECIES_TABLE[4].conservation_weight) / 6.0;
+    EXPECT_NEAR(scores.conservation_score, expected_conservation, 1e-12);
+}
+
+TEST(SlidingWindowMetrics, BucketsExpireAfterTheRing) {
+    auto window = small_window();
+    window.add_detections(5.0, 1, 1);   // Bucket 0
+    window.add_detections(15.0, 1, 2);  // Bucket 1
+    window.add_detections(25.0, 1, 4);  // Bucket 2
+    window.add_detections(35.0, 1, 8);  // Bucket 3: the ring is full
+
+    EXPECT_EQ(window.scores(39.0).total_detections, 15u);
+    EXPECT_EQ(window.scores(40.0).total_detections, 14u);  // Bucket 4 reuses bucket 0's slot
+    EXPECT_EQ(window.scores(59.9).total_detections, 12u);
+    EXPECT_EQ(window.scores(60.0).total_detections, 8u);
+    EXPECT_EQ(window.scores(79.9).total_detections, 0u);
+}
+
+TEST(SlidingWindowMetrics, IdleGapLongerThanTheRingClearsIt) {
+    auto window = small_window();
+    for (int t = 0; t < 40; t += 10) {
+        window.add_detections(t, 0, 5);
+        window.add_frames(t, 10, 1);
+    }
+    window.add_detections(1000.0, 3, 1);
+
+    auto scores = window.scores(1000.0);
+    EXPECT_EQ(scores.total_detections, 1u);
+    EXPECT_EQ(scores.species_counts[0], 0u);
+    EXPECT_EQ(scores.frames_analyzed, 0u);
+    EXPECT_EQ(scores.frames_skipped, 0u);
+}
+
+TEST(SlidingWindowMetrics, PartialWindowsSumTheNewestBuckets) {
+    auto window = small_window();
+    window.add_detections(5.0, 0, 1);
+    window.add_detections(15.0, 0, 2);
+    window.add_detections(25.0, 0, 4);
+    window.add_detections(35.0, 0, 8);
+
+    EXPECT_EQ(window.scores(35.0, 1.0).total_detections, 8u);   // At least one bucket
+    EXPECT_EQ(window.scores(35.0, 10.0).total_detections, 8u);
+    EXPECT_EQ(window.scores(35.0, 11.0).total_detections, 12u);  // Rounded up to whole buckets
+    EXPECT_EQ(window.scores(35.0, 11.0).window_seconds, 20.0);
+    EXPECT_EQ(window.scores(35.0, 1000.0).total_detections, 15u);
+}
+
+TEST(SlidingWindowMetrics, LateSamplesLandInTheirOwnBucket) {
+    auto window = small_window();
+    window.add_detections(35.0, 0, 1);
+    window.add_detections(12.0, 0, 2);  // Still in the ring
+    window.add_detections(-10.0, 0, 4);  // Older than the ring: dropped
+
+    EXPECT_EQ(window.scores(35.0).total_detections, 3u);
+    EXPECT_EQ(window.scores(35.0, 10.0).total_detections, 1u);
+    EXPECT_EQ(window.scores(40.0).total_detections, 3u);
+    EXPECT_EQ(window.scores(50.0).total_detections, 1u);  // Bucket 1 expired with the late count
+}
+
+TEST(SlidingWindowMetrics, ExportsOldestBucketFirst) {
+    auto window = small_window();
+    window.add_detections(15.0, 1, 2);
+    window.add_frames(25.0, 7, 3);
+    window.add_detections(45.0, 0, 9);  // Bucket 4: bucket 0 expired
+
+    auto snapshot = window.export_window(45.0);
+    EXPECT_EQ(snapshot.start_time, 10.0);
+    EXPECT_EQ(snapshot.bucket_seconds, 10.0);
+    EXPECT_EQ(snapshot.num_buckets, 4u);
+    ASSERT_EQ(snapshot.cells.size(), 4 * COLUMNS);
+
+    std::vector<uint32_t> expected(4 * COLUMNS, 0);
+    expected[0 * COLUMNS + 1] = 2;
+    expected[1 * COLUMNS + SlidingWindowMetrics::FRAMES_ANALYZED] = 7;
+    expected[1 * COLUMNS + SlidingWindowMetrics::FRAMES_SKIPPED] = 3;
+    expected[3 * COLUMNS + 0] = 9;
+    EXPECT_EQ(snapshot.cells, expected);
+
+    std::vector<uint32_t> rows(4 * COLUMNS, 0xFFFFFFFF);
+    EXPECT_EQ(window.export_rows(45.0, rows.data()), 10.0);
+    EXPECT_EQ(rows, expected);
+}
+
+TEST(SlidingWindowMetrics, ExportAdvancesTheRing) {
+    auto window = small_window();
+    window.add_detections(5.0, 0, 1);
+    auto snapshot = window.export_window(100.0);
+    EXPECT_EQ(snapshot.start_time, 70.0);
+    EXPECT_EQ(snapshot.cells, std::vector<uint32_t>(4 * COLUMNS, 0));
+}
+
+TEST(SlidingWindowMetrics, ResetForgetsEverything) {
+    auto window = small_window();
+    window.add_detections(5.0, 0, 1);
+    window.add_frames(5.0, 10, 0);
+    window.reset();
+    window.add_detections(-100.0, 3, 2);  // The ring restarts wherever the next sample lands
+
+    auto scores = window.scores(-100.0);
+    EXPECT_EQ(scores.total_detections, 2u);
+    EXPECT_EQ(scores.species_counts[0], 0u);
+    EXPECT_EQ(scores.frames_analyzed, 0u);
+    EXPECT_EQ(scores.biodiversity_index, 0.0);
+}
@@ -0,0 +1,153 @@
+/*
+ * Bush Ears - MicroBatcher tests
+ * Batch limits, ordering, back-pressure and draining on close
+ */
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "../src/micro_batcher.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Records every batch; optionally holds the first one until released so later
+// requests pile up behind it
+class Recorder {
+public:
+    explicit Recorder(bool hold_first = false) : hold_first_(hold_first) {}
+
+    void operator()(std::vector<int>& batch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(batch);
+        }
+        if (hold_first_) {
+            hold_first_ = false;
+            entered_.set_value();
+            released_.get_future().wait();
+        }
+    }
+
+    void wait_entered() { entered_.get_future().wait(); }
+    void release() { released_.set_value(); }
+
+    std::vector<std::vector<int>> batches() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+private:
+    bool hold_first_;  // Only touched by the batcher thread after construction
+    std::promise<void> entered_;
+    std::promise<void> released_;
+    std::mutex mutex_;
+    std::vector<std::vector<int>> batches_;
+};
+
+MicroBatcher<int> make_batcher(Recorder& recorder, size_t max_batch, size_t capacity,
+                               std::chrono::microseconds max_wait = 0us) {
+    return MicroBatcher<int>(max_batch, capacity, max_wait, [&recorder](std::vector<int>& batch) { recorder(batch); });
+}
+
+bool submit(MicroBatcher<int>& batcher, int value) { return batcher.try_submit(value); }
+
+std::vector<size_t> sizes(const std::vector<std::vector<int>>& batches) {
+    std::vector<size_t> result;
+    for (const auto& batch : batches) {
+        result.push_back(batch.size());
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(MicroBatcher, RejectsEmptyLimits) {
+    auto ignore = [](std::vector<int>&) {};
+    EXPECT_THROW(MicroBatcher<int>(0, 8, 0us, ignore), std::invalid_argument);
+    EXPECT_THROW(MicroBatcher<int>(8, 0, 0us, ignore), std::invalid_argument);
+}
+
+TEST(MicroBatcher, HandlesEveryRequestInOrderWithinTheBatchLimit) {
+    Recorder recorder;
+    auto batcher = make_batcher(recorder, 7, 10000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(submit(batcher, i));
+    }
+    batcher.wait_idle();
+    EXPECT_EQ(batcher.pending(), 0u);
+
+    std::vector<int> handled;
+    for (const auto& batch : recorder.batches()) {
+        EXPECT_GE(batch.size(), 1u);
+        EXPECT_LE(batch.size(), 7u);
+        handled.insert(handled.end(), batch.begin(), batch.end());
+    }
+    ASSERT_EQ(handled.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(handled[i], i);
+    }
+}
+
+TEST(MicroBatcher, RequestsQueuedDuringABatchFormTheNext) {
+    Recorder recorder(true);
+    auto batcher = make_batcher(recorder, 4, 100);
+    ASSERT_TRUE(submit(batcher, 0));
+    recorder.wait_entered();
+    for (int i = 1; i <= 10; ++i) {
+        ASSERT_TRUE(submit(batcher, i));
+    }
+    EXPECT_EQ(batcher.pending(), 11u);
+    recorder.release();
+    batcher.wait_idle();
+    EXPECT_EQ(sizes(recorder.batches()), (std::vector<size_t>{1, 4, 4, 2}));
+}
+
+TEST(MicroBatcher, MaxWaitEndsOnceTheBatchIsFull) {
+    Recorder recorder;
+    auto batcher = make_batcher(recorder, 3, 100, std::chrono::microseconds(60s));
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(submit(batcher, i));
+    }
+    batcher.wait_idle();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 30s);
+    EXPECT_EQ(sizes(recorder.batches()), (std::vector<size_t>{3}));
+}
+
+TEST(MicroBatcher, FullQueueLeavesTheRequestWithTheCaller) {
+    Recorder recorder(true);
+    auto batcher = make_batcher(recorder, 8, 2);
+    ASSERT_TRUE(submit(batcher, 0));
+    recorder.wait_entered();  // Taken by the handler: no longer counts against capacity
+    EXPECT_TRUE(submit(batcher, 1));
+    EXPECT_TRUE(submit(batcher, 2));
+    EXPECT_FALSE(submit(batcher, 3));
+    recorder.release();
+    batcher.wait_idle();
+    EXPECT_EQ(recorder.batches(), (std::vector<std::vector<int>>{{0}, {1, 2}}));
+
+    MicroBatcher<std::string> strings(1, 1, 0us, [](std::vector<std::string>&) {});
+    strings.close();
+    std::string request = "chunk";
+    EXPECT_FALSE(strings.try_submit(request));
+    EXPECT_EQ(request, "chunk");
+}
+
+TEST(MicroBatcher, CloseHandlesWhatIsQueued) {
+    Recorder recorder;
+    auto batcher = make_batcher(recorder, 100, 100, std::chrono::microseconds(60s));
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(submit(batcher, i));
+    }
+    auto start = std::chrono::steady_clock::now();
+    batcher.close();  // Cuts max_wait short
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 30s);
+    EXPECT_EQ(recorder.batches(), (std::vector<std::vector<int>>{{0, 1, 2, 3, 4}}));
+    EXPECT_FALSE(submit(batcher, 5));
+    batcher.close();  // Idempotent
+}
@@ -0,0 +1,140 @@
+/*
+ * Bush Ears - Model file tests
+ * write_model_file -> MappedModelFile round trips, and every header the loader
+ * must refuse to map
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "../src/model_file.hpp"
+#include "audio_fixtures.hpp"
+
+namespace {
+
+constexpr uint32_t INPUT = 8;
+constexpr uint32_t HIDDEN = 16;
+constexpr uint32_t OUTPUT = 12;
+
+template <typename Weight>
+struct Weights {
+    std::vector<uint8_t> species;
+    std::vector<Weight> hidden;
+    std::vector<Weight> output;
+
+    Weights() : species(OUTPUT), hidden(INPUT * HIDDEN), output(HIDDEN * OUTPUT) {
+        for (size_t i = 0; i < species.size(); ++i) {
+            species[i] = static_cast<uint8_t>((i * 5) % OUTPUT);
+        }
+        for (size_t i = 0; i < hidden.size(); ++i) {
+            hidden[i] = static_cast<Weight>(0.25 * i - 3.0);
+        }
+        for (size_t i = 0; i < output.size(); ++i) {
+            output[i] = static_cast<Weight>(-0.125 * i);
+        }
+    }
+
+    void write(const std::string& path) const {
+        write_model_file(path, INPUT, HIDDEN, OUTPUT, species.data(), hidden.data(), output.data());
+    }
+};
+
+template <typename Weight>
+void expect_round_trip() {
+    fixtures::TempFile file("round_trip.model");
+    Weights<Weight> weights;
+    weights.write(file.path());
+
+    MappedModelFile mapped(file.path());
+    const ModelFileHeader& header = mapped.header();
+    EXPECT_EQ(header.dtype, model_dtype<Weight>());
+    EXPECT_EQ(header.input_dim, INPUT);
+    EXPECT_EQ(header.hidden_dim, HIDDEN);
+    EXPECT_EQ(header.output_dim, OUTPUT);
+    // Sections are used in place, so they must land on cache lines in the mapping
+    for (const void* section : {static_cast<const void*>(mapped.species_map()),
+                                static_cast<const void*>(mapped.hidden_weights<Weight>()),
+                                static_cast<const void*>(mapped.output_weights<Weight>())}) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(section) % 64, 0u);
+    }
+    EXPECT_EQ(std::vector<uint8_t>(mapped.species_map(), mapped.species_map() + OUTPUT), weights.species);
+    EXPECT_EQ(std::vector<Weight>(mapped.hidden_weights<Weight>(), mapped.hidden_weights<Weight>() + INPUT * HIDDEN),
+              weights.hidden);
+    EXPECT_EQ(std::vector<Weight>(mapped.output_weights<Weight>(), mapped.output_weights<Weight>() + HIDDEN * OUTPUT),
+              weights.output);
+}
+
+std::vector<uint8_t> read_bytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+// A valid float64 file with its header edited, which the loader must reject
+void expect_corrupt_header_rejected(const std::function<void(ModelFileHeader&)>& corrupt) {
+    fixtures::TempFile file("corrupt.model");
+    Weights<double> weights;
+    weights.write(file.path());
+    auto bytes = read_bytes(file.path());
+    ModelFileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    corrupt(header);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    file.write(bytes);
+    EXPECT_THROW(MappedModelFile mapped(file.path()), std::runtime_error);
+}
+
+}  // namespace
+
+TEST(ModelFile, Float64RoundTrips) {
+    expect_round_trip<double>();
+}
+
+TEST(ModelFile, Float32RoundTrips) {
+    expect_round_trip<float>();
+}
+
+TEST(ModelFile, MissingOrShortFilesAreRejected) {
+    EXPECT_THROW(MappedModelFile(::testing::TempDir() + "bush_ears_missing.model"), std::runtime_error);
+
+    fixtures::TempFile file("short.model");
+    file.write(std::vector<uint8_t>(sizeof(ModelFileHeader) - 1, 0));
+    EXPECT_THROW(MappedModelFile mapped(file.path()), std::runtime_error);
+}
+
+TEST(ModelFile, TruncatedFilesAreRejected) {
+    fixtures::TempFile file("truncated.model");
+    Weights<double> weights;
+    weights.write(file.path());
+    auto bytes = read_bytes(file.path());
+    bytes.pop_back();
+    file.write(bytes);
+    EXPECT_THROW(MappedModelFile mapped(file.path()), std::runtime_error);
+}
+
+TEST(ModelFile, CorruptHeadersAreRejected) {
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.magic[0] = 'X'; });
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.version = ModelFileHeader::VERSION + 1; });
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.dtype = 7; });
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.file_size += 64; });
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.hidden_offset += 8; });    // Misaligned
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.species_offset = 0; });   // Inside the header
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.output_offset += 64; });  // Runs past the end
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.output_dim = 4096; });
+}
+
+// Offsets and dimensions big enough to wrap 64-bit bounds arithmetic
+TEST(ModelFile, OverflowingSectionsAreRejected) {
+    constexpr uint64_t MAX = std::numeric_limits<uint64_t>::max();
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.output_offset = MAX & ~uint64_t{63}; });
+    expect_corrupt_header_rejected([](ModelFileHeader& h) {
+        h.input_dim = std::numeric_limits<uint32_t>::max();
+        h.hidden_dim = std::numeric_limits<uint32_t>::max();
+    });
+    expect_corrupt_header_rejected([](ModelFileHeader& h) { h.hidden_dim = 1u << 31; });
+}
@@ -0,0 +1,865 @@
+/*
+ * Bush Ears - Pipeline tests
+ * The extension's native core (sample ingestion, streaming, monitors) driven from
+ * C++ under an embedded interpreter, without NumPy
+ */
+
+#include "../src/main.cpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/embed.h>
+
+#include "audio_fixtures.hpp"
+
+#include <atomic>
+#include <complex>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Birdsong-like test signal: a swept tone over low-level noise, fixed seed
+std::vector<double> test_audio(size_t num_samples, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    std::vector<double> audio(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        double t = static_cast<double>(i) / AudioProcessor::SAMPLE_RATE;
+        audio[i] = 0.5 * std::sin(2.0 * M_PI * (2000.0 + 1500.0 * t) * t) + noise(rng);
+    }
+    return audio;
+}
+
+std::vector<int16_t> to_int16(const std::vector<double>& audio) {
+    std::vector<int16_t> pcm(audio.size());
+    std::transform(audio.begin(), audio.end(), pcm.begin(), [](double x) {
+        return static_cast<int16_t>(std::clamp(std::lround(x * 32768.0), -32768l, 32767l));
+    });
+    return pcm;
+}
+
+}  // namespace
+
+// -- Sample ingestion --------------------------------------------------------
+
+TEST(SampleValue, ScalesInt16ToUnitRange) {
+    EXPECT_EQ((sample_value<double, int16_t>(-32768)), -1.0);
+    EXPECT_EQ((sample_value<double, int16_t>(0)), 0.0);
+    EXPECT_EQ((sample_value<double, int16_t>(16384)), 0.5);
+    EXPECT_EQ((sample_value<double, int16_t>(32767)), 32767.0 / 32768.0);
+    EXPECT_EQ((sample_value<float, int16_t>(-16384)), -0.5f);
+}
+
+TEST(SampleValue, PassesFloatingPointThrough) {
+    EXPECT_EQ((sample_value<double, double>(0.25)), 0.25);
+    EXPECT_EQ((sample_value<double, float>(-0.75f)), -0.75);
+    EXPECT_EQ((sample_value<float, double>(1.5)), 1.5f);
+}
+
+TEST(SampleIngestion, Int16FeaturesMatchScaledFloat64) {
+    auto pcm = to_int16(test_audio(AudioProcessor::FFT_SIZE));
+    std::vector<double> scaled(pcm.size());
+    std::transform(pcm.begin(), pcm.end(), scaled.begin(), [](int16_t x) { return x / 32768.0; });
+
+    AudioProcessor processor;
+    auto from_pcm = processor.extract_features(std::span<const int16_t>(pcm));
+    auto from_double = processor.extract_features(std::span<const double>(scaled));
+    ASSERT_EQ(from_pcm.size(), from_double.size());
+    for (size_t i = 0; i < from_pcm.size(); ++i) {
+        EXPECT_NEAR(from_pcm[i], from_double[i], 1e-9 * std::max(1.0, std::abs(from_double[i]))) << "feature " << i;
+    }
+}
+
+TEST(SampleIngestion, Float32FeaturesTrackFloat64) {
+    auto audio = test_audio(AudioProcessor::FFT_SIZE);
+    std::vector<float> narrow(audio.begin(), audio.end());
+
+    AudioProcessor processor;
+    auto from_float = processor.extract_features(std::span<const float>(narrow));
+    auto from_double = processor.extract_features(std::span<const double>(audio));
+    for (size_t i = 0; i < from_float.size(); ++i) {
+        EXPECT_NEAR(from_float[i], from_double[i], 1e-4 * std::max(1.0, std::abs(from_double[i]))) << "feature " << i;
+    }
+}
+
+TEST(SampleIngestion, ShortSegmentsAreRejected) {
+    AudioProcessor processor;
+    std::vector<int16_t> too_short(AudioProcessor::FFT_SIZE - 1);
+    EXPECT_THROW(processor.extract_features(std::span<const int16_t>(too_short)), std::runtime_error);
+}
+
+// -- Spectral features -------------------------------------------------------
+
+namespace {
+
+// The eight features computed the long way: a naive DFT of the Hann-windowed frame,
+// then each feature in its own pass
+std::vector<double> reference_features(const std::vector<double>& frame) {
+    constexpr size_t N = AudioProcessor::FFT_SIZE;
+    constexpr size_t BINS = AudioProcessor::FREQ_BINS;
+    constexpr double BIN_HZ = static_cast<double>(AudioProcessor::SAMPLE_RATE) / N;
+    constexpr std::array<size_t, 5> BAND_EDGES = {0, 23, 93, 186, BINS};  // 0, 1, 4, 8 kHz, Nyquist
+
+    std::vector<double> magnitude(BINS);
+    for (size_t k = 0; k < BINS; ++k) {
+        std::complex<double> sum;
+        for (size_t t = 0; t < N; ++t) {
+            double window = 0.5 * (1.0 - std::cos(2.0 * M_PI * t / (N - 1)));
+            double angle = -2.0 * M_PI * static_cast<double>(k * t % N) / N;
+            sum += window * frame[t] * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        magnitude[k] = std::abs(sum);
+    }
+
+    double total = 0.0, weighted = 0.0;
+    for (size_t k = 0; k < BINS; ++k) {
+        total += magnitude[k];
+        weighted += k * BIN_HZ * magnitude[k];
+    }
+    double centroid = weighted / total;
+    double spread = 0.0;
+    for (size_t k = 0; k < BINS; ++k) {
+        spread += (k * BIN_HZ - centroid) * (k * BIN_HZ - centroid) * magnitude[k];
+    }
+    double rolloff = AudioProcessor::SAMPLE_RATE / 2.0;
+    double cumulative = 0.0;
+    for (size_t k = 0; k < BINS; ++k) {
+        cumulative += magnitude[k];
+        if (cumulative >= 0.85 * total) {
+            rolloff = k * BIN_HZ;
+            break;
+        }
+    }
+    std::vector<double> features = {centroid, std::sqrt(spread / total), rolloff,
+                                    AudioProcessor::compute_zero_crossing_rate(std::span<const double>(frame))};
+    for (size_t band = 0; band < 4; ++band) {
+        features.push_back(std::accumulate(magnitude.begin() + BAND_EDGES[band],
+                                           magnitude.begin() + BAND_EDGES[band + 1], 0.0));
+    }
+    return features;
+}
+
+}  // namespace
+
+// One fused, vectorized pass gives the same features as a pass per feature
+TEST(SpectralFeatures, FusedPassMatchesOnePassPerFeature) {
+    for (unsigned seed : {1u, 2u, 3u}) {
+        auto frame = test_audio(AudioProcessor::FFT_SIZE, seed);
+        AudioProcessor processor;
+        auto features = processor.extract_features(std::span<const double>(frame));
+        auto expected = reference_features(frame);
+        ASSERT_EQ(features.size(), expected.size());
+        for (size_t i = 0; i < features.size(); ++i) {
+            EXPECT_NEAR(features[i], expected[i], 1e-9 * std::max(1.0, std::abs(expected[i])))
+                << "feature " << i << ", seed " << seed;
+        }
+    }
+}
+
+// -- Frame counting and streaming -------------------------------------------
+
+TEST(FrameCount, CountsCompleteFramesOnTheHopGrid) {
+    constexpr size_t FFT = AudioProcessor::FFT_SIZE;
+    constexpr size_t HOP = AudioProcessor::HOP_SIZE;
+    EXPECT_EQ(AudioProcessor::frame_count(0), 0u);
+    EXPECT_EQ(AudioProcessor::frame_count(FFT - 1), 0u);
+    EXPECT_EQ(AudioProcessor::frame_count(FFT), 1u);
+    EXPECT_EQ(AudioProcessor::frame_count(FFT + HOP - 1), 1u);
+    EXPECT_EQ(AudioProcessor::frame_count(FFT + HOP), 2u);
+    EXPECT_EQ(AudioProcessor::frame_count(FFT + 10 * HOP + 3), 11u);
+}
+
+// Irregular chunk sizes, including empty chunks and chunks longer than a frame
+TEST(StreamingFeatureExtractor, ChunkedFramesMatchOfflineExtraction) {
+    constexpr size_t FFT = AudioProcessor::FFT_SIZE;
+    constexpr size_t HOP = AudioProcessor::HOP_SIZE;
+    auto audio = test_audio(20 * HOP + 77);
+    const size_t chunk_sizes[] = {1, 0, 511, 513, 3000, 7, 1024, 2048, 64};
+
+    StreamingFeatureExtractor extractor;
+    std::vector<std::vector<double>> frames;
+    size_t offset = 0;
+    for (size_t i = 0; offset < audio.size(); ++i) {
+        size_t n = std::min(chunk_sizes[i % std::size(chunk_sizes)], audio.size() - offset);
+        auto chunk = std::span<const double>(audio).subspan(offset, n);
+        size_t expected = extractor.pending_frames(n);
+        size_t before = frames.size();
+        size_t completed = extractor.push(chunk, [&](std::span<const double> features) {
+            frames.emplace_back(features.begin(), features.end());
+        });
+        EXPECT_EQ(completed, expected) << "chunk " << i;
+        EXPECT_EQ(frames.size() - before, expected) << "chunk " << i;
+        offset += n;
+    }
+
+    ASSERT_EQ(frames.size(), AudioProcessor::frame_count(audio.size()));
+    EXPECT_EQ(extractor.frames_emitted(), frames.size());
+    EXPECT_EQ(extractor.samples_pushed(), audio.size());
+    EXPECT_EQ(extractor.next_frame_start(), frames.size() * HOP);
+
+    AudioProcessor processor;
+    for (size_t k = 0; k < frames.size(); ++k) {
+        auto expected = processor.extract_features(std::span<const double>(audio).subspan(k * HOP, FFT));
+        for (size_t f = 0; f < expected.size(); ++f) {
+            EXPECT_NEAR(frames[k][f], expected[f], 1e-9 * std::max(1.0, std::abs(expected[f])))
+                << "frame " << k << " feature " << f;
+        }
+    }
+}
+
+TEST(StreamingFeatureExtractor, ResetRestartsTheFrameGrid) {
+    constexpr size_t FFT = AudioProcessor::FFT_SIZE;
+    auto audio = test_audio(FFT);
+    StreamingFeatureExtractor extractor;
+    auto ignore = [](std::span<const double>) {};
+    EXPECT_EQ(extractor.push(std::span<const double>(audio).first(FFT / 2), ignore), 0u);
+    extractor.reset();
+    EXPECT_EQ(extractor.samples_pushed(), 0u);
+    EXPECT_EQ(extractor.pending_frames(FFT - 1), 0u);
+    EXPECT_EQ(extractor.pending_frames(FFT), 1u);
+    EXPECT_EQ(extractor.push(std::span<const double>(audio), ignore), 1u);
+}
+
+// -- Event segmentation settings --------------------------------------------
+
+TEST(EventSegmenterSettings, UpdatesEditTheCurrentSettings) {
+    EcosystemMonitor monitor;
+    auto magpie = static_cast<size_t>(AustralianSpecies::Magpie);
+    monitor.update_event_segmenter([](EventSegmenterConfig& config) { config.enabled = false; });
+    monitor.update_event_segmenter([&](EventSegmenterConfig& config) {
+        config.species[magpie].onset_confidence = 0.8;
+    });
+    auto config = monitor.event_segmenter_config();
+    EXPECT_FALSE(config.enabled);  // Kept by the second update
+    EXPECT_EQ(config.species[magpie].onset_confidence, 0.8);
+    EXPECT_EQ(config.species[0].onset_confidence, EventSegmenterConfig{}.species[0].onset_confidence);
+}
+
+// -- Archive scanning --------------------------------------------------------
+
+namespace {
+
+// Random weights with sharp outputs, so calls land on several species
+void write_test_model(const std::string& path) {
+    std::mt19937 rng(11);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> hidden(8 * 16);
+    std::vector<double> output(16 * 12);
+    for (auto& weight : hidden) {
+        weight = 0.002 * normal(rng);
+    }
+    for (auto& weight : output) {
+        weight = 3.0 * normal(rng);
+    }
+    std::vector<uint8_t> species(12);
+    for (size_t i = 0; i < species.size(); ++i) {
+        species[i] = static_cast<uint8_t>(i < 11 ? i + 1 : 0);
+    }
+    write_model_file(path, 8, 16, 12, species.data(), hidden.data(), output.data());
+}
+
+// Bursts of swept tone that start and stop, differently on each channel
+std::vector<std::vector<int32_t>> call_bursts(size_t num_samples, size_t num_channels) {
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    std::vector<std::vector<int32_t>> channels(num_channels, std::vector<int32_t>(num_samples));
+    for (size_t i = 0; i < num_samples; ++i) {
+        double t = static_cast<double>(i) / AudioProcessor::SAMPLE_RATE;
+        for (size_t c = 0; c < num_channels; ++c) {
+            double frequency = 800.0 + 3000.0 * std::fmod(t * (0.3 + 0.2 * c), 1.0);
+            double envelope = std::sin(t * (2.0 + c)) > 0.2 ? 0.6 : 0.02;
+            double x = envelope * std::sin(2.0 * M_PI * frequency * t) + noise(rng);
+            channels[c][i] = static_cast<int32_t>(std::clamp(x * 32767.0, -32768.0, 32767.0));
+        }
+    }
+    return channels;
+}
+
+}  // namespace
+
+// Blocks are scored out of order on the pool, but their frames are segmented in file
+// order, so the archive counts are the events a live monitor reports for the same audio
+TEST(ScanArchive, CountsTheEventsStreamingReports) {
+    constexpr size_t NUM_SAMPLES = 4 * AudioProcessor::SAMPLE_RATE;  // Three read blocks
+    constexpr size_t NUM_CHANNELS = 2;
+    fixtures::TempFile model("scan.model");
+    write_test_model(model.path());
+    auto channels = call_bursts(NUM_SAMPLES, NUM_CHANNELS);
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+        for (const auto& channel : channels) {
+            fixtures::append_le<int32_t>(data, channel[i], 2);
+        }
+    }
+    fixtures::TempFile recording("scan.wav");
+    recording.write(fixtures::wav_bytes(fixtures::WavFormat{1, NUM_CHANNELS, AudioProcessor::SAMPLE_RATE, 16}, data));
+
+    EcosystemMonitor live(model.path());
+    std::vector<int16_t> planar;
+    for (const auto& channel : channels) {
+        planar.insert(planar.end(), channel.begin(), channel.end());
+    }
+    live.ingest_channels(planar.data(), NUM_CHANNELS, NUM_SAMPLES, false);
+    live.flush_events();
+    auto expected = live.window_scores(0.0);
+    ASSERT_GT(expected.species_richness, 1u);
+
+    size_t pool_threads = SharedThreadPool::size();
+    for (size_t threads : {1, 3}) {
+        SharedThreadPool::resize(threads);
+        EcosystemMonitor archive(model.path());
+        auto summaries = archive.scan_archive({recording.path(), recording.path()}, 2, 1);
+        ASSERT_EQ(summaries.size(), 2u);
+        for (const auto& summary : summaries) {
+            EXPECT_TRUE(summary.error.empty()) << summary.error;
+            EXPECT_EQ(summary.channels, NUM_CHANNELS);
+            EXPECT_EQ(summary.frames_analyzed, NUM_CHANNELS * AudioProcessor::frame_count(NUM_SAMPLES));
+            EXPECT_EQ(summary.detections, expected.total_detections) << threads << " threads";
+            EXPECT_EQ(summary.species_counts, expected.species_counts) << threads << " threads";
+        }
+    }
+    SharedThreadPool::resize(pool_threads);
+}
+
+TEST(IngestChannels, SnapshotCountsEveryChannel) {
+    constexpr size_t NUM_SAMPLES = AudioProcessor::SAMPLE_RATE;
+    fixtures::TempFile model("channels.model");
+    write_test_model(model.path());
+    auto channels = call_bursts(NUM_SAMPLES, 3);
+    std::vector<int16_t> planar;
+    for (const auto& channel : channels) {
+        planar.insert(planar.end(), channel.begin(), channel.end());
+    }
+
+    EcosystemMonitor monitor(model.path());
+    int per_channel[3] = {};
+    size_t found = monitor.ingest_channels(planar.data(), 3, NUM_SAMPLES, false, per_channel);
+    ASSERT_GT(found, 0u);
+    EXPECT_EQ(monitor.num_channels(), 3u);
+    auto snapshot = monitor.ecosystem_snapshot();
+    ASSERT_EQ(snapshot.channel_detections.size(), 3u);
+    size_t total = 0;
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_EQ(snapshot.channel_detections[c], static_cast<size_t>(per_channel[c]));
+        total += snapshot.channel_detections[c];
+    }
+    EXPECT_EQ(total, found);
+    EXPECT_EQ(snapshot.total_detections, found);
+    EXPECT_EQ(snapshot.frames_analyzed, 3 * AudioProcessor::frame_count(NUM_SAMPLES));
+}
+
+// Files of different lengths and layouts, read concurrently through a one-block
+// queue, each summarised in input order as if scanned alone
+TEST(ScanArchive, SummarisesEveryPathInOrder) {
+    fixtures::TempFile model("summaries.model");
+    write_test_model(model.path());
+    struct Recording {
+        size_t samples;
+        size_t channels;
+        std::unique_ptr<fixtures::TempFile> file;
+    };
+    std::vector<Recording> recordings;
+    for (auto [samples, channels] : {std::pair<size_t, size_t>{AudioProcessor::SAMPLE_RATE / 2, 1},
+                                     {3 * AudioProcessor::SAMPLE_RATE, 2},
+                                     {AudioProcessor::FFT_SIZE - 1, 1}}) {  // Too short for a frame
+        auto signal = call_bursts(samples, channels);
+        std::vector<uint8_t> data;
+        for (size_t i = 0; i < samples; ++i) {
+            for (const auto& channel : signal) {
+                fixtures::append_le<int32_t>(data, channel[i], 2);
+            }
+        }
+        auto file = std::make_unique<fixtures::TempFile>("summary" + std::to_string(recordings.size()) + ".wav");
+        file->write(fixtures::wav_bytes(
+            fixtures::WavFormat{1, static_cast<uint16_t>(channels), AudioProcessor::SAMPLE_RATE, 16}, data));
+        recordings.push_back({samples, channels, std::move(file)});
+    }
+    std::vector<const Recording*> listed = {&recordings[0], nullptr, &recordings[1], &recordings[2]};
+    std::vector<std::string> paths;
+    for (const Recording* recording : listed) {
+        paths.push_back(recording ? recording->file->path() : ::testing::TempDir() + "bush_ears_missing.wav");
+    }
+
+    EcosystemMonitor monitor(model.path());
+    auto summaries = monitor.scan_archive(paths, 3, 1);
+    ASSERT_EQ(summaries.size(), paths.size());
+    EXPECT_FALSE(summaries[1].error.empty());
+    for (size_t f : {0, 2, 3}) {
+        const Recording& recording = *listed[f];
+        const FileScanSummary& summary = summaries[f];
+        EXPECT_EQ(summary.path, paths[f]);
+        EXPECT_TRUE(summary.error.empty()) << summary.error;
+        EXPECT_EQ(summary.sample_rate, AudioProcessor::SAMPLE_RATE);
+        EXPECT_EQ(summary.channels, recording.channels);
+        EXPECT_DOUBLE_EQ(summary.duration_seconds,
+                         static_cast<double>(recording.samples) / AudioProcessor::SAMPLE_RATE);
+        EXPECT_EQ(summary.frames_analyzed, recording.channels * AudioProcessor::frame_count(recording.samples));
+
+        auto alone = EcosystemMonitor(model.path()).scan_archive({paths[f]}, 1, 0);
+        ASSERT_EQ(alone.size(), 1u);
+        EXPECT_EQ(summary.detections, alone[0].detections) << paths[f];
+        EXPECT_EQ(summary.species_counts, alone[0].species_counts) << paths[f];
+    }
+    EXPECT_EQ(summaries[3].detections, 0u);
+    EXPECT_GT(summaries[2].detections, 0u);
+
+    EXPECT_TRUE(monitor.scan_archive({}, 4, 0).empty());
+}
+
+TEST(ScanArchive, UnreadableFilesReportAnError) {
+    EcosystemMonitor monitor;
+    auto summaries = monitor.scan_archive({::testing::TempDir() + "bush_ears_missing.wav"}, 1, 0);
+    ASSERT_EQ(summaries.size(), 1u);
+    EXPECT_FALSE(summaries[0].error.empty());
+    EXPECT_EQ(summaries[0].detections, 0u);
+}
+
+// -- Classifier batches ------------------------------------------------------
+
+namespace {
+
+// Features of consecutive hops of a call burst, row-major, so rows span several
+// species and confidences
+std::vector<double> burst_features(size_t num_rows) {
+    auto burst = call_bursts(AudioProcessor::FFT_SIZE + num_rows * AudioProcessor::HOP_SIZE, 1)[0];
+    std::vector<int16_t> pcm(burst.begin(), burst.end());
+    AudioProcessor processor;
+    std::vector<double> rows(num_rows * WildlifeClassifier::INPUT_DIM);
+    for (size_t r = 0; r < num_rows; ++r) {
+        auto frame = std::span<const int16_t>(pcm).subspan(r * AudioProcessor::HOP_SIZE, AudioProcessor::FFT_SIZE);
+        processor.extract_features(frame, rows.data() + r * WildlifeClassifier::INPUT_DIM);
+    }
+    return rows;
+}
+
+WildlifeClassifier::FeatureVector feature_row(const std::vector<double>& rows, size_t r) {
+    return WildlifeClassifier::FeatureVector(rows.data() + r * WildlifeClassifier::INPUT_DIM,
+                                             WildlifeClassifier::INPUT_DIM);
+}
+
+}  // namespace
+
+// Three full blocks and a partial one, against one forward pass per row
+TEST(ClassifyBatch, BlocksMatchRowByRowInference) {
+    constexpr size_t ROWS = 3 * WildlifeClassifier::BATCH_BLOCK + 5;
+    constexpr size_t OUT = WildlifeClassifier::OUTPUT_DIM;
+    fixtures::TempFile model("batch.model");
+    write_test_model(model.path());
+    WildlifeClassifier classifier(model.path());
+    auto rows = burst_features(ROWS);
+
+    std::vector<int> species(ROWS, -1);
+    classifier.classify_batch(rows.data(), ROWS, species.data());
+    std::vector<double> probabilities(ROWS * OUT);
+    classifier.predict_probabilities_batch(rows.data(), ROWS, probabilities.data());
+
+    std::set<int> seen;
+    for (size_t r = 0; r < ROWS; ++r) {
+        EXPECT_EQ(species[r], static_cast<int>(classifier.classify_audio_features(feature_row(rows, r)))) << "row " << r;
+        WildlifeClassifier::Probabilities expected;
+        classifier.predict_probabilities(feature_row(rows, r), expected);
+        for (size_t o = 0; o < OUT; ++o) {
+            EXPECT_NEAR(probabilities[r * OUT + o], expected[o], 1e-12) << "row " << r << ", unit " << o;
+        }
+        seen.insert(species[r]);
+    }
+    EXPECT_GT(seen.size(), 1u);  // The rows do not all land on one species
+
+    classifier.classify_batch(rows.data(), 0, species.data());  // Empty batches write nothing
+}
+
+// The columnar path gathers each block from the columns and must agree bit for bit
+// with the row-major path, including on a subview that starts mid row group
+TEST(ClassifyBatch, ColumnarFeaturesMatchRowMajor) {
+    constexpr size_t ROWS = 2 * WildlifeClassifier::BATCH_BLOCK + 13;
+    constexpr size_t OUT = WildlifeClassifier::OUTPUT_DIM;
+    fixtures::TempFile model("columnar.model");
+    write_test_model(model.path());
+    WildlifeClassifier classifier(model.path());
+    auto rows = burst_features(ROWS);
+    WildlifeClassifier::FeatureMatrix matrix(ROWS);
+    for (size_t r = 0; r < ROWS; ++r) {
+        matrix.set_row(r, rows.data() + r * WildlifeClassifier::INPUT_DIM);
+    }
+
+    auto classify = [&](auto features, size_t num_rows) {
+        std::pair<std::vector<int>, std::vector<double>> out{std::vector<int>(num_rows),
+                                                             std::vector<double>(num_rows * OUT)};
+        classifier.classify_batch(features, num_rows,
+                                  {out.first.data(), nullptr, out.second.data(), 0, nullptr, nullptr});
+        return out;
+    };
+    auto columnar = [&](WildlifeClassifier::FeatureMatrix::View view) {
+        std::pair<std::vector<int>, std::vector<double>> out{std::vector<int>(view.rows),
+                                                             std::vector<double>(view.rows * OUT)};
+        classifier.classify_batch(view, {out.first.data(), nullptr, out.second.data(), 0, nullptr, nullptr});
+        return out;
+    };
+    EXPECT_EQ(columnar(matrix.view()), classify(rows.data(), ROWS));
+
+    constexpr size_t FIRST = 3, COUNT = WildlifeClassifier::BATCH_BLOCK + 1;
+    EXPECT_EQ(columnar(matrix.view().subview(FIRST, COUNT)),
+              classify(rows.data() + FIRST * WildlifeClassifier::INPUT_DIM, COUNT));
+}
+
+// Probabilities, confidences and top-k all come out of one forward pass and agree
+TEST(ClassifyBatch, TopKRanksTheProbabilityRows) {
+    constexpr size_t ROWS = WildlifeClassifier::BATCH_BLOCK + 9;
+    constexpr size_t OUT = WildlifeClassifier::OUTPUT_DIM;
+    constexpr size_t K = 3;
+    fixtures::TempFile model("top_k.model");
+    write_test_model(model.path());
+    WildlifeClassifier classifier(model.path());
+    classifier.set_unknown_threshold(0.0);
+    auto rows = burst_features(ROWS);
+
+    std::vector<int> species(ROWS), top_species(ROWS * K);
+    std::vector<double> confidences(ROWS), probabilities(ROWS * OUT), top_scores(ROWS * K);
+    classifier.classify_batch(rows.data(), ROWS, {species.data(), confidences.data(), probabilities.data(), K,
+                                                  top_species.data(), top_scores.data()});
+    for (size_t r = 0; r < ROWS; ++r) {
+        const double* row = probabilities.data() + r * OUT;
+        EXPECT_NEAR(std::accumulate(row, row + OUT, 0.0), 1.0, 1e-12);
+        std::vector<double> sorted(row, row + OUT);
+        std::sort(sorted.rbegin(), sorted.rend());
+        for (size_t k = 0; k < K; ++k) {
+            EXPECT_EQ(top_scores[r * K + k], sorted[k]) << "row " << r << ", rank " << k;
+            size_t unit = std::find(row, row + OUT, top_scores[r * K + k]) - row;
+            EXPECT_EQ(top_species[r * K + k], static_cast<int>(classifier.output_species(unit)));
+        }
+        EXPECT_EQ(confidences[r], top_scores[r * K]);
+        EXPECT_EQ(species[r], top_species[r * K]);  // With no threshold the best unit always wins
+    }
+
+    std::vector<int> all_species(OUT);
+    std::vector<double> all_scores(OUT);
+    classifier.classify_batch(rows.data(), 1, {nullptr, nullptr, nullptr, OUT, all_species.data(), all_scores.data()});
+    EXPECT_TRUE(std::is_sorted(all_scores.rbegin(), all_scores.rend()));
+    EXPECT_THROW(classifier.classify_batch(rows.data(), 1, {nullptr, nullptr, nullptr, OUT + 1, all_species.data(),
+                                                            all_scores.data()}),
+                 std::invalid_argument);
+}
+
+// Rows whose best probability falls below the threshold classify as Unknown, on the
+// batched and single-row paths alike
+TEST(ClassifyBatch, UnknownThresholdAppliesToEveryPath) {
+    constexpr size_t ROWS = 2 * WildlifeClassifier::BATCH_BLOCK;
+    const int UNKNOWN = static_cast<int>(AustralianSpecies::Unknown);
+    fixtures::TempFile model("threshold.model");
+    write_test_model(model.path());
+    WildlifeClassifier classifier(model.path());
+    auto rows = burst_features(ROWS);
+
+    std::vector<int> best(ROWS);
+    std::vector<double> confidences(ROWS);
+    classifier.set_unknown_threshold(0.0);
+    classifier.classify_batch(rows.data(), ROWS, {best.data(), confidences.data()});
+    std::vector<double> sorted = confidences;
+    std::sort(sorted.begin(), sorted.end());
+    double threshold = sorted[ROWS / 2];
+    ASSERT_GT(threshold, sorted.front());
+
+    classifier.set_unknown_threshold(threshold);
+    EXPECT_EQ(classifier.unknown_threshold(), threshold);
+    std::vector<int> species(ROWS);
+    classifier.classify_batch(rows.data(), ROWS, species.data());
+    size_t unknown = 0;
+    for (size_t r = 0; r < ROWS; ++r) {
+        int expected = confidences[r] < threshold ? UNKNOWN : best[r];
+        EXPECT_EQ(species[r], expected) << "row " << r;
+        EXPECT_EQ(static_cast<int>(classifier.classify_audio_features(feature_row(rows, r))), expected) << "row " << r;
+        unknown += species[r] == UNKNOWN;
+    }
+    EXPECT_GE(unknown, ROWS / 2);
+
+    EXPECT_THROW(classifier.set_unknown_threshold(-0.1), std::invalid_argument);
+    EXPECT_THROW(classifier.set_unknown_threshold(1.5), std::invalid_argument);
+    EXPECT_THROW(classifier.set_unknown_threshold(std::nan("")), std::invalid_argument);
+    EXPECT_EQ(classifier.unknown_threshold(), threshold);
+
+    EcosystemMonitor monitor(model.path());
+    EXPECT_EQ(monitor.unknown_threshold(), WildlifeClassifier::DEFAULT_UNKNOWN_THRESHOLD);
+    monitor.set_unknown_threshold(0.75);
+    EXPECT_EQ(monitor.unknown_threshold(), 0.75);
+}
+
+// A saved model reloads as the same network, mapped in place or converted to the
+// other precision, and files of another shape are refused
+TEST(ClassifierModel, SavedModelsReloadInEitherPrecision) {
+    constexpr size_t ROWS = 50;
+    fixtures::TempFile trained("trained.model");
+    write_test_model(trained.path());
+    WildlifeClassifier original(trained.path());
+    fixtures::TempFile saved("saved.model");
+    original.save_model(saved.path());
+
+    WildlifeClassifier reloaded(saved.path());
+    WildlifeClassifierF32 narrowed(saved.path());
+    auto rows = burst_features(ROWS);
+    std::vector<float> narrow_rows(rows.begin(), rows.end());
+    for (size_t r = 0; r < ROWS; ++r) {
+        WildlifeClassifier::Probabilities expected, actual;
+        original.predict_probabilities(feature_row(rows, r), expected);
+        reloaded.predict_probabilities(feature_row(rows, r), actual);
+        EXPECT_EQ(actual, expected) << "row " << r;
+
+        WildlifeClassifierF32::Probabilities narrow;
+        narrowed.predict_probabilities(
+            WildlifeClassifierF32::FeatureVector(narrow_rows.data() + r * WildlifeClassifier::INPUT_DIM,
+                                                 WildlifeClassifier::INPUT_DIM), narrow);
+        for (size_t o = 0; o < WildlifeClassifier::OUTPUT_DIM; ++o) {
+            EXPECT_NEAR(narrow[o], expected[o], 1e-4) << "row " << r << ", unit " << o;
+        }
+    }
+
+    fixtures::TempFile wrong_shape("wrong_shape.model");
+    std::vector<uint8_t> species(4, 1);
+    std::vector<double> hidden(8 * 16), output(16 * 4);
+    write_model_file(wrong_shape.path(), 8, 16, 4, species.data(), hidden.data(), output.data());
+    EXPECT_THROW(WildlifeClassifier classifier(wrong_shape.path()), std::runtime_error);
+}
+
+// The float32 pipeline end to end (features, then weights) against float64 on the
+// same recorder samples
+TEST(Float32Pipeline, TracksTheFloat64Pipeline) {
+    constexpr size_t ROWS = 2 * WildlifeClassifier::BATCH_BLOCK;
+    constexpr size_t IN = WildlifeClassifier::INPUT_DIM;
+    constexpr size_t OUT = WildlifeClassifier::OUTPUT_DIM;
+    auto burst = call_bursts(AudioProcessor::FFT_SIZE + ROWS * AudioProcessor::HOP_SIZE, 1)[0];
+    std::vector<int16_t> pcm(burst.begin(), burst.end());
+
+    AudioProcessor wide;
+    AudioProcessorF32 narrow;
+    std::vector<double> wide_rows(ROWS * IN);
+    std::vector<float> narrow_rows(ROWS * IN);
+    for (size_t r = 0; r < ROWS; ++r) {
+        auto frame = std::span<const int16_t>(pcm).subspan(r * AudioProcessor::HOP_SIZE, AudioProcessor::FFT_SIZE);
+        wide.extract_features(frame, wide_rows.data() + r * IN);
+        narrow.extract_features(frame, narrow_rows.data() + r * IN);
+        for (size_t i = 0; i < IN; ++i) {
+            double expected = wide_rows[r * IN + i];
+            EXPECT_NEAR(narrow_rows[r * IN + i], expected, 1e-4 * std::max(1.0, std::abs(expected)))
+                << "row " << r << ", feature " << i;
+        }
+    }
+
+    fixtures::TempFile model("f32.model");
+    write_test_model(model.path());
+    WildlifeClassifier wide_classifier(model.path());
+    WildlifeClassifierF32 narrow_classifier(model.path());
+    std::vector<int> wide_species(ROWS), narrow_species(ROWS);
+    std::vector<double> wide_probabilities(ROWS * OUT);
+    std::vector<float> narrow_probabilities(ROWS * OUT);
+    wide_classifier.classify_batch(wide_rows.data(), ROWS, {wide_species.data(), nullptr, wide_probabilities.data()});
+    narrow_classifier.classify_batch(narrow_rows.data(), ROWS,
+                                     {narrow_species.data(), nullptr, narrow_probabilities.data()});
+
+    size_t agree = 0;
+    for (size_t r = 0; r < ROWS; ++r) {
+        for (size_t o = 0; o < OUT; ++o) {
+            EXPECT_NEAR(narrow_probabilities[r * OUT + o], wide_probabilities[r * OUT + o], 1e-3)
+                << "row " << r << ", unit " << o;
+        }
+        agree += narrow_species[r] == wide_species[r];
+    }
+    EXPECT_GE(agree, ROWS - 2);  // Only rows on a near tie may go the other way
+}
+
+// -- Synthetic audio ---------------------------------------------------------
+
+namespace {
+
+// The first num_chunks chunks of a generator, concatenated
+std::vector<double> generate_chunks(const SyntheticLoadGenerator::Config& config, size_t num_chunks) {
+    SyntheticLoadGenerator generator(config);
+    size_t chunk_values = config.num_channels * config.chunk_size;
+    std::vector<double> audio(num_chunks * chunk_values);
+    for (size_t i = 0; i < num_chunks; ++i) {
+        generator.next_chunk(audio.data() + i * chunk_values);
+    }
+    return audio;
+}
+
+}  // namespace
+
+// Channels render in parallel on the pool, yet a seed fixes every sample; calls
+// stand well clear of the noise floor
+TEST(SyntheticLoadGenerator, SameSeedSameAudio) {
+    SyntheticLoadGenerator::Config config;
+    config.num_channels = 3;
+    config.calls_per_minute = 120.0;
+    config.seed = 2024;
+    auto audio = generate_chunks(config, 20);
+
+    size_t pool_threads = SharedThreadPool::size();
+    SharedThreadPool::resize(3);
+    EXPECT_EQ(generate_chunks(config, 20), audio);
+    SharedThreadPool::resize(pool_threads);
+
+    config.seed = 2025;
+    EXPECT_NE(generate_chunks(config, 20), audio);
+
+    double peak = 0.0;
+    for (double x : audio) {
+        peak = std::max(peak, std::abs(x));
+    }
+    EXPECT_GT(peak, 10 * AudioSimulator::NOISE_AMPLITUDE);
+}
+
+TEST(SyntheticLoadGenerator, ChannelsAreIndependentStreams) {
+    SyntheticLoadGenerator::Config config;
+    config.num_channels = 2;
+    config.seed = 5;
+    auto audio = generate_chunks(config, 1);
+    auto first = std::vector<double>(audio.begin(), audio.begin() + config.chunk_size);
+    auto second = std::vector<double>(audio.begin() + config.chunk_size, audio.end());
+    EXPECT_NE(first, second);
+}
+
+// -- Submissions -------------------------------------------------------------
+
+namespace {
+
+// Callback results by submission index; written from the submission thread
+struct Completions {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<EcosystemMonitor::StreamResult> results;
+
+    EcosystemMonitor::SubmitCallback callback(int index) {
+        return [this, index](EcosystemMonitor::StreamResult& result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(index);
+            results.push_back(result);
+        };
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size();
+    }
+};
+
+}  // namespace
+
+TEST(Submit, WaitSubmissionsReturnsOnceEveryCallbackRan) {
+    auto audio = test_audio(AudioProcessor::FFT_SIZE * 4);
+    EcosystemMonitor monitor;
+    Completions done;
+    constexpr int COUNT = 200;
+    for (int i = 0; i < COUNT; ++i) {
+        auto chunk = std::span<const double>(audio).subspan((i % 4) * AudioProcessor::FFT_SIZE, AudioProcessor::FFT_SIZE);
+        ASSERT_TRUE(monitor.submit(chunk, static_cast<uint32_t>(i % 3), done.callback(i)));
+    }
+    monitor.wait_submissions();
+    EXPECT_EQ(monitor.pending_submissions(), 0u);
+    ASSERT_EQ(done.count(), static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; ++i) {
+        EXPECT_EQ(done.order[i], i);  // Submission order
+        EXPECT_TRUE(done.results[i].error.empty()) << done.results[i].error;
+        EXPECT_FALSE(done.results[i].skipped);
+    }
+}
+
+TEST(Submit, ShortChunksReportAnError) {
+    std::vector<double> short_chunk(AudioProcessor::FFT_SIZE / 2);
+    EcosystemMonitor monitor;
+    Completions done;
+    ASSERT_TRUE(monitor.submit(std::span<const double>(short_chunk), 0, done.callback(0)));
+    monitor.wait_submissions();
+    ASSERT_EQ(done.count(), 1u);
+    EXPECT_FALSE(done.results[0].error.empty());
+    EXPECT_EQ(done.results[0].species, AustralianSpecies::Unknown);
+}
+
+TEST(Submit, ConfigureSubmissionsFinishesQueuedChunks) {
+    auto pcm = to_int16(test_audio(AudioProcessor::FFT_SIZE));
+    EcosystemMonitor monitor;
+    monitor.configure_submissions({2, 1000, std::chrono::microseconds(10000)});
+    Completions done;
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(monitor.submit(std::span<const int16_t>(pcm), 0, done.callback(i)));
+    }
+    monitor.configure_submissions({64, 1000, std::chrono::microseconds(0)});
+    EXPECT_EQ(done.count(), 50u);  // Under the old limits, before it returned
+    EXPECT_EQ(monitor.submit_config().max_batch, 64u);
+
+    ASSERT_TRUE(monitor.submit(std::span<const int16_t>(pcm), 0, done.callback(50)));  // Restarts the thread
+    monitor.wait_submissions();
+    EXPECT_EQ(done.count(), 51u);
+
+    EXPECT_THROW(monitor.configure_submissions({0, 1000, std::chrono::microseconds(0)}), std::invalid_argument);
+}
+
+// Callbacks that submit again (as Future callbacks may) must not deadlock a
+// configure_submissions waiting for them; refused chunks are simply not called back
+TEST(Submit, CallbacksMaySubmitWhileTheQueueIsReconfigured) {
+    auto audio = test_audio(AudioProcessor::FFT_SIZE);
+    EcosystemMonitor monitor;
+    std::atomic<int> accepted{0};
+    std::atomic<int> called{0};
+    std::function<void(EcosystemMonitor::StreamResult&)> resubmit = [&](EcosystemMonitor::StreamResult&) {
+        if (called.fetch_add(1) < 500 && monitor.submit(std::span<const double>(audio), 0, resubmit)) {
+            accepted++;
+        }
+    };
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(monitor.submit(std::span<const double>(audio), 0, resubmit));
+        accepted++;
+    }
+    for (size_t max_batch : {1, 3, 8}) {
+        monitor.configure_submissions({max_batch, 1000, std::chrono::microseconds(0)});
+        EXPECT_EQ(monitor.submit_config().max_batch, max_batch);
+    }
+    monitor.wait_submissions();
+    EXPECT_EQ(called.load(), accepted.load());
+}
+
+TEST(Submit, DestroyingTheMonitorFinishesQueuedChunks) {
+    auto audio = test_audio(AudioProcessor::FFT_SIZE);
+    Completions done;
+    {
+        EcosystemMonitor monitor;
+        monitor.configure_submissions({16, 1000, std::chrono::microseconds(50000)});
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(monitor.submit(std::span<const double>(audio), static_cast<uint32_t>(i % 2), done.callback(i)));
+        }
+    }
+    EXPECT_EQ(done.count(), 100u);
+}
+
+// Closing a channel flushes its open event into the metrics and frees its stream
+TEST(Submit, CloseStreamFlushesAndForgetsTheChannel) {
+    constexpr size_t NUM_SAMPLES = AudioProcessor::SAMPLE_RATE;
+    fixtures::TempFile model("close.model");
+    write_test_model(model.path());
+    auto pcm = call_bursts(NUM_SAMPLES, 1)[0];
+    std::vector<int16_t> chunk(pcm.begin(), pcm.end());
+
+    EcosystemMonitor expected(model.path());
+    expected.ingest_audio(std::span<const int16_t>(chunk), 7);
+    ASSERT_GT(expected.flush_events(), 0u);  // The chunk ends mid-event
+
+    EcosystemMonitor monitor(model.path());
+    EXPECT_FALSE(monitor.close_stream(7));
+    Completions done;
+    ASSERT_TRUE(monitor.submit(std::span<const int16_t>(chunk), 7, done.callback(0)));
+    monitor.wait_submissions();
+    EXPECT_TRUE(monitor.close_stream(7));
+    EXPECT_FALSE(monitor.close_stream(7));
+    EXPECT_EQ(monitor.flush_events(), 0u);  // Nothing left open
+    EXPECT_EQ(monitor.window_scores(0.0).species_counts, expected.window_scores(0.0).species_counts);
+}
+
+// Submission callbacks take the GIL on the batcher's thread, so tests run without it
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    py::scoped_interpreter interpreter;
+    py::gil_scoped_release release;
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+/*
+ * Bush Ears - Spectral moment kernel tests
+ * The kernel dispatched for this host against a plain loop in long double, on
+ * ranges that exercise every vector width and remainder
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/spectral_kernels.hpp"
+
+namespace {
+
+constexpr size_t BINS = 513;  // FFT_SIZE / 2 + 1 of the default processor
+constexpr double BIN_HZ = 44100.0 / 1024.0;
+
+struct Reference {
+    long double magnitude_sum = 0.0L;
+    long double weighted_freq_sum = 0.0L;
+    long double weighted_freq_sq_sum = 0.0L;
+};
+
+template <typename Real>
+Reference reference_moments(const std::vector<Real>& magnitude, const std::vector<Real>& freq,
+                            size_t first, size_t last) {
+    Reference ref;
+    for (size_t i = first; i < last; ++i) {
+        long double m = magnitude[i];
+        long double f = freq[i];
+        ref.magnitude_sum += m;
+        ref.weighted_freq_sum += f * m;
+        ref.weighted_freq_sq_sum += f * f * m;
+    }
+    return ref;
+}
+
+// A spectrum-like magnitude in [0, 1) and the bin centre frequencies
+template <typename Real>
+void random_spectrum(std::vector<Real>& magnitude, std::vector<Real>& freq, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    magnitude.resize(BINS);
+    freq.resize(BINS);
+    for (size_t i = 0; i < BINS; ++i) {
+        magnitude[i] = static_cast<Real>(uniform(rng));
+        freq[i] = static_cast<Real>(i * BIN_HZ);
+    }
+}
+
+// Every range length from empty to a few vectors wide, at unaligned starts
+template <typename Real>
+void expect_kernel_matches(double tolerance) {
+    std::vector<Real> magnitude, freq;
+    random_spectrum(magnitude, freq, 5);
+    for (size_t first : {0, 1, 3, 7, 100}) {
+        for (size_t length = 0; length <= 40 && first + length <= BINS; ++length) {
+            SpectralMoments acc;
+            accumulate_spectral_moments(magnitude.data(), freq.data(), first, first + length, acc);
+            Reference ref = reference_moments(magnitude, freq, first, first + length);
+            SCOPED_TRACE("first " + std::to_string(first) + " length " + std::to_string(length));
+            EXPECT_NEAR(acc.magnitude_sum, static_cast<double>(ref.magnitude_sum), tolerance * length);
+            EXPECT_NEAR(acc.weighted_freq_sum, static_cast<double>(ref.weighted_freq_sum),
+                        tolerance * length * 22050.0);
+            EXPECT_NEAR(acc.weighted_freq_sq_sum, static_cast<double>(ref.weighted_freq_sq_sum),
+                        tolerance * length * 22050.0 * 22050.0);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(SpectralKernels, BackendIsOneOfTheBuiltKernels) {
+    std::string backend = simd_backend();
+    EXPECT_TRUE(backend == "avx2" || backend == "neon" || backend == "scalar") << backend;
+}
+
+TEST(SpectralKernels, Float64MatchesTheReference) {
+    expect_kernel_matches<double>(1e-13);
+}
+
+TEST(SpectralKernels, Float32MatchesTheReference) {
+    expect_kernel_matches<float>(1e-6);
+}
+
+// Band energies are differences of the running magnitude sum, so a spectrum
+// accumulated band by band must equal one accumulated in a single range
+TEST(SpectralKernels, RangesAccumulate) {
+    std::vector<double> magnitude, freq;
+    random_spectrum(magnitude, freq, 9);
+    SpectralMoments whole;
+    accumulate_spectral_moments(magnitude.data(), freq.data(), 0, BINS, whole);
+
+    SpectralMoments banded;
+    for (auto [first, last] : {std::pair<size_t, size_t>{0, 23}, {23, 92}, {92, 185}, {185, BINS}}) {
+        accumulate_spectral_moments(magnitude.data(), freq.data(), first, last, banded);
+    }
+    EXPECT_NEAR(banded.magnitude_sum, whole.magnitude_sum, 1e-10);
+    EXPECT_NEAR(banded.weighted_freq_sum, whole.weighted_freq_sum, 1e-10 * 22050.0);
+    EXPECT_NEAR(banded.weighted_freq_sq_sum, whole.weighted_freq_sq_sum, 1e-10 * 22050.0 * 22050.0);
+}
+
+TEST(SpectralKernels, DispatchedKernelAgreesWithScalar) {
+    std::vector<double> magnitude, freq;
+    random_spectrum(magnitude, freq, 13);
+    SpectralMoments dispatched, scalar;
+    accumulate_spectral_moments(magnitude.data(), freq.data(), 0, BINS, dispatched);
+    accumulate_spectral_moments_scalar(magnitude.data(), freq.data(), 0, BINS, scalar);
+    EXPECT_NEAR(dispatched.magnitude_sum, scalar.magnitude_sum, 1e-10);
+    EXPECT_NEAR(dispatched.weighted_freq_sum, scalar.weighted_freq_sum, 1e-10 * 22050.0);
+    EXPECT_NEAR(dispatched.weighted_freq_sq_sum, scalar.weighted_freq_sq_sum, 1e-10 * 22050.0 * 22050.0);
+}
@@ -0,0 +1,157 @@
+/*
+ * Bush Ears - SpectrogramLayout tests
+ * Cropping and pooling geometry, and the per-row conversion to each scale and dtype
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../src/spectrogram.hpp"
+
+namespace {
+
+constexpr double SAMPLE_RATE = 44100.0;
+constexpr size_t FFT_SIZE = 1024;
+constexpr size_t BINS = FFT_SIZE / 2 + 1;
+constexpr double BIN_HZ = SAMPLE_RATE / FFT_SIZE;
+constexpr double REFERENCE_POWER = 4.0;
+
+SpectrogramLayout layout(const SpectrogramConfig& config) {
+    return SpectrogramLayout(SAMPLE_RATE, FFT_SIZE, config, REFERENCE_POWER);
+}
+
+SpectrogramConfig scaled(SpectrogramScale scale) {
+    SpectrogramConfig config;
+    config.scale = scale;
+    return config;
+}
+
+// Pool the frames (each a full power spectrum) into one output row
+template <typename Out>
+std::vector<Out> pooled_row(const SpectrogramLayout& layout, const std::vector<std::vector<double>>& frames) {
+    std::vector<double> sums(layout.columns(), 0.0);
+    for (const auto& power : frames) {
+        layout.accumulate(power.data(), sums.data());
+    }
+    std::vector<Out> row(layout.columns());
+    layout.write_row(sums.data(), frames.size(), row.data());
+    return row;
+}
+
+}  // namespace
+
+TEST(SpectrogramLayout, DefaultsCoverEveryBinAndFrame) {
+    auto full = layout(SpectrogramConfig{});
+    EXPECT_EQ(full.first_bin(), 0u);
+    EXPECT_EQ(full.last_bin(), BINS);
+    EXPECT_EQ(full.columns(), BINS);
+    EXPECT_EQ(full.rows(0), 0u);
+    EXPECT_EQ(full.rows(37), 37u);
+    EXPECT_EQ(full.config().max_hz, SAMPLE_RATE / 2);  // 0 means Nyquist
+}
+
+TEST(SpectrogramLayout, CropsToBinCentresInTheRange) {
+    SpectrogramConfig config;
+    config.min_hz = 1000.0;
+    config.max_hz = 8000.0;
+    auto cropped = layout(config);
+    EXPECT_EQ(cropped.first_bin(), static_cast<size_t>(std::ceil(1000.0 / BIN_HZ)));
+    EXPECT_EQ(cropped.last_bin(), static_cast<size_t>(std::floor(8000.0 / BIN_HZ)) + 1);
+    EXPECT_GE(cropped.first_bin() * BIN_HZ, 1000.0);
+    EXPECT_LE((cropped.last_bin() - 1) * BIN_HZ, 8000.0);
+    EXPECT_EQ(cropped.columns(), cropped.last_bin() - cropped.first_bin());
+}
+
+TEST(SpectrogramLayout, DecimationRoundsPartialBlocksUp) {
+    SpectrogramConfig config;
+    config.time_decimation = 4;
+    config.freq_decimation = 8;
+    auto pooled = layout(config);
+    EXPECT_EQ(pooled.rows(16), 4u);
+    EXPECT_EQ(pooled.rows(17), 5u);  // The last row pools a single frame
+    EXPECT_EQ(pooled.columns(), (BINS + 7) / 8);
+}
+
+TEST(SpectrogramLayout, RejectsInvalidConfigs) {
+    auto config = [](auto edit) {
+        SpectrogramConfig c;
+        edit(c);
+        return c;
+    };
+    EXPECT_THROW(layout(config([](auto& c) { c.min_hz = -1.0; })), std::invalid_argument);
+    EXPECT_THROW(layout(config([](auto& c) { c.max_hz = 30000.0; })), std::invalid_argument);
+    EXPECT_THROW(layout(config([](auto& c) { c.min_hz = 5000.0; c.max_hz = 4000.0; })), std::invalid_argument);
+    EXPECT_THROW(layout(config([](auto& c) { c.min_hz = 100.0; c.max_hz = 110.0; })), std::invalid_argument);  // No bin
+    EXPECT_THROW(layout(config([](auto& c) { c.time_decimation = 0; })), std::invalid_argument);
+    EXPECT_THROW(layout(config([](auto& c) { c.freq_decimation = 0; })), std::invalid_argument);
+    EXPECT_THROW(layout(config([](auto& c) { c.min_db = 0.0; c.max_db = 0.0; })), std::invalid_argument);
+}
+
+// Pooling averages power over the frames and bins of each cell, including the
+// narrower last column, before the scale is applied
+TEST(SpectrogramLayout, PoolsMeanPowerThenScales) {
+    std::vector<double> low(BINS), high(BINS);
+    for (size_t bin = 0; bin < BINS; ++bin) {
+        low[bin] = 1.0 + bin;
+        high[bin] = 3.0 * (1.0 + bin);
+    }
+    SpectrogramConfig config;
+    config.freq_decimation = 4;
+    config.scale = SpectrogramScale::Power;
+    auto power = pooled_row<double>(layout(config), {low, high});
+    ASSERT_EQ(power.size(), (BINS + 3) / 4);
+    EXPECT_DOUBLE_EQ(power[0], (2.0 * (1 + 2 + 3 + 4)) / 4.0);  // mean over 2 frames x 4 bins of 2 * (1 + bin)
+    EXPECT_DOUBLE_EQ(power.back(), 2.0 * BINS);                // Last column holds bin 512 alone
+
+    config.scale = SpectrogramScale::Magnitude;
+    auto magnitude = pooled_row<double>(layout(config), {low, high});
+    EXPECT_DOUBLE_EQ(magnitude[0], std::sqrt(power[0]));
+
+    config.scale = SpectrogramScale::Decibels;
+    auto db = pooled_row<double>(layout(config), {low, high});
+    EXPECT_DOUBLE_EQ(db[0], 10.0 * std::log10(power[0] / REFERENCE_POWER));
+}
+
+TEST(SpectrogramLayout, DecibelsAreRelativeToTheReferenceAndFloored) {
+    std::vector<double> power(BINS, 0.0);
+    power[10] = REFERENCE_POWER;
+    power[11] = REFERENCE_POWER / 100.0;
+    auto db = pooled_row<double>(layout(scaled(SpectrogramScale::Decibels)), {power});
+    EXPECT_DOUBLE_EQ(db[10], 0.0);
+    EXPECT_NEAR(db[11], -20.0, 1e-12);
+    EXPECT_DOUBLE_EQ(db[0], -200.0);  // Silence stops at the power floor instead of -inf
+}
+
+TEST(SpectrogramLayout, Float32RowsRoundTheFloat64Values) {
+    std::vector<double> power(BINS);
+    for (size_t bin = 0; bin < BINS; ++bin) {
+        power[bin] = 0.001 * bin * bin;
+    }
+    auto config = scaled(SpectrogramScale::Decibels);
+    auto wide = pooled_row<double>(layout(config), {power});
+    auto narrow = pooled_row<float>(layout(config), {power});
+    for (size_t column = 0; column < wide.size(); ++column) {
+        EXPECT_EQ(narrow[column], static_cast<float>(wide[column])) << "column " << column;
+    }
+}
+
+// uint8 maps [min_db, max_db] onto [0, 255] and clamps outside it
+TEST(SpectrogramLayout, Uint8QuantizesTheDecibelRange) {
+    SpectrogramConfig config = scaled(SpectrogramScale::Decibels);
+    config.min_db = -60.0;
+    config.max_db = -20.0;
+    std::vector<double> power(BINS, 0.0);
+    auto at_db = [](double db) { return REFERENCE_POWER * std::pow(10.0, db / 10.0); };
+    power[1] = at_db(-60.0);
+    power[2] = at_db(-40.0);
+    power[3] = at_db(-20.0);
+    power[4] = at_db(0.0);
+    auto row = pooled_row<uint8_t>(layout(config), {power});
+    EXPECT_EQ(row[0], 0);  // Silence
+    EXPECT_EQ(row[1], 0);
+    EXPECT_EQ(row[2], 128);  // Half way, rounded
+    EXPECT_EQ(row[3], 255);
+    EXPECT_EQ(row[4], 255);
+}
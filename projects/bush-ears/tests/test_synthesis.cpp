@@ -0,0 +1,127 @@
+/*
+ * Bush Ears - Synthesis engine tests
+ * Philox known answers, seeded noise, and chunked renders against a serial render
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../src/synthesis.hpp"
+
+namespace {
+
+// Render [0, samples) in chunks of chunk samples with the given renderer(first, count, out)
+template <typename Render>
+std::vector<double> render_in_chunks(size_t samples, size_t chunk, Render&& render) {
+    std::vector<double> out(samples, 0.0);
+    for (size_t first = 0; first < samples; first += chunk) {
+        render(first, std::min(chunk, samples - first), out.data() + first);
+    }
+    return out;
+}
+
+FmVoice test_voice() {
+    FmVoice voice;
+    voice.start = 300;
+    voice.length = 20000;
+    voice.carrier = 2500.0 / 44100.0;
+    voice.deviation = 400.0 / 44100.0;
+    voice.rate = 5.0 / 44100.0;
+    voice.attack = 4410.0;
+    voice.release = 13230.0;
+    voice.gain = 0.5;
+    return voice;
+}
+
+}  // namespace
+
+// Known-answer vectors published with Random123
+TEST(Philox4x32, MatchesTheReferenceVectors) {
+    using Counter = Philox4x32::Counter;
+    EXPECT_EQ(Philox4x32::generate({0, 0, 0, 0}, {0, 0}),
+              (Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox4x32::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+              (Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(Philox4x32::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(SinTwoPi, MatchesStdSin) {
+    for (int i = -20000; i <= 20000; ++i) {
+        double x = i * 0.000731;
+        ASSERT_NEAR(sin_2pi(x), std::sin(2.0 * M_PI * x), 1e-9) << x;
+    }
+}
+
+TEST(UniformNoise, SameSeedSameNoise) {
+    constexpr size_t SAMPLES = 10000;
+    auto noise = [](uint64_t seed) {
+        std::vector<double> out(SAMPLES, 0.0);
+        add_uniform_noise(seed, 0.01, 0, SAMPLES, out.data());
+        return out;
+    };
+    EXPECT_EQ(noise(7), noise(7));
+    EXPECT_NE(noise(7), noise(8));
+    EXPECT_NE(noise(7), noise(7ull << 32));  // Both key words come from the seed
+}
+
+TEST(UniformNoise, StaysInRangeAroundZero) {
+    constexpr size_t SAMPLES = 100000;
+    std::vector<double> out(SAMPLES, 0.0);
+    add_uniform_noise(123, 0.25, 0, SAMPLES, out.data());
+    double sum = 0.0, sum_sq = 0.0;
+    for (double x : out) {
+        ASSERT_GE(x, -0.25);
+        ASSERT_LT(x, 0.25);
+        sum += x;
+        sum_sq += x * x;
+    }
+    EXPECT_NEAR(sum / SAMPLES, 0.0, 0.005);
+    EXPECT_NEAR(sum_sq / SAMPLES, 0.25 * 0.25 / 3.0, 0.001);  // Variance of U(-a, a)
+}
+
+// Sample i is a function of (seed, i) alone, so any chunking, including chunks that
+// split Philox blocks, reproduces the serial render bit for bit
+TEST(UniformNoise, ChunkedRendersMatchSerial) {
+    constexpr size_t SAMPLES = 5003;
+    auto serial = render_in_chunks(SAMPLES, SAMPLES, [](size_t first, size_t count, double* out) {
+        add_uniform_noise(99, 0.01, first, count, out);
+    });
+    for (size_t chunk : {1, 3, 4, 7, 1000}) {
+        auto chunked = render_in_chunks(SAMPLES, chunk, [](size_t first, size_t count, double* out) {
+            add_uniform_noise(99, 0.01, first, count, out);
+        });
+        EXPECT_EQ(chunked, serial) << "chunks of " << chunk;
+    }
+}
+
+TEST(FmVoice, ChunkedRendersMatchSerial) {
+    constexpr size_t SAMPLES = 24000;  // Past the voice's end
+    FmVoice voice = test_voice();
+    auto render = [&](size_t first, size_t count, double* out) { render_voice(voice, first, count, out); };
+    auto serial = render_in_chunks(SAMPLES, SAMPLES, render);
+    for (size_t chunk : {17, 4096, 5000}) {
+        auto chunked = render_in_chunks(SAMPLES, chunk, render);
+        for (size_t i = 0; i < SAMPLES; ++i) {
+            ASSERT_NEAR(chunked[i], serial[i], 1e-12) << "sample " << i << ", chunks of " << chunk;
+        }
+    }
+}
+
+TEST(FmVoice, EnvelopeBoundsTheCall) {
+    constexpr size_t SAMPLES = 24000;
+    FmVoice voice = test_voice();
+    std::vector<double> out(SAMPLES, 0.0);
+    render_voice(voice, 0, SAMPLES, out.data());
+    double peak = 0.0;
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        if (i < voice.start || i >= voice.start + voice.length) {
+            ASSERT_EQ(out[i], 0.0) << "sample " << i;
+        }
+        peak = std::max(peak, std::abs(out[i]));
+    }
+    EXPECT_LE(peak, voice.gain + 1e-9);
+    EXPECT_GT(peak, 0.9 * voice.gain);
+}